@@ -91,6 +91,7 @@ if (RPP_DEVELOPER_MODE)
   option(RPP_BUILD_EXAMPLES   "Build examples tree." OFF)
   option(RPP_ENABLE_COVERAGE  "Enable coverage support separate from CTest's" OFF)
   option(RPP_BUILD_RXCPP      "Build RxCpp to compare results with it." OFF)
+  option(RPP_BENCHMARKS_COUNT_ALLOCATIONS "Replace global operator new in benchmarks to report allocations per iteration (slows down every allocation)." OFF)
 
   if (DEFINED CONAN_ARGS)
     if (RPP_BUILD_TESTS)
@@ -3,13 +3,22 @@
 
 #include <rpp/rpp.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <map>
 #include <span>
+#include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
+#include <vector>
 #ifdef RPP_BUILD_RXCPP
     #include <rxcpp/rx.hpp>
 #endif
@@ -56,6 +65,80 @@ std::optional<std::string_view> find_argument(std::string_view target_argument,
     return std::nullopt;
 }
 
+namespace
+{
+#ifdef RPP_BENCHMARKS_COUNT_ALLOCATIONS
+    std::atomic_size_t s_allocations_count{};
+#endif
+
+    struct never_disposed_handler
+    {
+        static bool is_disposed() noexcept { return false; }
+        static void on_error(const std::exception_ptr&) {}
+    };
+
+#ifdef RPP_BENCHMARKS_COUNT_ALLOCATIONS
+    template<typename Fn>
+    double get_allocations_per_call(Fn&& fn, size_t calls = 1000)
+    {
+        const auto before = s_allocations_count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < calls; ++i)
+            fn();
+        return static_cast<double>(s_allocations_count.load(std::memory_order_relaxed) - before) / static_cast<double>(calls);
+    }
+#endif
+
+    // prints percentiles and log2-based histogram of latencies
+    void print_latency_histogram(std::string_view name, std::vector<std::chrono::nanoseconds> latencies)
+    {
+        if (latencies.empty())
+            return;
+
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&](double p) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))]).count();
+        };
+
+        std::cerr << name << " latency (ns): p50=" << percentile(0.5) << " p90=" << percentile(0.9) << " p99=" << percentile(0.99) << " p99.9=" << percentile(0.999) << " max=" << latencies.back().count() << std::endl;
+
+        std::map<uint64_t, size_t> buckets{};
+        for (const auto& latency : latencies)
+            ++buckets[std::bit_floor(static_cast<uint64_t>(std::max<int64_t>(0, latency.count() / 1000)))];
+
+        for (const auto& [bucket, count] : buckets)
+            std::cerr << "    [" << bucket << "us; " << std::max(uint64_t{1}, bucket * 2) << "us): " << count << std::endl;
+    }
+} // namespace
+
+#ifdef RPP_BENCHMARKS_COUNT_ALLOCATIONS
+// counting is opt-in: replaced operator new adds atomic increment to each allocation of each benchmark
+// GCC can't match replaced operator new with free after inlining
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+    #endif
+void* operator new(std::size_t size)
+{
+    s_allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#endif
+
 namespace rpp
 {
     template<typename... Ts>
@@ -162,6 +245,15 @@ int main(int argc, char* argv[]) // NOLINT(bugprone-exception-escape)
             });
         }
 
+        SECTION("from array of 1 - create + as_blocking + subscribe + elastic")
+        {
+            std::array<int, 1> vals{123};
+            const auto         scheduler = rpp::schedulers::elastic{};
+            TEST_RPP([&]() {
+                (rpp::source::from_iterable(vals, scheduler) | rpp::ops::as_blocking()).subscribe([](int v) { ankerl::nanobench::doNotOptimizeAway(v); });
+            });
+        }
+
         SECTION("from array of 1000 - create + as_blocking + subscribe + new_thread")
         {
             std::array<int, 1000> vals{};
@@ -280,6 +372,193 @@ int main(int argc, char* argv[]) // NOLINT(bugprone-exception-escape)
                     });
                 });
         }
+
+        SECTION("current_thread scheduler create worker + schedule + 100 reschedules")
+        {
+            const auto fn = [&]() {
+                size_t count{};
+                rpp::schedulers::current_thread::create_worker().schedule([&count](const auto& v) {
+                    ankerl::nanobench::doNotOptimizeAway(v);
+                    if (++count < 100)
+                        return rpp::schedulers::optional_delay_from_now{rpp::schedulers::delay_from_now{}};
+                    return rpp::schedulers::optional_delay_from_now{}; }, rpp::make_lambda_observer([](int) {}));
+            };
+            TEST_RPP(fn);
+#ifdef RPP_BENCHMARKS_COUNT_ALLOCATIONS
+            if (!disable_rpp)
+                std::cerr << "current_thread scheduler create worker + schedule + 100 reschedules: " << get_allocations_per_call(fn) << " allocations per iteration" << std::endl;
+#endif
+        }
+
+        SECTION("current_thread scheduler create worker + schedule + 10 recursive schedules")
+        {
+            const auto fn = [&]() {
+                const auto worker = rpp::schedulers::current_thread::create_worker();
+                worker.schedule(
+                    [&worker](const auto& v) {
+                        for (int i = 0; i < 10; ++i)
+                        {
+                            worker.schedule(
+                                [](const auto& v) {
+                                    ankerl::nanobench::doNotOptimizeAway(v);
+                                    return rpp::schedulers::optional_delay_from_now{};
+                                },
+                                v);
+                        }
+                        return rpp::schedulers::optional_delay_from_now{};
+                    },
+                    never_disposed_handler{});
+            };
+            TEST_RPP(fn);
+#ifdef RPP_BENCHMARKS_COUNT_ALLOCATIONS
+            if (!disable_rpp)
+                std::cerr << "current_thread scheduler create worker + schedule + 10 recursive schedules: " << get_allocations_per_call(fn) << " allocations per iteration" << std::endl;
+#endif
+        }
+
+        SECTION("new_thread scheduler create worker + 4 producer threads schedule 1000 each")
+        {
+            TEST_RPP([&]() {
+                constexpr size_t producers_count = 4;
+                constexpr size_t per_producer    = 1000;
+
+                const auto         worker = rpp::schedulers::new_thread::create_worker();
+                std::atomic_size_t executed{};
+                std::promise<void> done{};
+
+                std::vector<std::thread> producers{};
+                for (size_t i = 0; i < producers_count; ++i)
+                {
+                    producers.emplace_back([&] {
+                        for (size_t j = 0; j < per_producer; ++j)
+                        {
+                            worker.schedule([&](const auto&) {
+                                if (executed.fetch_add(1) + 1 == producers_count * per_producer)
+                                    done.set_value();
+                                return rpp::schedulers::optional_delay_from_now{}; }, never_disposed_handler{});
+                        }
+                    });
+                }
+                for (auto& t : producers)
+                    t.join();
+                done.get_future().wait();
+            });
+        }
+
+        SECTION("run_loop schedule 100 + dispatch_if_ready one by one")
+        {
+            const auto scheduler = rpp::schedulers::run_loop{};
+            const auto worker    = scheduler.create_worker();
+            TEST_RPP([&]() {
+                for (size_t i = 0; i < 100; ++i)
+                    worker.schedule([](const auto&) { return rpp::schedulers::optional_delay_from_now{}; }, never_disposed_handler{});
+                while (scheduler.is_any_ready_schedulable())
+                    scheduler.dispatch_if_ready();
+            });
+        }
+
+        SECTION("run_loop schedule 100 + dispatch_all_ready")
+        {
+            const auto scheduler = rpp::schedulers::run_loop{};
+            const auto worker    = scheduler.create_worker();
+            TEST_RPP([&]() {
+                for (size_t i = 0; i < 100; ++i)
+                    worker.schedule([](const auto&) { return rpp::schedulers::optional_delay_from_now{}; }, never_disposed_handler{});
+                ankerl::nanobench::doNotOptimizeAway(scheduler.dispatch_all_ready());
+            });
+        }
+
+        const auto bench_idle_strategy = [&](rpp::schedulers::idle_strategy strategy, const char* strategy_name) {
+            const auto name = std::string{"new_thread with "} + strategy_name + " idle strategy schedule + wait for execution";
+            SECTION(name.c_str())
+            {
+                const auto                                    worker = rpp::schedulers::new_thread::with(strategy).create_worker();
+                std::atomic<rpp::schedulers::time_point::rep> executed_at{};
+
+                const auto schedule_and_wait = [&] {
+                    executed_at.store(0);
+                    const auto scheduled_at = rpp::schedulers::clock_type::now();
+                    worker.schedule([&](const auto&) {
+                        executed_at.store(rpp::schedulers::clock_type::now().time_since_epoch().count());
+                        return rpp::schedulers::optional_delay_from_now{}; }, never_disposed_handler{});
+
+                    rpp::schedulers::time_point::rep result{};
+                    while ((result = executed_at.load()) == 0)
+                        std::this_thread::yield();
+                    return rpp::schedulers::time_point{rpp::schedulers::time_point::duration{result}} - scheduled_at;
+                };
+
+                TEST_RPP([&]() {
+                    ankerl::nanobench::doNotOptimizeAway(schedule_and_wait());
+                });
+
+                if (!disable_rpp)
+                {
+                    std::vector<std::chrono::nanoseconds> latencies{};
+                    for (size_t i = 0; i < 10000; ++i)
+                        latencies.push_back(schedule_and_wait());
+                    print_latency_histogram(name, std::move(latencies));
+                }
+            }
+        };
+        bench_idle_strategy(rpp::schedulers::idle_strategy::blocking, "blocking");
+        bench_idle_strategy(rpp::schedulers::idle_strategy::spin_yield_park, "spin_yield_park");
+        bench_idle_strategy(rpp::schedulers::idle_strategy::busy_spin, "busy_spin");
+
+        const auto bench_queue = [&]<typename Storage>(const char* storage_name) {
+            for (const size_t pending : {size_t{10}, size_t{1000}, size_t{100000}})
+            {
+                const auto name = std::string{"schedulables_queue<"} + storage_name + "> with " + std::to_string(pending) + " pending delayed schedulables + emplace + pop";
+                SECTION(name.c_str())
+                {
+                    rpp::schedulers::details::schedulables_queue<rpp::schedulers::current_thread::worker_strategy, Storage> queue{};
+
+                    const auto now     = rpp::schedulers::clock_type::now();
+                    uint64_t   seed    = 42;
+                    const auto next_tp = [&] {
+                        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                        return now + std::chrono::microseconds{static_cast<int64_t>((seed >> 33) % 1000000)};
+                    };
+
+                    const auto obs = rpp::make_lambda_observer([](int) {}).as_dynamic();
+                    for (size_t i = 0; i < pending; ++i)
+                        queue.emplace(next_tp(), [](const auto&) { return rpp::schedulers::optional_delay_from_now{}; }, obs);
+
+                    TEST_RPP([&]() {
+                        auto top = queue.pop();
+                        ankerl::nanobench::doNotOptimizeAway(top);
+                        queue.emplace(std::max(top->get_timepoint(), next_tp()), std::move(top));
+                    });
+                }
+            }
+        };
+        bench_queue.operator()<rpp::schedulers::details::schedulables_heap_storage>("heap");
+        bench_queue.operator()<rpp::schedulers::details::schedulables_timer_wheel_storage>("timer_wheel");
+
+        const auto bench_clock = [&]<typename ClockSource>(const char* clock_name) {
+            const auto name = std::string{clock_name} + " clock source now()";
+            SECTION(name.c_str())
+            {
+                TEST_RPP([&]() {
+                    ankerl::nanobench::doNotOptimizeAway(ClockSource::now());
+                });
+            }
+        };
+        bench_clock.operator()<rpp::schedulers::details::steady_clock_source>("steady");
+        bench_clock.operator()<rpp::schedulers::details::coarse_clock_source>("coarse");
+        bench_clock.operator()<rpp::schedulers::details::tsc_clock_source>("tsc");
+
+        SECTION("details::now() inside scheduler's batch")
+        {
+            TEST_RPP([&]() {
+                const rpp::schedulers::details::now_cache::scope scope{};
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    rpp::schedulers::details::now_cache::tick();
+                    ankerl::nanobench::doNotOptimizeAway(rpp::schedulers::details::now());
+                }
+            });
+        }
     } // BENCHMARK("Schedulers")
 
     BENCHMARK("Combining Operators")
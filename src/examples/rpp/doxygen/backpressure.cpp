@@ -0,0 +1,59 @@
+#include <rpp/rpp.hpp>
+
+#include <iostream>
+#include <vector>
+
+/**
+ * @example backpressure.cpp
+ **/
+
+//! [backpressured_observer]
+struct batched_observer_strategy
+{
+    static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::Auto;
+    static constexpr bool backpressured              = true;
+
+    mutable rpp::disposable_wrapper upstream{};
+    mutable size_t                  received{};
+
+    void set_upstream(const rpp::disposable_wrapper& d) const
+    {
+        upstream = d;
+        d.request(2);
+    }
+
+    void on_next(int v) const
+    {
+        std::cout << v << " ";
+        if (++received % 2 == 0)
+        {
+            std::cout << "| ";
+            upstream.request(2);
+        }
+    }
+
+    void on_error(const std::exception_ptr&) const {}
+    void on_completed() const { std::cout << std::endl; }
+
+    static bool is_disposed() { return false; }
+};
+//! [backpressured_observer]
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [backpressure]
+    rpp::source::from_iterable(std::vector{1, 2, 3, 4, 5})
+        | rpp::operators::subscribe(batched_observer_strategy{});
+    // Output: 1 2 | 3 4 | 5
+    //! [backpressure]
+
+    //! [backpressure_observe_on]
+    std::vector<int> values(1000);
+    // from_iterable emits no more than 16 values ahead of slow observer instead of buffering all of them
+    rpp::source::from_iterable(values)
+        | rpp::operators::observe_on(rpp::schedulers::new_thread{}, {.capacity = 16, .overflow = rpp::operators::overflow_policy::error})
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int) {}, [](const std::exception_ptr&) { std::cout << "never happens" << std::endl; });
+    //! [backpressure_observe_on]
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include <rpp/rpp.hpp>
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * @example concat_map_eager.cpp
+ **/
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [concat_map_eager]
+    const auto start = rpp::schedulers::clock_type::now();
+    rpp::source::just(3, 1, 2)
+        | rpp::operators::concat_map_eager([](int v) {
+              // emulates request with latency depending on value
+              return rpp::source::just(v) | rpp::operators::delay(std::chrono::milliseconds{v * 100}, rpp::schedulers::new_thread{});
+          },
+                                           3,
+                                           0)
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << v << " "; });
+    std::cout << "in ~" << std::chrono::duration_cast<std::chrono::milliseconds>(rpp::schedulers::clock_type::now() - start).count() / 100 * 100 << "ms" << std::endl;
+    // Output: 3 1 2 in ~300ms
+    //! [concat_map_eager]
+    return 0;
+}
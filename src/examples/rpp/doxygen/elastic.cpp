@@ -0,0 +1,26 @@
+#include <rpp/rpp.hpp>
+
+#include <iostream>
+
+/**
+ * @example elastic.cpp
+ **/
+int main()
+{
+    //! [elastic]
+    const auto scheduler = rpp::schedulers::elastic{};
+    for (int i = 0; i < 3; ++i)
+    {
+        rpp::source::just(i)
+            | rpp::operators::subscribe_on(scheduler)
+            | rpp::operators::as_blocking()
+            | rpp::operators::subscribe([](int v) { std::cout << "[" << std::this_thread::get_id() << "] : " << v << std::endl; });
+    }
+
+    // Template for output: (the same thread is reused if it has returned back to cache before next subscription)
+    // [TH1]: 0
+    // [TH1]: 1
+    // [TH1]: 2
+    //! [elastic]
+    return 0;
+}
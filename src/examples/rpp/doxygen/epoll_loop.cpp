@@ -0,0 +1,71 @@
+#include <rpp/rpp.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+    #include <unistd.h>
+#endif
+
+/**
+ * @example epoll_loop.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+#if defined(__linux__)
+    {
+        //! [epoll_loop]
+        const auto  loop = rpp::schedulers::epoll_loop{};
+        std::thread thread{[&loop] { loop.run(); }};
+
+        rpp::source::interval(std::chrono::microseconds{500}, loop)
+            | rpp::operators::take(3)
+            | rpp::operators::as_blocking()
+            | rpp::operators::subscribe([](size_t v) { std::cout << "tick " << v << std::endl; });
+
+        loop.stop();
+        thread.join();
+        // Output:
+        // tick 0
+        // tick 1
+        // tick 2
+        //! [epoll_loop]
+    }
+    {
+        //! [from_fd]
+        int fds[2]{};
+        if (::pipe(fds) != 0)
+            return 1;
+
+        const auto  loop = rpp::schedulers::epoll_loop{};
+        std::thread thread{[&loop] { loop.run(); }};
+
+        // data is kept by pipe till reading, so, descriptor is ready right after subscription
+        [[maybe_unused]] const auto written = ::write(fds[1], "hello", 5);
+
+        rpp::source::from_fd(loop, fds[0], EPOLLIN)
+            | rpp::operators::map([](const rpp::schedulers::epoll_loop::fd_event& event) {
+                  char       buffer[64]{};
+                  const auto size = ::read(event.fd, buffer, sizeof(buffer));
+                  return std::string(buffer, static_cast<size_t>(std::max(ssize_t{}, size)));
+              })
+            | rpp::operators::take(1)
+            | rpp::operators::as_blocking()
+            | rpp::operators::subscribe([](const std::string& v) { std::cout << "received: " << v << std::endl; },
+                                        [] { std::cout << "completed" << std::endl; });
+
+        loop.stop();
+        thread.join();
+        ::close(fds[0]);
+        ::close(fds[1]);
+        // Output:
+        // received: hello
+        // completed
+        //! [from_fd]
+    }
+#endif
+    return 0;
+}
@@ -22,5 +22,16 @@ int main()
         | rpp::operators::subscribe([](int v) { std::cout << v << " "; });
     // Output: 1 2
     //! [merge_with]
+
+    //! [merge_max_concurrent]
+    rpp::source::just(rpp::source::never<int>().as_dynamic(),
+                      rpp::source::just(1).as_dynamic(),
+                      rpp::source::never<int>().as_dynamic(),
+                      rpp::source::just(2).as_dynamic())
+        | rpp::operators::merge(2)
+        | rpp::operators::subscribe([](int v) { std::cout << v << " "; });
+    // Output: 1
+    // just(2) is never subscribed: both slots are occupied by never-completing observables
+    //! [merge_max_concurrent]
     return 0;
 }
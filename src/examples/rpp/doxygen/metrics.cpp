@@ -0,0 +1,37 @@
+// metrics are opt-in: without this define schedulers don't collect anything
+#define RPP_SCHEDULERS_ENABLE_METRICS 1
+
+#include <rpp/rpp.hpp>
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * @example metrics.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [metrics]
+    const auto loop = rpp::schedulers::run_loop{};
+
+    rpp::source::just(1, 2, 3)
+        | rpp::operators::observe_on(loop)
+        | rpp::operators::subscribe([](int) {});
+
+    // execution of schedulable is recorded right after it returns: nothing is executed by loop after dispatching, so, snapshot below contains all executions
+    while (!loop.is_empty())
+        loop.dispatch();
+
+    // somewhere in metrics exporter, e.g. once per few seconds
+    for (const auto& worker : rpp::schedulers::metrics::collect())
+    {
+        std::cout << worker.scheduler << "#" << worker.id
+                  << " depth=" << worker.queue_depth
+                  << " executed=" << worker.executed
+                  << " lag_p99=" << std::chrono::duration_cast<std::chrono::microseconds>(worker.lag.percentile(0.99)).count() << "us"
+                  << " runtime_p99=" << std::chrono::duration_cast<std::chrono::microseconds>(worker.runtime.percentile(0.99)).count() << "us" << std::endl;
+    }
+    //! [metrics]
+    return 0;
+}
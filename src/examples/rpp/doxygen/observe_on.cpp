@@ -3,6 +3,8 @@
 #include <chrono>
 #include <ctime>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 /**
  * @example observe_on.cpp
@@ -45,5 +47,38 @@ int main() // NOLINT(bugprone-exception-escape)
     // emit error in thread{139800298538880} duration since start 3s
     // observe error in thread{139800298538880} duration since start 3s
     //! [observe_on]
+
+    //! [observe_on_without_delay]
+    rpp::source::just(1, 2, 3)
+        | rpp::operators::observe_on(rpp::schedulers::new_thread{}, {.max_batch_size = 64})
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << "observe " << v << " in thread{" << std::this_thread::get_id() << "}" << std::endl; });
+
+    // Template for output:
+    // observe 1 in thread{139800298534464}
+    // observe 2 in thread{139800298534464}
+    // observe 3 in thread{139800298534464}
+    //! [observe_on_without_delay]
+
+    //! [observe_on_bounded]
+    const auto counters = std::make_shared<rpp::operators::observe_on_counters>();
+    rpp::source::create<int>([](const auto& obs) {
+        for (int i = 0; i < 1000; ++i)
+            obs.on_next(i);
+        obs.on_completed();
+    })
+        | rpp::operators::observe_on(rpp::schedulers::new_thread{}, {.capacity = 10, .overflow = rpp::operators::overflow_policy::latest_only, .counters = counters})
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) {
+              // slow consumer
+              std::this_thread::sleep_for(std::chrono::milliseconds{1});
+              std::cout << "observe " << v << std::endl;
+          });
+    std::cout << "dropped " << counters->dropped << std::endl;
+
+    // Template for output (depends on timings, only the latest value waits for slow consumer):
+    // observe 999
+    // dropped 999
+    //! [observe_on_bounded]
     return 0;
 }
@@ -0,0 +1,31 @@
+#include <rpp/rpp.hpp>
+
+#include <iostream>
+#include <string>
+
+/**
+ * @example observe_on_partitioned.cpp
+ **/
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [observe_on_partitioned]
+    struct update
+    {
+        std::string symbol;
+        int         price;
+    };
+
+    const auto scheduler = rpp::schedulers::thread_pool{2};
+    rpp::source::just(update{"AAPL", 1}, update{"MSFT", 10}, update{"AAPL", 2}, update{"MSFT", 20}, update{"AAPL", 3})
+        | rpp::operators::observe_on_partitioned([](const update& u) { return u.symbol; }, scheduler, 2)
+        // invoked concurrently for different symbols, but in order for the same symbol
+        | rpp::operators::map([](const update& u) { return u.symbol + ":" + std::to_string(u.price); })
+        | rpp::operators::sequential()
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](const std::string& v) { std::cout << v << " "; });
+    std::cout << std::endl;
+    // Output: (symbols can be interleaved in any way, but prices of each symbol are in order)
+    // AAPL:1 MSFT:10 AAPL:2 AAPL:3 MSFT:20
+    //! [observe_on_partitioned]
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <rpp/rpp.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+/**
+ * @example parallel.cpp
+ **/
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [parallel]
+    const auto scheduler = rpp::schedulers::thread_pool{4};
+    rpp::source::just(1, 2, 3, 4, 5, 6, 7, 8)
+        | rpp::operators::parallel(4, scheduler)
+        | rpp::operators::map([](int v) {
+              // emulates CPU-heavy processing executed by 4 threads at the same time
+              std::this_thread::sleep_for(std::chrono::milliseconds{100});
+              return v * 10;
+          })
+        | rpp::operators::filter([](int v) { return v != 50; })
+        | rpp::operators::sequential()
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << v << " "; });
+    std::cout << std::endl;
+    // Output: (can be in any order)
+    // 10 20 30 40 60 70 80
+    //! [parallel]
+
+    //! [ordered_sequential]
+    rpp::source::just(1, 2, 3, 4, 5, 6, 7, 8)
+        | rpp::operators::parallel(4, scheduler)
+        | rpp::operators::map([](int v) {
+              // later values are processed faster
+              std::this_thread::sleep_for(std::chrono::milliseconds{100 - v * 10});
+              return v * 10;
+          })
+        | rpp::operators::filter([](int v) { return v != 50; })
+        | rpp::operators::ordered_sequential()
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << v << " "; });
+    std::cout << std::endl;
+    // Output: 10 20 30 40 60 70 80
+    //! [ordered_sequential]
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <rpp/rpp.hpp>
+
+#include <iostream>
+
+/**
+ * @example prioritized.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [prioritized]
+    const auto run_loop = rpp::schedulers::run_loop{};
+
+    rpp::source::just(1, 2, 3)
+        | rpp::operators::observe_on(run_loop, rpp::schedulers::priority::low)
+        | rpp::operators::subscribe([](int v) { std::cout << "bulk " << v << std::endl; });
+
+    rpp::source::just(1, 2)
+        | rpp::operators::observe_on(run_loop, rpp::schedulers::priority::high)
+        | rpp::operators::subscribe([](int v) { std::cout << "alert " << v << std::endl; });
+
+    // the same via scheduler adaptor
+    rpp::source::just(1)
+        | rpp::operators::subscribe_on(rpp::schedulers::prioritized{run_loop, rpp::schedulers::priority::normal})
+        | rpp::operators::subscribe([](int v) { std::cout << "regular " << v << std::endl; });
+
+    while (!run_loop.is_empty())
+        run_loop.dispatch();
+
+    // Output:
+    // alert 1
+    // alert 2
+    // regular 1
+    // bulk 1
+    // bulk 2
+    // bulk 3
+    //! [prioritized]
+    return 0;
+}
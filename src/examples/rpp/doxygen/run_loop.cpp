@@ -0,0 +1,51 @@
+#include <rpp/rpp.hpp>
+
+#include <iostream>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @example run_loop.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+#if defined(__linux__)
+    //! [wakeup_handle]
+    const auto run_loop = rpp::schedulers::run_loop{{.enable_wakeup_handle = true}};
+    const auto handle   = run_loop.get_wakeup_handle().value();
+
+    // some epoll based loop with its own descriptors
+    const int epoll_fd = epoll_create1(0);
+    for (const int fd : {handle.event_fd, handle.timer_fd})
+    {
+        epoll_event event{};
+        event.events  = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    rpp::source::interval(std::chrono::milliseconds{10}, run_loop)
+        | rpp::operators::take(3)
+        | rpp::operators::subscribe([](size_t v) { std::cout << v << std::endl; });
+
+    while (!run_loop.is_empty())
+    {
+        // sleeps till the next schedulable is due without any polling
+        std::array<epoll_event, 8> events{};
+        if (epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), -1) > 0)
+            run_loop.dispatch_all_ready();
+    }
+    close(epoll_fd);
+
+    // Output:
+    // 0
+    // 1
+    // 2
+    //! [wakeup_handle]
+#endif
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <rpp/rpp.hpp>
+
+#include <functional>
+#include <iostream>
+#include <latch>
+#include <string>
+
+/**
+ * @example shard_scheduler.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [shard_scheduler]
+    const auto scheduler = rpp::schedulers::shard_scheduler{{.shards_count = 2}};
+
+    // workers are distributed between shards in round-robin manner as for any other scheduler
+    rpp::source::just(1, 2, 3)
+        | rpp::operators::subscribe_on(scheduler)
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << "[" << std::this_thread::get_id() << "] " << v << std::endl; });
+
+    // all schedulables of the same key are executed by the same shard, so, per-key state is never touched by different cpus
+    const auto observer = rpp::make_lambda_observer([](int) {}).as_dynamic();
+    std::latch done{3};
+    for (const std::string key : {"AAPL", "MSFT", "AAPL"})
+    {
+        scheduler.create_worker_for_key(std::hash<std::string>{}(key)).schedule([key, &done](const auto&) {
+            std::cout << "[" << std::this_thread::get_id() << "] " << key << std::endl;
+            done.count_down();
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                                                                                observer);
+    }
+    done.wait();
+
+    // Output: (keys can be printed in any order, but both "AAPL" lines are always printed by the same thread)
+    // [thread_1] 1
+    // [thread_1] 2
+    // [thread_1] 3
+    // [thread_1] AAPL
+    // [thread_2] MSFT
+    // [thread_1] AAPL
+    //! [shard_scheduler]
+    return 0;
+}
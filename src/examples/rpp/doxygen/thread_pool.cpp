@@ -45,5 +45,39 @@ int main() // NOLINT(bugprone-exception-escape)
     // [thread_4] 8
     //! [computational]
 
+    //! [work_stealing]
+    const auto work_stealing_scheduler = rpp::schedulers::thread_pool{4, rpp::schedulers::thread_pool::mode::work_stealing};
+    rpp::source::just(1, 2, 3, 4, 5, 6, 7, 8)
+        | rpp::operators::flat_map([work_stealing_scheduler](int value) { return rpp::source::just(work_stealing_scheduler, value, value * 10); })
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << "[" << std::this_thread::get_id() << "] " << v << std::endl; });
+
+    // Output: (can be in any order and any thread, but `value * 10` is always emitted after `value`)
+    // [thread_1] 1
+    // [thread_2] 2
+    // [thread_1] 10
+    // [thread_3] 3
+    // [thread_2] 20
+    // ...
+    //! [work_stealing]
+
+    //! [work_stealing_computational]
+    rpp::source::just(1, 2, 3, 4, 5, 6, 7, 8)
+        | rpp::operators::flat_map([](int value) { return rpp::source::just(rpp::schedulers::work_stealing_computational{}, value); })
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << "[" << std::this_thread::get_id() << "] " << v << std::endl; });
+    //! [work_stealing_computational]
+
+    //! [thread_pool_options]
+    // 2 threads pinned to cpu 0 with lowered priority. Use `.cpu_affinity = {{0}, {1}}` to pin each thread to its own cpu
+    auto pinned_scheduler = rpp::schedulers::thread_pool{{.threads_count = 2, .cpu_affinity = {{0}}, .nice = 10}};
+    rpp::source::just(pinned_scheduler, 1, 2, 3)
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) { std::cout << "[" << std::this_thread::get_id() << "] " << v << std::endl; });
+
+    // amount of threads can be changed in runtime, already scheduled schedulables are not lost
+    pinned_scheduler.resize(1);
+    //! [thread_pool_options]
+
     return 0;
 }
@@ -0,0 +1,53 @@
+#include <rpp/rpp.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/**
+ * @example virtual_time.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [virtual_time]
+    using namespace std::chrono_literals;
+
+    struct trade
+    {
+        rpp::schedulers::duration offset;
+        double                    price;
+    };
+
+    // recorded data: offsets from start of trading session
+    const std::vector<trade> trades{{1min, 10.0}, {1min + 10s, 10.5}, {2h, 11.0}, {5h, 10.0}, {5h + 1s, 9.5}};
+
+    const auto scheduler = rpp::schedulers::virtual_time{};
+    const auto start     = scheduler.now();
+
+    rpp::source::create<double>([&](auto&& obs) {
+        // replay each trade at its original (virtual) time
+        const auto observer = std::forward<decltype(obs)>(obs).as_dynamic();
+        const auto worker   = scheduler.create_worker();
+        for (const auto& t : trades)
+        {
+            worker.schedule(start + t.offset, [price = t.price](const auto& o) {
+                o.on_next(price);
+                return rpp::schedulers::optional_delay_from_now{};
+            },
+                            observer);
+        }
+    })
+        | rpp::operators::debounce(30s, scheduler)
+        | rpp::operators::subscribe([&](double price) { std::cout << "[" << std::chrono::duration_cast<std::chrono::seconds>(scheduler.now() - start).count() << "s] " << price << std::endl; });
+
+    // the whole session is processed immediately without real waiting
+    scheduler.advance_by(8h);
+
+    // Output:
+    // [100s] 10.5
+    // [7230s] 11
+    // [18031s] 9.5
+    //! [virtual_time]
+    return 0;
+}
@@ -0,0 +1,40 @@
+// watchdog is opt-in: without this define schedulers don't publish heartbeats
+#define RPP_SCHEDULERS_ENABLE_WATCHDOG 1
+
+#include <rpp/rpp.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+/**
+ * @example watchdog.cpp
+ **/
+
+int main() // NOLINT(bugprone-exception-escape)
+{
+    //! [watchdog]
+    using namespace std::chrono_literals;
+
+    const auto watchdog = rpp::schedulers::watchdog{{.threshold    = 50ms,
+                                                     .check_period = 10ms,
+                                                     .on_stall     = [](const rpp::schedulers::watchdog::stall& stall) {
+                                                         std::cout << "stall in " << stall.scheduler << "#" << stall.worker_id
+                                                                   << " for " << std::chrono::duration_cast<std::chrono::milliseconds>(stall.elapsed).count() << "ms"
+                                                                   << ": " << stall.schedulable << std::endl;
+                                                     }}};
+
+    rpp::source::just(1, 2, 3)
+        | rpp::operators::observe_on(rpp::schedulers::new_thread{})
+        | rpp::operators::as_blocking()
+        | rpp::operators::subscribe([](int v) {
+              // blocking call on hot path
+              if (v == 2)
+                  std::this_thread::sleep_for(100ms);
+          });
+
+    // Output:
+    // stall in new_thread#0 for 50ms: rpp::operators::details::delay_observer_strategy<...>::emplace<const int&>(const int&) const::<lambda(...)>
+    //! [watchdog]
+    return 0;
+}
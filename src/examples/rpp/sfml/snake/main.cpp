@@ -77,8 +77,7 @@ int main()
     // this one will be blocking call and it will unblock when close requested
     while (!root_subscription.is_disposed())
     {
-        while (g_run_loop.is_any_ready_schedulable())
-            g_run_loop.dispatch();
+        g_run_loop.dispatch_all_ready();
     }
 
     return EXIT_SUCCESS;
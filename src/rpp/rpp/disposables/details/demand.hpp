@@ -0,0 +1,51 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/disposables/interface_disposable.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace rpp::details::disposables
+{
+    /**
+     * @brief Sum of demands saturated at `rpp::unbounded_demand`.
+     */
+    constexpr size_t add_demand(size_t current, size_t count) noexcept
+    {
+        return count >= unbounded_demand - current ? unbounded_demand : current + count;
+    }
+
+    /**
+     * @brief Add `count` to not satisfied demand.
+     * @return demand before adding, so, `0` means that emitting was paused and caller has to resume it.
+     */
+    inline size_t add_demand(std::atomic_size_t& demand, size_t count) noexcept
+    {
+        size_t current = demand.load(std::memory_order::relaxed);
+        while (!demand.compare_exchange_weak(current, add_demand(current, count), std::memory_order::acq_rel, std::memory_order::relaxed))
+        {
+        }
+        return current;
+    }
+
+    /**
+     * @brief Satisfy demand with one emission. Unbounded demand is never decreased.
+     * @return true if demand is still not satisfied, false if emitting has to be paused till next request.
+     */
+    inline bool consume_demand(std::atomic_size_t& demand) noexcept
+    {
+        if (demand.load(std::memory_order::relaxed) == unbounded_demand)
+            return true;
+        return demand.fetch_sub(1, std::memory_order::acq_rel) != 1;
+    }
+} // namespace rpp::details::disposables
@@ -72,6 +72,12 @@ namespace rpp::details
                 locked->dispose();
         }
 
+        void request(size_t count) const noexcept
+        {
+            if (const auto locked = get().first)
+                locked->request(count);
+        }
+
     protected:
         explicit disposable_wrapper_base(std::shared_ptr<interface_disposable>&& disposable)
             : m_disposable{std::move(disposable)}
@@ -113,7 +119,7 @@ namespace rpp
      * - disposable_wrapper's methods is safe to use over empty/gone/disposed/weak disposables.
      * - as soon as disposable can be actually "any internal state" it provides access to "raw" shared_ptr and it can be nullptr in case of disposable empty/ptr gone.
      * - disposable_wrapper can be strong or weak (same as std::shared_ptr). weak disposable is important, for example, when it keeps observer and this observer should keep this disposable at the same time.
-     * - disposable_wrapper has popluar methods to work with disposable: `dispose()`, `is_disposed()` and `add()`/`remove()`/`clear()` (for `interface_composite_disposable`).
+     * - disposable_wrapper has popluar methods to work with disposable: `dispose()`, `is_disposed()`, `request()` and `add()`/`remove()`/`clear()` (for `interface_composite_disposable`).
      *
      * To construct wrapper you have to use `make` method:
      * @code{cpp}
@@ -12,8 +12,18 @@
 
 #include <rpp/disposables/fwd.hpp>
 
+#include <cstddef>
+#include <limits>
+
 namespace rpp
 {
+    /**
+     * @brief Amount of emissions requested by observer which is not interested in backpressure at all.
+     *
+     * @ingroup disposables
+     */
+    inline constexpr size_t unbounded_demand = std::numeric_limits<size_t>::max();
+
     /**
      * @brief Interface of disposable
      *
@@ -35,6 +45,17 @@ namespace rpp
          */
         void dispose() noexcept { dispose_impl(Mode::Disposing); }
 
+        /**
+         * @brief Request `count` more emissions from observable which provided this disposable as upstream. Backpressured observers use it to signal demand.
+         * @details By default observable is not aware of backpressure and demand is just ignored: values are emitted as fast as observable can.
+         * @attention This function must be thread-safe and can be called from inside `on_next`
+         *
+         * @par Example:
+         * @snippet backpressure.cpp backpressured_observer
+         * @snippet backpressure.cpp backpressure
+         */
+        virtual void request(size_t count) noexcept { static_cast<void>(count); }
+
         template<rpp::constraint::decayed_type TStrategy>
         friend class rpp::details::auto_dispose_wrapper;
 
@@ -80,4 +80,5 @@
 #include <rpp/observables/dynamic_observable.hpp>
 #include <rpp/observables/grouped_observable.hpp>
 #include <rpp/observables/observable.hpp>
+#include <rpp/observables/parallel_observable.hpp>
 #include <rpp/observables/variant_observable.hpp>
@@ -42,6 +42,12 @@ namespace rpp
 
         using optimal_disposables_strategy = typename Strategy::optimal_disposables_strategy;
 
+        // observables aware of backpressure pass upstream disposable to backpressured observers only, so, place for it is reserved only for such observers
+        template<typename ObserverStrategy>
+        using optimal_disposables_strategy_for = std::conditional_t<rpp::details::observers::constraint::backpressured_strategy<ObserverStrategy>,
+                                                                    typename optimal_disposables_strategy::template add<1>,
+                                                                    optimal_disposables_strategy>;
+
         template<typename... Args>
             requires (!constraint::variadic_decayed_same_as<observable<Type, Strategy>, Args...> && constraint::is_constructible_from<Strategy, Args && ...>)
         observable(Args&&... args)
@@ -78,7 +84,7 @@ namespace rpp
         void subscribe(ObserverStrategy&& observer_strategy) const
         {
             if constexpr (std::decay_t<ObserverStrategy>::preferred_disposables_mode == rpp::details::observers::disposables_mode::Auto)
-                subscribe(rpp::observer<Type, rpp::details::observers::override_disposables_strategy<std::decay_t<ObserverStrategy>, typename optimal_disposables_strategy::observer_disposables_strategy>>{std::forward<ObserverStrategy>(observer_strategy)});
+                subscribe(rpp::observer<Type, rpp::details::observers::override_disposables_strategy<std::decay_t<ObserverStrategy>, typename optimal_disposables_strategy_for<std::decay_t<ObserverStrategy>>::observer_disposables_strategy>>{std::forward<ObserverStrategy>(observer_strategy)});
             else
                 subscribe(rpp::observer<Type, std::decay_t<ObserverStrategy>>{std::forward<ObserverStrategy>(observer_strategy)});
         }
@@ -144,7 +150,7 @@ namespace rpp
         [[nodiscard("Use returned disposable or use subscribe(observer) instead")]] composite_disposable_wrapper subscribe_with_disposable(observer<Type, ObserverStrategy>&& observer) const
         {
             if (!observer.is_disposed())
-                return subscribe(rpp::composite_disposable_wrapper::make<rpp::composite_disposable_impl<typename optimal_disposables_strategy::disposables_container>>(), std::move(observer));
+                return subscribe(rpp::composite_disposable_wrapper::make<rpp::composite_disposable_impl<typename optimal_disposables_strategy_for<ObserverStrategy>::disposables_container>>(), std::move(observer));
             return composite_disposable_wrapper::empty();
         }
 
@@ -159,7 +165,7 @@ namespace rpp
             requires (!constraint::observer<ObserverStrategy>)
         [[nodiscard("Use returned disposable or use subscribe(observer) instead")]] composite_disposable_wrapper subscribe_with_disposable(ObserverStrategy&& observer_strategy) const
         {
-            return subscribe(rpp::composite_disposable_wrapper::make<rpp::composite_disposable_impl<typename optimal_disposables_strategy::disposables_container>>(), std::forward<ObserverStrategy>(observer_strategy));
+            return subscribe(rpp::composite_disposable_wrapper::make<rpp::composite_disposable_impl<typename optimal_disposables_strategy_for<std::decay_t<ObserverStrategy>>::disposables_container>>(), std::forward<ObserverStrategy>(observer_strategy));
         }
 
         /**
@@ -0,0 +1,596 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/defs.hpp>
+#include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/observables/observable.hpp>
+#include <rpp/observers/dynamic_observer.hpp>
+#include <rpp/operators/details/spsc_queue.hpp>
+#include <rpp/utils/utils.hpp>
+
+#include <deque>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace rpp::operators::details
+{
+    struct as_blocking_t;
+
+    template<bool Ordered>
+    struct sequential_t;
+} // namespace rpp::operators::details
+
+namespace rpp::details
+{
+    template<rpp::constraint::decayed_type T>
+    struct parallel_rail_input
+    {
+        // observer of operators applied to rail, set on subscription
+        std::optional<rpp::dynamic_observer<T>> observer{};
+        // index of upstream value processed by rail right now. Accessed only by worker of rail
+        size_t current_index{};
+    };
+
+    template<rpp::constraint::decayed_type T, typename Worker>
+    struct parallel_rail final : public parallel_rail_input<T>
+    {
+        using item = std::variant<std::pair<size_t, T>, rpp::utils::none>;
+
+        explicit parallel_rail(Worker&& w)
+            : worker{std::move(w)}
+        {
+        }
+
+        RPP_NO_UNIQUE_ADDRESS Worker              worker;
+        rpp::operators::details::spsc_queue<item> queue{};
+    };
+
+    /**
+     * @brief Source of each rail: it is subscribed by operators applied to rail and fed by worker of rail.
+     */
+    template<rpp::constraint::decayed_type T>
+    struct parallel_rail_source_strategy
+    {
+        using value_type                   = T;
+        using optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<0>;
+
+        std::shared_ptr<parallel_rail_input<T>> rail;
+
+        template<rpp::constraint::observer_strategy<T> Strategy>
+        void subscribe(observer<T, Strategy>&& obs) const
+        {
+            rail->observer.emplace(std::move(obs).as_dynamic());
+        }
+    };
+
+    template<rpp::constraint::decayed_type T>
+    using parallel_rail_observable = rpp::observable<T, parallel_rail_source_strategy<T>>;
+
+    /**
+     * @brief Values are passed to rails in round-robin order.
+     */
+    struct parallel_round_robin
+    {
+        static constexpr bool round_robin = true;
+
+        template<typename T>
+        static size_t get_rail(size_t index, const T&, size_t rails)
+        {
+            return index % rails;
+        }
+    };
+
+    /**
+     * @brief Values with the same key are passed to the same rail, so, they are processed in order of original observable.
+     */
+    template<rpp::constraint::decayed_type KeySelector>
+    struct parallel_by_key
+    {
+        static constexpr bool round_robin = false;
+
+        RPP_NO_UNIQUE_ADDRESS KeySelector key_selector;
+
+        template<typename T>
+        size_t get_rail(size_t, const T& v, size_t rails) const
+        {
+            using key_t = std::decay_t<std::invoke_result_t<const KeySelector&, const T&>>;
+            return rpp::utils::get_bucket_for_hash(std::hash<key_t>{}(key_selector(v)), rails);
+        }
+    };
+
+    template<rpp::constraint::decayed_type R, bool Ordered>
+    struct parallel_join_state
+    {
+        // ordered: values of each rail tagged by index of upstream value, empty value marks that upstream value is processed by rail
+        // unordered: values of all rails in order of obtaining
+        std::conditional_t<Ordered, std::vector<std::deque<std::pair<size_t, std::optional<R>>>>, std::deque<R>> queue{};
+        // ordered and not round-robin: rails of upstream values starting from `next`
+        std::deque<size_t>                rails_order{};
+        // ordered: index of upstream value which values are emitted now
+        size_t                            next{};
+        size_t                            finished_rails{};
+        std::optional<std::exception_ptr> error{};
+        bool                              draining{};
+    };
+
+    template<rpp::constraint::decayed_type T, rpp::constraint::decayed_type R, rpp::constraint::observer Observer, typename Worker, rpp::constraint::decayed_type Distribution, bool Ordered>
+    class parallel_disposable final : public rpp::composite_disposable
+    {
+        using state_t = parallel_join_state<R, Ordered>;
+
+        struct cleanup_handler
+        {
+            static bool is_disposed() { return false; }
+            static void on_error(const std::exception_ptr&) {}
+        };
+
+    public:
+        using rail_t = parallel_rail<T, Worker>;
+
+        // index of values emitted by rail on completion: they are placed after values of all upstream values
+        static constexpr size_t s_tail_index = std::numeric_limits<size_t>::max();
+
+        parallel_disposable(Observer&& observer, std::vector<std::shared_ptr<rail_t>>&& rails, const Distribution& in_distribution)
+            : distribution{in_distribution}
+            , m_observer{std::move(observer)}
+            , m_rails{std::move(rails)}
+        {
+            if constexpr (Ordered)
+                rpp::utils::pointer_under_lock<state_t>{m_state}->queue.resize(m_rails.size());
+        }
+
+        // can be used only before subscription to upstream
+        Observer& get_observer() { return m_observer; }
+
+        const std::vector<std::shared_ptr<rail_t>>& get_rails() const { return m_rails; }
+
+        RPP_NO_UNIQUE_ADDRESS const Distribution distribution;
+        // upstream is serialized, so, it is accessed by one thread at any moment
+        size_t dispatched{};
+
+        // called before passing of value to rail, so, rail is known before any value of rail for it
+        void on_dispatched(size_t rail)
+        {
+            rpp::utils::pointer_under_lock<state_t>{m_state}->rails_order.push_back(rail);
+        }
+
+        template<typename TT>
+        void on_rail_next(size_t rail, TT&& v)
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                if constexpr (Ordered)
+                    state->queue[rail].emplace_back(m_rails[rail]->current_index, std::forward<TT>(v));
+                else
+                    state->queue.emplace_back(std::forward<TT>(v));
+
+                if (std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+        void on_rail_index_done(size_t rail, size_t index)
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                state->queue[rail].emplace_back(index, std::nullopt);
+                if (std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+        void on_rail_finished()
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                ++state->finished_rails;
+                if (std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+        void on_error(const std::exception_ptr& err)
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                if (!state->error)
+                    state->error.emplace(err);
+                if (std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+    private:
+        void composite_dispose_impl(interface_disposable::Mode mode) noexcept override
+        {
+            if (mode == interface_disposable::Mode::Destroying)
+                return;
+
+            // observer of rail keeps this disposable alive, so, it is released by worker of rail to not race with draining of rail
+            for (const auto& rail : m_rails)
+            {
+                rail->worker.schedule(
+                    [](const cleanup_handler&, const std::shared_ptr<rail_t>& r) {
+                        r->observer.reset();
+                        return rpp::schedulers::optional_delay_from_now{};
+                    },
+                    cleanup_handler{},
+                    rail);
+            }
+        }
+
+        /**
+         * @brief Emit values obtained from rails to observer. Can be called only by owner of draining.
+         */
+        void drain()
+        {
+            while (!is_disposed())
+            {
+                std::optional<R>                  value{};
+                std::optional<std::exception_ptr> error{};
+                {
+                    rpp::utils::pointer_under_lock<state_t> state{m_state};
+                    if (state->error)
+                        error = state->error;
+                    else if (!pop_value(*state, value) && state->finished_rails != m_rails.size())
+                    {
+                        state->draining = false;
+                        return;
+                    }
+                }
+
+                if (error)
+                {
+                    m_observer.on_error(error.value());
+                    return;
+                }
+
+                if (!value)
+                {
+                    m_observer.on_completed();
+                    return;
+                }
+
+                m_observer.on_next(std::move(value).value());
+            }
+        }
+
+        bool pop_value(state_t& state, std::optional<R>& value) const
+        {
+            if constexpr (Ordered)
+            {
+                while (true)
+                {
+                    size_t rail{};
+                    if constexpr (Distribution::round_robin)
+                        rail = state.next % state.queue.size();
+                    else if (state.rails_order.empty())
+                        break;
+                    else
+                        rail = state.rails_order.front();
+
+                    // rail processes its upstream values in order, so, its queue starts with values of `next` or empty
+                    auto& queue = state.queue[rail];
+                    if (queue.empty() || queue.front().first != state.next)
+                        break;
+
+                    auto item = std::move(queue.front());
+                    queue.pop_front();
+                    if (!item.second)
+                    {
+                        ++state.next;
+                        if constexpr (!Distribution::round_robin)
+                            state.rails_order.pop_front();
+                        continue;
+                    }
+                    value.emplace(std::move(item.second).value());
+                    return true;
+                }
+
+                // all upstream values are processed, only values emitted by rails on completion are left
+                if (state.finished_rails == m_rails.size())
+                {
+                    for (auto& queue : state.queue)
+                    {
+                        if (queue.empty())
+                            continue;
+
+                        value.emplace(std::move(queue.front().second).value());
+                        queue.pop_front();
+                        return true;
+                    }
+                }
+                return false;
+            }
+            else
+            {
+                if (state.queue.empty())
+                    return false;
+
+                value.emplace(std::move(state.queue.front()));
+                state.queue.pop_front();
+                return true;
+            }
+        }
+
+    private:
+        // accessed only by owner of draining
+        RPP_NO_UNIQUE_ADDRESS Observer             m_observer;
+        const std::vector<std::shared_ptr<rail_t>> m_rails;
+        rpp::utils::value_with_mutex<state_t>      m_state{};
+    };
+
+    template<typename Disposable>
+    struct parallel_rail_drain_handler
+    {
+        std::shared_ptr<Disposable> disposable;
+        size_t                      rail;
+
+        bool is_disposed() const { return disposable->is_disposed(); }
+
+        void on_error(const std::exception_ptr& err) const { disposable->on_error(err); }
+    };
+
+    /**
+     * @brief Observer of upstream: passes values to rails selected by distribution, each rail drains its queue via its own worker.
+     */
+    template<typename Disposable, bool Ordered>
+    struct parallel_dispatch_observer_strategy
+    {
+        static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+        static constexpr size_t s_max_batch_size         = 128;
+
+        std::shared_ptr<Disposable> disposable;
+
+        void set_upstream(const rpp::disposable_wrapper& d) const { disposable->add(d); }
+
+        bool is_disposed() const { return disposable->is_disposed(); }
+
+        template<typename TT>
+        void on_next(TT&& v) const
+        {
+            const auto&  rails = disposable->get_rails();
+            const size_t index = disposable->dispatched++;
+            const size_t rail  = disposable->distribution.get_rail(index, std::as_const(v), rails.size());
+            if constexpr (Ordered && !std::decay_t<decltype(disposable->distribution)>::round_robin)
+                disposable->on_dispatched(rail);
+
+            if (rails[rail]->queue.push(std::pair<size_t, std::decay_t<TT>>{index, std::forward<TT>(v)}))
+                schedule_drain(rail);
+        }
+
+        void on_error(const std::exception_ptr& err) const { disposable->on_error(err); }
+
+        void on_completed() const
+        {
+            const auto& rails = disposable->get_rails();
+            for (size_t rail = 0; rail < rails.size(); ++rail)
+            {
+                if (rails[rail]->queue.push(rpp::utils::none{}))
+                    schedule_drain(rail);
+            }
+        }
+
+    private:
+        void schedule_drain(size_t rail) const
+        {
+            disposable->get_rails()[rail]->worker.schedule(
+                [](const parallel_rail_drain_handler<Disposable>& handler) { return drain_rail(handler.disposable, handler.rail); },
+                parallel_rail_drain_handler<Disposable>{disposable, rail});
+        }
+
+        static rpp::schedulers::optional_delay_from_now drain_rail(const std::shared_ptr<Disposable>& disposable, size_t index)
+        {
+            auto& rail = *disposable->get_rails()[index];
+            // copy keeps observer alive even if it is released due to disposing during emission
+            const auto observer = rail.observer;
+            const bool has_more = rail.queue.drain([&](typename Disposable::rail_t::item&& item) {
+                if (auto* v = std::get_if<0>(&item))
+                {
+                    rail.current_index = v->first;
+                    if (observer)
+                        observer->on_next(std::move(v->second));
+                    if constexpr (Ordered)
+                        disposable->on_rail_index_done(index, v->first);
+                }
+                else
+                {
+                    rail.current_index = Disposable::s_tail_index;
+                    if (observer)
+                        observer->on_completed();
+                    rail.observer.reset();
+                    disposable->on_rail_finished();
+                }
+            },
+                                                   s_max_batch_size);
+
+            // yield worker to other schedulables before the next batch
+            if (has_more)
+                return rpp::schedulers::optional_delay_from_now{rpp::schedulers::delay_from_now{}};
+            return std::nullopt;
+        }
+    };
+
+    /**
+     * @brief Observer of operators applied to rail: passes their values to observer of `rpp::parallel_observable`.
+     */
+    template<typename Disposable>
+    struct parallel_rail_observer_strategy
+    {
+        static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+
+        std::shared_ptr<Disposable> disposable;
+        size_t                      rail;
+
+        template<typename TT>
+        void on_next(TT&& v) const
+        {
+            disposable->on_rail_next(rail, std::forward<TT>(v));
+        }
+
+        void on_error(const std::exception_ptr& err) const { disposable->on_error(err); }
+
+        // rail is finished only after processing of completion of upstream: operators of rail could complete earlier (e.g. `take`)
+        static void on_completed() {}
+
+        void set_upstream(const rpp::disposable_wrapper& d) const { disposable->add(d); }
+
+        bool is_disposed() const { return disposable->is_disposed(); }
+    };
+
+    template<rpp::constraint::decayed_type RailFn, rpp::constraint::decayed_type Op>
+    struct parallel_rail_chain
+    {
+        RPP_NO_UNIQUE_ADDRESS RailFn rail_fn;
+        RPP_NO_UNIQUE_ADDRESS Op     op;
+
+        template<rpp::constraint::observable TObservable>
+        auto operator()(TObservable&& rail) const
+        {
+            return rail_fn(std::forward<TObservable>(rail)) | op;
+        }
+    };
+
+    template<rpp::constraint::observable OriginalObservable, rpp::schedulers::constraint::scheduler Scheduler, rpp::constraint::decayed_type Distribution, rpp::constraint::decayed_type RailFn, bool Ordered>
+    struct parallel_strategy
+    {
+        using input_type      = rpp::utils::extract_observable_type_t<OriginalObservable>;
+        using rail_observable = std::decay_t<std::invoke_result_t<const RailFn&, parallel_rail_observable<input_type>>>;
+
+        static_assert(rpp::constraint::observable<rail_observable>, "Operators applied to rails should return observable");
+
+        using value_type                   = rpp::utils::extract_observable_type_t<rail_observable>;
+        using optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<1>;
+
+        RPP_NO_UNIQUE_ADDRESS OriginalObservable original;
+        size_t                                   rails;
+        RPP_NO_UNIQUE_ADDRESS Scheduler          scheduler;
+        RPP_NO_UNIQUE_ADDRESS Distribution       distribution;
+        RPP_NO_UNIQUE_ADDRESS RailFn             rail_fn;
+
+        template<rpp::constraint::observer_strategy<value_type> Strategy>
+        void subscribe(observer<value_type, Strategy>&& obs) const
+        {
+            using worker_t     = rpp::schedulers::utils::get_worker_t<Scheduler>;
+            using disposable_t = parallel_disposable<input_type, value_type, observer<value_type, Strategy>, worker_t, Distribution, Ordered>;
+
+            std::vector<std::shared_ptr<typename disposable_t::rail_t>> rails_list{};
+            rails_list.reserve(rails);
+            for (size_t i = 0; i < rails; ++i)
+                rails_list.push_back(std::make_shared<typename disposable_t::rail_t>(scheduler.create_worker()));
+
+            const auto d   = disposable_wrapper_impl<disposable_t>::make(std::move(obs), std::move(rails_list), distribution);
+            auto       ptr = d.lock();
+            ptr->get_observer().set_upstream(d.as_weak());
+
+            for (size_t i = 0; i < rails; ++i)
+            {
+                rail_fn(parallel_rail_observable<input_type>{parallel_rail_source_strategy<input_type>{ptr->get_rails()[i]}})
+                    .subscribe(rpp::observer<value_type, parallel_rail_observer_strategy<disposable_t>>{ptr, i});
+            }
+
+            original.subscribe(rpp::observer<input_type, parallel_dispatch_observer_strategy<disposable_t, Ordered>>{std::move(ptr)});
+        }
+    };
+
+    template<typename Op>
+    inline constexpr bool is_parallel_join_v = false;
+
+    template<bool Ordered>
+    inline constexpr bool is_parallel_join_v<rpp::operators::details::sequential_t<Ordered>> = true;
+
+    // operators applied to merged rails instead of each rail
+    template<typename Op>
+    inline constexpr bool is_applied_to_merged_rails_v = rpp::utils::is_base_of_v<Op, rpp::operators::details::subscribe_t> || std::same_as<Op, rpp::operators::details::as_blocking_t>;
+} // namespace rpp::details
+
+namespace rpp
+{
+    /**
+     * @brief Observable split into N "rails": values of original observable are passed to rails selected by `Distribution` (round-robin or by key) and each rail processes its values via its own worker of scheduler, so, CPU-heavy operators of one stream run on multiple threads.
+     * @details Operators applied to `rpp::parallel_observable` via `operator|` are applied to each rail independently (e.g. `map` is invoked concurrently by different rails). Use `rpp::operators::sequential()` or `rpp::operators::ordered_sequential()` to merge rails back to common observable. Subscription to `rpp::parallel_observable` directly (as well as `rpp::operators::as_blocking()`) is the same as subscription to `sequential()`.
+     *
+     * @ingroup observables
+     */
+    template<rpp::constraint::observable              OriginalObservable,
+             rpp::schedulers::constraint::scheduler Scheduler,
+             rpp::constraint::decayed_type          Distribution = details::parallel_round_robin,
+             rpp::constraint::decayed_type          RailFn       = std::identity>
+    class parallel_observable final : public observable<typename details::parallel_strategy<OriginalObservable, Scheduler, Distribution, RailFn, false>::value_type,
+                                                        details::parallel_strategy<OriginalObservable, Scheduler, Distribution, RailFn, false>>
+    {
+        template<bool Ordered>
+        using strategy = details::parallel_strategy<OriginalObservable, Scheduler, Distribution, RailFn, Ordered>;
+
+        using base = observable<typename strategy<false>::value_type, strategy<false>>;
+
+    public:
+        parallel_observable(const strategy<false>& s)
+            : base{s}
+            , m_strategy{s}
+        {
+        }
+
+        size_t rails_count() const { return m_strategy.rails; }
+
+        /**
+         * @brief Merge rails back to common observable, values are emitted as soon as rails produce them.
+         */
+        auto sequential() const
+        {
+            return rpp::observable<typename base::value_type, strategy<false>>{m_strategy};
+        }
+
+        /**
+         * @brief Merge rails back to common observable preserving order of original observable: values produced by rail for some value of original observable are emitted only after values produced for all previous values.
+         * @warning Order is tracked by value of original observable processed by rail while operator of rail emits, so, operators of rails have to emit synchronously during processing of value (`map`, `filter`, `flat_map` of synchronous observables and etc). Values emitted by rail on completion (e.g. `reduce`) are emitted after all other values.
+         */
+        auto ordered_sequential() const
+        {
+            return rpp::observable<typename base::value_type, strategy<true>>{strategy<true>{m_strategy.original, m_strategy.rails, m_strategy.scheduler, m_strategy.distribution, m_strategy.rail_fn}};
+        }
+
+        template<typename Op>
+        auto operator|(Op&& op) const
+        {
+            if constexpr (details::is_applied_to_merged_rails_v<std::decay_t<Op>>)
+                return std::forward<Op>(op)(static_cast<const base&>(*this));
+            else if constexpr (details::is_parallel_join_v<std::decay_t<Op>>)
+                return std::forward<Op>(op)(*this);
+            else
+            {
+                using rail_fn = details::parallel_rail_chain<RailFn, std::decay_t<Op>>;
+                return parallel_observable<OriginalObservable, Scheduler, Distribution, rail_fn>{
+                    details::parallel_strategy<OriginalObservable, Scheduler, Distribution, rail_fn, false>{m_strategy.original, m_strategy.rails, m_strategy.scheduler, m_strategy.distribution, rail_fn{m_strategy.rail_fn, std::forward<Op>(op)}}};
+            }
+        }
+
+        template<typename Op>
+        auto pipe(Op&& op) const
+        {
+            return *this | std::forward<Op>(op);
+        }
+
+    private:
+        // strategy of base is not accessible, so, copy is kept to build new observables
+        strategy<false> m_strategy;
+    };
+} // namespace rpp
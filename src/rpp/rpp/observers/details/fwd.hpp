@@ -40,6 +40,12 @@ namespace rpp::details::observers
             } -> std::same_as<bool>;
             const_v.dispose();
         };
+
+        /**
+         * @brief Strategy opts-in into backpressure via `static constexpr bool backpressured = true`. Observable aware of backpressure emits no more values than such an observer requested via `request` of upstream disposable.
+         */
+        template<typename T>
+        concept backpressured_strategy = requires { requires T::backpressured; };
     } // namespace constraint
 
     template<typename DisposableContainer>
@@ -49,6 +49,7 @@ namespace rpp::constraint
      * - set_upstream(disposable) for custom disposables related logic. In most cases you should OR do nothing OR just forward disposable to downstream observer (and set preferred_disposables_mode to None) OR fully handle disposales related logic properly
      * - is_disposed() for extending custom disposables related logic with indicating current status.
      * - `static constexpr rpp::details::observers::disposables_mode preferred_disposables_mode` with preferred disposables logic for observer over this strategy
+     * - (optional) `static constexpr bool backpressured = true` to opt-in into backpressure: observables aware of it emit no more values than requested via `request(count)` of disposable passed to `set_upstream`. Observables and operators not aware of backpressure just ignore demand.
      *
      * @ingroup observers
      */
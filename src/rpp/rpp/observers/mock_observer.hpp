@@ -77,3 +77,48 @@ private:
 
     std::shared_ptr<state> m_state{};
 };
+
+template<typename Type>
+class backpressured_mock_observer_strategy final
+{
+public:
+    static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::Auto;
+    static constexpr bool backpressured              = true;
+
+    explicit backpressured_mock_observer_strategy(size_t initial_request)
+        : m_state{std::make_shared<state>(initial_request)}
+    {
+    }
+
+    void on_next(const Type& v) const noexcept { m_mock.on_next(v); }
+    void on_next(Type&& v) const noexcept { m_mock.on_next(std::move(v)); }
+    void on_error(const std::exception_ptr& err) const noexcept { m_mock.on_error(err); }
+    void on_completed() const noexcept { m_mock.on_completed(); }
+
+    static bool is_disposed() noexcept { return false; }
+
+    void set_upstream(const rpp::disposable_wrapper& d) const noexcept
+    {
+        m_state->upstream = d;
+        d.request(m_state->initial_request);
+    }
+
+    void request(size_t count) const { m_state->upstream.request(count); }
+
+    const mock_observer_strategy<Type>& get_mock() const { return m_mock; }
+
+private:
+    struct state
+    {
+        explicit state(size_t initial_request)
+            : initial_request{initial_request}
+        {
+        }
+
+        size_t                  initial_request{};
+        rpp::disposable_wrapper upstream{};
+    };
+
+    mock_observer_strategy<Type> m_mock{};
+    std::shared_ptr<state>       m_state{};
+};
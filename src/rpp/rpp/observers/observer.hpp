@@ -38,6 +38,7 @@ namespace rpp::details
 
     public:
         static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+        static constexpr bool backpressured              = observers::constraint::backpressured_strategy<Strategy>;
 
         using on_next_lvalue = void (observer_impl::*)(const Type&) const noexcept;
         using on_next_rvalue = void (observer_impl::*)(Type&&) const noexcept;
@@ -109,6 +109,7 @@
  */
 
 #include <rpp/operators/buffer.hpp>
+#include <rpp/operators/concat_map_eager.hpp>
 #include <rpp/operators/flat_map.hpp>
 #include <rpp/operators/group_by.hpp>
 #include <rpp/operators/map.hpp>
@@ -173,6 +174,8 @@
 #include <rpp/operators/delay.hpp>
 #include <rpp/operators/finally.hpp>
 #include <rpp/operators/observe_on.hpp>
+#include <rpp/operators/observe_on_partitioned.hpp>
+#include <rpp/operators/parallel.hpp>
 #include <rpp/operators/repeat.hpp>
 #include <rpp/operators/repeat_when.hpp>
 #include <rpp/operators/subscribe_on.hpp>
@@ -13,6 +13,7 @@
 #include <rpp/operators/fwd.hpp>
 
 #include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/disposables/details/demand.hpp>
 #include <rpp/operators/details/strategy.hpp>
 #include <rpp/utils/utils.hpp>
 
@@ -34,16 +35,89 @@ namespace rpp::operators::details
         Processing             = 3,
     };
 
+    struct concat_demand
+    {
+        // demand of downstream not satisfied yet
+        size_t                  requested{};
+        rpp::disposable_wrapper inner{};
+        rpp::disposable_wrapper outer{};
+    };
+
     template<rpp::constraint::observable TObservable, rpp::constraint::observer TObserver>
     class concat_disposable final : public rpp::details::base_disposable
         , public rpp::details::enable_wrapper_from_this<concat_disposable<TObservable, TObserver>>
     {
     public:
+        static constexpr bool backpressured = TObserver::backpressured;
+
         concat_disposable(TObserver&& observer)
             : m_observer{std::move(observer)}
         {
         }
 
+        /**
+         * @brief Demand of backpressured observer is passed to current inner observable, not satisfied part of it is passed to the next one.
+         */
+        void request(size_t count) noexcept override
+        {
+            if constexpr (backpressured)
+            {
+                rpp::disposable_wrapper inner{};
+                {
+                    rpp::utils::pointer_under_lock<concat_demand> demand{m_demand};
+                    demand->requested = rpp::details::disposables::add_demand(demand->requested, count);
+                    inner             = demand->inner;
+                }
+                inner.request(count);
+            }
+        }
+
+        void on_inner_next()
+        {
+            if constexpr (backpressured)
+            {
+                rpp::utils::pointer_under_lock<concat_demand> demand{m_demand};
+                if (demand->requested != unbounded_demand)
+                    --demand->requested;
+            }
+        }
+
+        void set_inner_upstream(const disposable_wrapper& d)
+        {
+            get_inner_child_disposable().add(d);
+            if constexpr (backpressured)
+            {
+                size_t requested{};
+                {
+                    rpp::utils::pointer_under_lock<concat_demand> demand{m_demand};
+                    demand->inner = d;
+                    requested     = demand->requested;
+                }
+                if (requested != 0)
+                    d.request(requested);
+            }
+        }
+
+        void set_outer_upstream(const disposable_wrapper& d)
+        {
+            get_base_child_disposable().add(d);
+            if constexpr (backpressured)
+            {
+                rpp::utils::pointer_under_lock<concat_demand>{m_demand}->outer = d;
+                // only one not subscribed observable is kept
+                d.request(1);
+            }
+        }
+
+        void request_next_observable()
+        {
+            if constexpr (backpressured)
+            {
+                const auto outer = rpp::utils::pointer_under_lock<concat_demand>{m_demand}->outer;
+                outer.request(1);
+            }
+        }
+
         rpp::utils::pointer_under_lock<TObserver>               get_observer() { return m_observer; }
         rpp::utils::pointer_under_lock<std::queue<TObservable>> get_queue() { return m_queue; }
 
@@ -108,6 +182,7 @@ namespace rpp::operators::details
         rpp::utils::value_with_mutex<TObserver>               m_observer;
         rpp::utils::value_with_mutex<std::queue<TObservable>> m_queue;
         std::atomic<ConcatStage>                              m_stage{};
+        rpp::utils::value_with_mutex<concat_demand>           m_demand{};
 
         std::array<rpp::composite_disposable, 2> m_child_disposables{};
     };
@@ -116,12 +191,14 @@ namespace rpp::operators::details
     struct concat_inner_observer_strategy
     {
         static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::Boolean;
+        static constexpr bool backpressured              = TObserver::backpressured;
 
         std::shared_ptr<concat_disposable<TObservable, TObserver>> disposable{};
 
         template<typename T>
         void on_next(T&& v) const
         {
+            disposable->on_inner_next();
             disposable->get_observer()->on_next(std::forward<T>(v));
         }
 
@@ -133,6 +210,7 @@ namespace rpp::operators::details
         void on_completed() const
         {
             disposable->get_inner_child_disposable().clear();
+            disposable->request_next_observable();
 
             ConcatStage current{ConcatStage::Draining};
             if (disposable->stage().compare_exchange_strong(current, ConcatStage::CompletedWhileDraining, std::memory_order::seq_cst))
@@ -143,7 +221,7 @@ namespace rpp::operators::details
             disposable->drain();
         }
 
-        void set_upstream(const disposable_wrapper& d) const { disposable->get_inner_child_disposable().add(d); }
+        void set_upstream(const disposable_wrapper& d) const { disposable->set_inner_upstream(d); }
 
         bool is_disposed() const { return disposable->get_inner_child_disposable().is_disposed(); }
     };
@@ -152,6 +230,7 @@ namespace rpp::operators::details
     struct concat_observer_strategy
     {
         static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+        static constexpr bool backpressured              = TObserver::backpressured;
 
         std::shared_ptr<concat_disposable<TObservable, TObserver>> disposable;
 
@@ -182,7 +261,7 @@ namespace rpp::operators::details
                 disposable->get_observer()->on_completed();
         }
 
-        void set_upstream(const disposable_wrapper& d) const { disposable->get_base_child_disposable().add(d); }
+        void set_upstream(const disposable_wrapper& d) const { disposable->set_outer_upstream(d); }
 
         bool is_disposed() const { return disposable->get_base_child_disposable().is_disposed(); }
 
@@ -233,6 +312,7 @@ namespace rpp::operators
      }
      *
      * @details Actually it subscribes on first observable from emissions. When first observable completes, then it subscribes on second observable from emissions and etc...
+     * In case of backpressured observer demand is passed to current observable and not satisfied part of it is passed to the next one. Observables themselves are requested one by one, so, no more than one observable waits for subscription.
      *
      * @tparam MemoryModel rpp::memory_model strategy used to handle provided observables
      *
@@ -0,0 +1,427 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/operators/fwd.hpp>
+
+#include <rpp/defs.hpp>
+#include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/operators/details/strategy.hpp>
+#include <rpp/utils/utils.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+
+namespace rpp::operators::details
+{
+    template<rpp::constraint::decayed_type Type>
+    struct concat_map_eager_inner final : public rpp::composite_disposable
+    {
+        // fields are guarded by mutex of concat_map_eager_disposable
+
+        // values received while observable is not the first one
+        std::deque<Type> queue{};
+        // values emitted to observer but not requested from observable again yet
+        size_t consumed{};
+        bool   completed{};
+        // observable is the first one not finished yet, so, its values are emitted to observer
+        bool first{};
+        // first upstream of observable is used to request values
+        std::optional<rpp::disposable_wrapper> upstream{};
+    };
+
+    template<rpp::constraint::observable TInnerObservable>
+    struct concat_map_eager_state
+    {
+        using inner_t = concat_map_eager_inner<rpp::utils::extract_observable_type_t<TInnerObservable>>;
+
+        // subscribed observables in order of emission by upstream
+        std::deque<rpp::disposable_wrapper_impl<inner_t>> inners{};
+        // observables emitted by upstream but not subscribed yet
+        std::deque<TInnerObservable>      pending{};
+        std::optional<std::exception_ptr> error{};
+        rpp::disposable_wrapper           outer{};
+        bool                              outer_completed{};
+        bool                              draining{};
+        bool                              subscribing{};
+    };
+
+    template<rpp::constraint::observable TInnerObservable, rpp::constraint::observer TObserver>
+    struct concat_map_eager_inner_strategy;
+
+    template<rpp::constraint::observable TInnerObservable, rpp::constraint::observer TObserver>
+    class concat_map_eager_disposable final : public rpp::composite_disposable
+        , public rpp::details::enable_wrapper_from_this<concat_map_eager_disposable<TInnerObservable, TObserver>>
+    {
+        using state_t = concat_map_eager_state<TInnerObservable>;
+
+    public:
+        using inner_t = typename state_t::inner_t;
+
+        concat_map_eager_disposable(TObserver&& observer, size_t max_concurrency, size_t prefetch)
+            : m_observer{std::move(observer)}
+            , m_max_concurrency{std::max(size_t{1}, max_concurrency)}
+            , m_prefetch{prefetch}
+        {
+        }
+
+        // can be used only before subscription to any observable
+        TObserver& get_observer() { return m_observer; }
+
+        /**
+         * @brief Backpressured upstream is requested for no more observables than could be subscribed, so, observables are not kept in queue.
+         */
+        void set_outer_upstream(const rpp::disposable_wrapper& d)
+        {
+            add(d);
+            rpp::utils::pointer_under_lock<state_t>{m_state}->outer = d;
+            d.request(m_max_concurrency);
+        }
+
+        void on_outer_next(TInnerObservable&& observable)
+        {
+            rpp::utils::pointer_under_lock<state_t>{m_state}->pending.push_back(std::move(observable));
+            subscribe_pending();
+        }
+
+        void on_outer_completed()
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                state->outer_completed = true;
+                if (std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+        void on_error(const std::exception_ptr& err)
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                if (!state->error)
+                    state->error.emplace(err);
+                if (std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+        /**
+         * @brief Backpressured observable is requested for `prefetch` values in advance, so, no more than `prefetch` values are buffered for it.
+         */
+        void set_inner_upstream(const std::shared_ptr<inner_t>& inner, const rpp::disposable_wrapper& d)
+        {
+            inner->add(d);
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                if (inner->upstream)
+                    return;
+                inner->upstream.emplace(d);
+            }
+            d.request(m_prefetch == 0 ? unbounded_demand : m_prefetch);
+        }
+
+        template<typename T>
+        void on_inner_next(const std::shared_ptr<inner_t>& inner, T&& v)
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                // first observable emits values directly while nobody else emits, so, its queue is empty
+                if (!inner->first || std::exchange(state->draining, true))
+                {
+                    inner->queue.emplace_back(std::forward<T>(v));
+                    return;
+                }
+            }
+
+            m_observer.on_next(std::forward<T>(v));
+            replenish(inner);
+            drain();
+        }
+
+        void on_inner_completed(const std::shared_ptr<inner_t>& inner)
+        {
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                inner->completed = true;
+                if (!inner->first || std::exchange(state->draining, true))
+                    return;
+            }
+            drain();
+        }
+
+    private:
+        /**
+         * @brief Emit buffered values of the first observable till it completes, then continue with the next one. Can be called only by owner of draining.
+         */
+        void drain()
+        {
+            while (!is_disposed())
+            {
+                std::optional<rpp::utils::extract_observable_type_t<TInnerObservable>> value{};
+                std::shared_ptr<inner_t>                                               inner{};
+                auto                                                                   finished = rpp::disposable_wrapper_impl<inner_t>::empty();
+                std::optional<std::exception_ptr>                                      error{};
+                rpp::disposable_wrapper                                                outer{};
+                {
+                    rpp::utils::pointer_under_lock<state_t> state{m_state};
+                    if (state->error)
+                        error = state->error;
+                    else if (!state->inners.empty())
+                    {
+                        inner = state->inners.front().lock();
+                        if (!inner->queue.empty())
+                        {
+                            value.emplace(std::move(inner->queue.front()));
+                            inner->queue.pop_front();
+                        }
+                        else if (inner->completed)
+                        {
+                            finished = std::move(state->inners.front());
+                            state->inners.pop_front();
+                            if (!state->inners.empty())
+                                state->inners.front().lock()->first = true;
+                            outer = state->outer;
+                        }
+                        else
+                        {
+                            state->draining = false;
+                            return;
+                        }
+                    }
+                    else if (!state->outer_completed || !state->pending.empty())
+                    {
+                        state->draining = false;
+                        return;
+                    }
+                }
+
+                if (error)
+                {
+                    m_observer.on_error(error.value());
+                    return;
+                }
+
+                if (value)
+                {
+                    m_observer.on_next(std::move(value).value());
+                    replenish(inner);
+                }
+                else if (inner)
+                {
+                    remove(finished);
+                    finished.dispose();
+                    outer.request(1);
+                    subscribe_pending();
+                }
+                else
+                {
+                    m_observer.on_completed();
+                    return;
+                }
+            }
+        }
+
+        void replenish(const std::shared_ptr<inner_t>& inner)
+        {
+            if (m_prefetch == 0)
+                return;
+
+            // requested in batches to not request after each value
+            size_t                                 count{};
+            std::optional<rpp::disposable_wrapper> upstream{};
+            {
+                rpp::utils::pointer_under_lock<state_t> state{m_state};
+                if (++inner->consumed < m_prefetch - m_prefetch / 4)
+                    return;
+                count    = std::exchange(inner->consumed, 0);
+                upstream = inner->upstream;
+            }
+            if (upstream)
+                upstream->request(count);
+        }
+
+        void subscribe_pending()
+        {
+            // subscribing is done in loop by one thread to avoid recursion in case of inner observables completing synchronously
+            if (std::exchange(rpp::utils::pointer_under_lock<state_t>{m_state}->subscribing, true))
+                return;
+
+            while (true)
+            {
+                std::optional<TInnerObservable> observable{};
+                auto                            inner = rpp::disposable_wrapper_impl<inner_t>::empty();
+                {
+                    rpp::utils::pointer_under_lock<state_t> state{m_state};
+                    if (is_disposed())
+                        state->pending.clear();
+
+                    if (state->pending.empty() || state->inners.size() >= m_max_concurrency)
+                    {
+                        state->subscribing = false;
+                        return;
+                    }
+
+                    observable.emplace(std::move(state->pending.front()));
+                    state->pending.pop_front();
+
+                    inner               = rpp::disposable_wrapper_impl<inner_t>::make();
+                    inner.lock()->first = state->inners.empty();
+                    state->inners.push_back(inner);
+                }
+
+                add(inner);
+                std::move(observable).value().subscribe(rpp::observer<rpp::utils::extract_observable_type_t<TInnerObservable>, concat_map_eager_inner_strategy<TInnerObservable, TObserver>>{
+                    rpp::disposable_wrapper_impl<concat_map_eager_disposable>{this->wrapper_from_this()}.lock(),
+                    inner.lock()});
+            }
+        }
+
+    private:
+        // accessed only by owner of draining
+        RPP_NO_UNIQUE_ADDRESS TObserver       m_observer;
+        const size_t                          m_max_concurrency;
+        const size_t                          m_prefetch;
+        rpp::utils::value_with_mutex<state_t> m_state{};
+    };
+
+    template<rpp::constraint::observable TInnerObservable, rpp::constraint::observer TObserver>
+    struct concat_map_eager_inner_strategy
+    {
+        static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+        // observable is requested for `prefetch` values at most
+        static constexpr bool backpressured = true;
+
+        using disposable_t = concat_map_eager_disposable<TInnerObservable, TObserver>;
+
+        std::shared_ptr<disposable_t>                   disposable;
+        std::shared_ptr<typename disposable_t::inner_t> inner;
+
+        template<typename T>
+        void on_next(T&& v) const
+        {
+            disposable->on_inner_next(inner, std::forward<T>(v));
+        }
+
+        void on_error(const std::exception_ptr& err) const { disposable->on_error(err); }
+
+        void on_completed() const { disposable->on_inner_completed(inner); }
+
+        void set_upstream(const rpp::disposable_wrapper& d) const { disposable->set_inner_upstream(inner, d); }
+
+        bool is_disposed() const { return inner->is_disposed(); }
+    };
+
+    template<rpp::constraint::observable TInnerObservable, rpp::constraint::decayed_type Fn, rpp::constraint::observer TObserver>
+    class concat_map_eager_observer_strategy
+    {
+        using disposable_t = concat_map_eager_disposable<TInnerObservable, TObserver>;
+
+    public:
+        static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+        // upstream is requested for observables as soon as they could be subscribed
+        static constexpr bool backpressured = true;
+
+        concat_map_eager_observer_strategy(TObserver&& observer, const Fn& fn, size_t max_concurrency, size_t prefetch)
+            : m_disposable{init_state(std::move(observer), max_concurrency, prefetch)}
+            , m_fn{fn}
+        {
+        }
+
+        template<typename T>
+        void on_next(T&& v) const
+        {
+            m_disposable->on_outer_next(m_fn(std::forward<T>(v)));
+        }
+
+        void on_error(const std::exception_ptr& err) const { m_disposable->on_error(err); }
+
+        void on_completed() const { m_disposable->on_outer_completed(); }
+
+        void set_upstream(const rpp::disposable_wrapper& d) const { m_disposable->set_outer_upstream(d); }
+
+        bool is_disposed() const { return m_disposable->is_disposed(); }
+
+    private:
+        static std::shared_ptr<disposable_t> init_state(TObserver&& observer, size_t max_concurrency, size_t prefetch)
+        {
+            const auto d   = disposable_wrapper_impl<disposable_t>::make(std::move(observer), max_concurrency, prefetch);
+            auto       ptr = d.lock();
+            ptr->get_observer().set_upstream(d.as_weak());
+            return ptr;
+        }
+
+    private:
+        std::shared_ptr<disposable_t> m_disposable;
+        RPP_NO_UNIQUE_ADDRESS Fn      m_fn;
+    };
+
+    template<rpp::constraint::decayed_type Fn>
+    struct concat_map_eager_t : lift_operator<concat_map_eager_t<Fn>, Fn, size_t, size_t>
+    {
+        using lift_operator<concat_map_eager_t<Fn>, Fn, size_t, size_t>::lift_operator;
+
+        template<rpp::constraint::decayed_type T>
+        struct operator_traits
+        {
+            static_assert(std::invocable<Fn, T> && rpp::constraint::observable<std::invoke_result_t<Fn, T>>, "Fn should return observable");
+
+            using inner_observable_type = std::decay_t<std::invoke_result_t<Fn, T>>;
+            using result_type           = rpp::utils::extract_observable_type_t<inner_observable_type>;
+
+            template<rpp::constraint::observer_of_type<result_type> TObserver>
+            using observer_strategy = concat_map_eager_observer_strategy<inner_observable_type, Fn, std::decay_t<TObserver>>;
+        };
+
+        template<rpp::details::observables::constraint::disposables_strategy Prev>
+        using updated_optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<1>;
+    };
+} // namespace rpp::operators::details
+
+namespace rpp::operators
+{
+    /**
+     * @brief Transform the items emitted by an Observable into Observables and subscribe on up to `max_concurrency` of them at the same time, but emit their values strictly in order of upstream items: values of the next observable are buffered till all previous observables complete.
+     *
+     * @marble concat_map_eager
+         {
+             source observable                          : +-1-2-3-|
+             operator "concat_map_eager: x=>just(x,x)"  : +-11-22-33-|
+         }
+     *
+     * @details Actually it is ordered version of `rpp::operators::flat_map(callable, max_concurrent)`: observables run concurrently, so, pipeline of ordered requests has throughput of parallel requests instead of `1/latency` of `rpp::operators::concat()`. Values of the first observable are emitted directly, values of other observables are kept in buffer till they become the first one.
+     * Backpressure-aware observables are requested for `prefetch` values in advance and for more values as soon as buffered values are emitted, so, no more than `prefetch` values are buffered per observable. Upstream is requested for `max_concurrency` items and then for one more item per finished observable, so, backpressure-aware upstream emits items only when observables could be subscribed.
+     *
+     * @par Performance notes:
+     * - 1 heap allocation for state and 1 heap allocation per observable
+     * - Acquiring mutex for each emission of observables, values are emitted to observer outside of mutex
+     * - Values of not first observables are buffered
+     *
+     * @param callable function that returns an observable for each item emitted by the source observable.
+     * @param max_concurrency maximum amount of observables subscribed or buffered at the same time. `0` is treated as `1`.
+     * @param prefetch maximum amount of values requested from each observable in advance. `0` means unbounded. Observables not aware of backpressure are buffered without limit.
+     * @note `#include <rpp/operators/concat_map_eager.hpp>`
+     *
+     * @par Example:
+     * @snippet concat_map_eager.cpp concat_map_eager
+     *
+     * @ingroup transforming_operators
+     * @see https://reactivex.io/documentation/operators/flatmap.html
+     */
+    template<typename Fn>
+        requires (!utils::is_not_template_callable<Fn> || rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::convertible_to_any>>)
+    auto concat_map_eager(Fn&& callable, size_t max_concurrency, size_t prefetch)
+    {
+        return details::concat_map_eager_t<std::decay_t<Fn>>{std::forward<Fn>(callable), max_concurrency, prefetch};
+    }
+} // namespace rpp::operators
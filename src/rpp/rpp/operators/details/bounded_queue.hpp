@@ -0,0 +1,178 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/operators/fwd.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rpp::operators::details
+{
+    /**
+     * @brief Bounded single-producer single-consumer queue applying `overflow_policy` when it is full. Has the same ownership of draining as `spsc_queue`.
+     * @details Storage is fixed ring allocated once. Dropping of the oldest value has to be done by producer, so, queue is guarded by mutex: it is locked once per push and twice per drained batch.
+     * Terminal emission is pushed via `push_terminal`: it ignores capacity and closes queue for further values.
+     */
+    template<typename T>
+    class bounded_queue
+    {
+    public:
+        enum class push_result : uint8_t
+        {
+            queued,         // value is queued or dropped by policy, draining is owned by somebody else
+            drain_required, // value is queued into empty queue, caller obtains ownership of draining
+            overflow        // queue is full and policy is `overflow_policy::error`, value is not queued
+        };
+
+        bounded_queue(size_t capacity, overflow_policy policy, observe_on_counters* counters)
+            : m_capacity{policy == overflow_policy::latest_only ? 1 : std::max(size_t{1}, capacity)}
+            , m_buffer(m_capacity + 1)
+            , m_policy{policy}
+            , m_counters{counters}
+        {
+        }
+
+        bounded_queue(const bounded_queue&) = delete;
+        bounded_queue(bounded_queue&&)      = delete;
+
+        size_t capacity() const { return m_capacity; }
+
+        template<typename TT>
+        push_result push(TT&& value)
+        {
+            std::unique_lock lock{m_mutex};
+            if (m_closed)
+                return push_result::queued;
+
+            if (m_size >= m_capacity)
+            {
+                switch (m_policy)
+                {
+                case overflow_policy::block:
+                    m_not_full.wait(lock, [this] { return m_size < m_capacity || m_closed; });
+                    if (m_closed)
+                        return push_result::queued;
+                    break;
+                case overflow_policy::drop_newest:
+                    on_dropped();
+                    return push_result::queued;
+                case overflow_policy::drop_oldest:
+                case overflow_policy::latest_only:
+                    pop_front();
+                    on_dropped();
+                    break;
+                case overflow_policy::error:
+                    return push_result::overflow;
+                }
+            }
+            return emplace_back(std::forward<TT>(value));
+        }
+
+        /**
+         * @param drop_values drop all not emitted values before pushing of terminal emission
+         * @return true if caller obtains ownership of draining
+         */
+        template<typename TT>
+        bool push_terminal(TT&& value, bool drop_values)
+        {
+            std::lock_guard lock{m_mutex};
+            if (m_closed)
+                return false;
+
+            m_closed = true;
+            while (drop_values && m_size != 0)
+                pop_front();
+            return emplace_back(std::forward<TT>(value)) == push_result::drain_required;
+        }
+
+        /**
+         * @brief Ignore further pushes and wake up producer waiting for free space
+         */
+        void close()
+        {
+            {
+                std::lock_guard lock{m_mutex};
+                m_closed = true;
+            }
+            m_not_full.notify_all();
+        }
+
+        /**
+         * @brief Same as `spsc_queue::drain`: pass up to `max_count` values to `fn`. Can be called only by owner of draining.
+         * @return true if queue is still not empty and caller keeps ownership of draining.
+         */
+        template<typename Fn>
+        bool drain(Fn&& fn, size_t max_count)
+        {
+            {
+                std::lock_guard lock{m_mutex};
+                while (m_size != 0 && m_batch.size() < max_count)
+                    m_batch.push_back(pop_front());
+            }
+            if (m_policy == overflow_policy::block)
+                m_not_full.notify_one();
+
+            for (auto& value : m_batch)
+                fn(std::move(value));
+            m_batch.clear();
+
+            std::lock_guard lock{m_mutex};
+            m_draining = m_size != 0;
+            return m_draining;
+        }
+
+    private:
+        template<typename TT>
+        push_result emplace_back(TT&& value)
+        {
+            m_buffer[(m_head + m_size) % m_buffer.size()].emplace(std::forward<TT>(value));
+            ++m_size;
+            return std::exchange(m_draining, true) ? push_result::queued : push_result::drain_required;
+        }
+
+        T pop_front()
+        {
+            auto& slot   = m_buffer[m_head];
+            T     result = std::move(slot).value();
+            slot.reset();
+            m_head = (m_head + 1) % m_buffer.size();
+            --m_size;
+            return result;
+        }
+
+        void on_dropped() const
+        {
+            if (m_counters)
+                m_counters->dropped.fetch_add(1, std::memory_order::relaxed);
+        }
+
+    private:
+        const size_t                  m_capacity;
+        std::vector<std::optional<T>> m_buffer;
+        const overflow_policy         m_policy;
+        observe_on_counters* const    m_counters;
+
+        std::mutex              m_mutex{};
+        std::condition_variable m_not_full{};
+        size_t                  m_head{};
+        size_t                  m_size{};
+        bool                    m_draining{};
+        bool                    m_closed{};
+
+        // consumer's buffer of values extracted from queue for emission
+        std::vector<T> m_batch{};
+    };
+} // namespace rpp::operators::details
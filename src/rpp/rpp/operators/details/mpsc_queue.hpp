@@ -0,0 +1,102 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace rpp::operators::details
+{
+    /**
+     * @brief Unbounded lock-free multi-producer single-consumer queue with built-in ownership of draining.
+     * @details Producers push values into lock-free stack, owner of draining takes whole stack at once and passes it in order of pushing, so, values are drained in batches and producers never wait for each other or for consumer.
+     * Amount of pending pushes is used to hand-off draining: producer receives `true` from `push` only when nobody drains queue, so, exactly one drain is active at any moment and owner releases it only when all pushes are drained.
+     */
+    template<typename T>
+    class mpsc_queue
+    {
+        struct node
+        {
+            T     value;
+            node* next{};
+        };
+
+    public:
+        mpsc_queue() = default;
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue(mpsc_queue&&)      = delete;
+
+        ~mpsc_queue() noexcept
+        {
+            for (node* head = m_head.load(std::memory_order_acquire); head;)
+                delete std::exchange(head, head->next);
+        }
+
+        /**
+         * @brief Obtain ownership of draining without pushing, so, caller can handle its value directly. Succeeds only if nobody drains queue right now.
+         * @details Owner has to call `drain` after handling of its value to pass values pushed meanwhile and release ownership.
+         */
+        bool try_acquire() noexcept
+        {
+            size_t expected{};
+            return m_pending.compare_exchange_strong(expected, 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Push value to queue. Can be called by any amount of producers simultaneously.
+         * @return true if nobody drained queue, so, caller obtains ownership of draining and has to call `drain`.
+         */
+        template<typename TT>
+        bool push(TT&& value)
+        {
+            auto* n = new node{T(std::forward<TT>(value)), m_head.load(std::memory_order_relaxed)};
+            while (!m_head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+            return m_pending.fetch_add(1, std::memory_order_acq_rel) == 0;
+        }
+
+        /**
+         * @brief Pass all values to `fn` till queue is empty and release ownership of draining. Can be called only by owner of draining.
+         * @details Values of each producer are passed in order of pushing. Values pushed during draining are passed too.
+         */
+        template<typename Fn>
+        void drain(Fn&& fn)
+        {
+            size_t missed = 1;
+            while (true)
+            {
+                // stack has reversed order of pushing
+                node* batch{};
+                for (node* head = m_head.exchange(nullptr, std::memory_order_acquire); head;)
+                    batch = std::exchange(head, std::exchange(head->next, batch));
+
+                while (batch)
+                {
+                    std::unique_ptr<node> current{std::exchange(batch, batch->next)};
+                    fn(std::move(current->value));
+                }
+
+                missed = m_pending.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+                if (missed == 0)
+                    return;
+            }
+        }
+
+    private:
+        std::atomic<node*> m_head{};
+        // non-zero while draining is owned: amount of pushes (and direct handling by owner) not accounted by owner yet
+        std::atomic<size_t> m_pending{};
+    };
+} // namespace rpp::operators::details
@@ -0,0 +1,143 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace rpp::operators::details
+{
+    /**
+     * @brief Unbounded lock-free single-producer single-consumer queue with built-in ownership of draining.
+     * @details Values are stored in linked chunks, so, push costs one atomic increment of size while chunk has free slots. Size of queue is used to hand-off draining: producer receives `true` from `push` only when queue was empty, so, exactly one drain is active at any moment and consumer releases it only when it observes empty queue.
+     * Pushes have to be serialized (e.g. by observable contract), but can happen from different threads.
+     */
+    template<typename T>
+    class spsc_queue
+    {
+        static constexpr size_t s_chunk_size      = 64;
+        static constexpr size_t s_cache_line_size = 64;
+
+        struct chunk
+        {
+            T*         get(size_t index) { return std::launder(reinterpret_cast<T*>(get_raw(index))); }
+            std::byte* get_raw(size_t index) { return storage + index * sizeof(T); }
+
+            alignas(T) std::byte storage[s_chunk_size * sizeof(T)];
+            // written by producer before publishing of the first value of the next chunk
+            chunk* next{};
+        };
+
+    public:
+        spsc_queue()
+            : m_tail_chunk{new chunk}
+            , m_head_chunk{m_tail_chunk}
+        {
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue(spsc_queue&&)      = delete;
+
+        ~spsc_queue() noexcept
+        {
+            for (size_t size = m_size.load(std::memory_order_acquire); size != 0; --size)
+                std::destroy_at(pop_slot());
+
+            while (m_head_chunk)
+                delete std::exchange(m_head_chunk, m_head_chunk->next);
+            delete m_spare.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Push value to queue. Can be called only by producer.
+         * @return true if queue was empty before this push, so, caller obtains ownership of draining
+         */
+        template<typename TT>
+        bool push(TT&& value)
+        {
+            if (m_tail_index == s_chunk_size)
+            {
+                chunk* next = m_spare.exchange(nullptr, std::memory_order_acquire);
+                if (next)
+                    next->next = nullptr;
+                else
+                    next = new chunk;
+
+                m_tail_chunk->next = next;
+                m_tail_chunk       = next;
+                m_tail_index       = 0;
+            }
+
+            std::construct_at(reinterpret_cast<T*>(m_tail_chunk->get_raw(m_tail_index++)), std::forward<TT>(value));
+            return m_size.fetch_add(1, std::memory_order_acq_rel) == 0;
+        }
+
+        /**
+         * @brief Pass up to `max_count` values to `fn` in order of pushing. Can be called only by owner of draining.
+         * @details Values pushed during draining are passed too till `max_count` is reached.
+         * @return true if queue is still not empty, so, caller keeps ownership of draining and has to call `drain` again later. false if queue is drained and ownership is released.
+         */
+        template<typename Fn>
+        bool drain(Fn&& fn, size_t max_count)
+        {
+            size_t processed{};
+            size_t available = m_size.load(std::memory_order_acquire);
+            while (true)
+            {
+                const size_t count = std::min(available, max_count - processed);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    T* value = pop_slot();
+                    fn(std::move(*value));
+                    std::destroy_at(value);
+                }
+                processed += count;
+
+                available = m_size.fetch_sub(count, std::memory_order_acq_rel) - count;
+                if (available == 0)
+                    return false;
+                if (processed == max_count)
+                    return true;
+            }
+        }
+
+    private:
+        T* pop_slot()
+        {
+            if (m_head_index == s_chunk_size)
+            {
+                // next chunk is published together with its first value, so, it is visible here
+                chunk* next = m_head_chunk->next;
+                delete m_spare.exchange(m_head_chunk, std::memory_order_release);
+                m_head_chunk = next;
+                m_head_index = 0;
+            }
+            return m_head_chunk->get(m_head_index++);
+        }
+
+    private:
+        // producer's side
+        chunk* m_tail_chunk;
+        size_t m_tail_index{};
+
+        // consumer's side
+        alignas(s_cache_line_size) chunk* m_head_chunk;
+        size_t m_head_index{};
+
+        alignas(s_cache_line_size) std::atomic<size_t> m_size{};
+        // fully consumed chunk reused by producer to avoid allocation per chunk
+        std::atomic<chunk*> m_spare{};
+    };
+} // namespace rpp::operators::details
@@ -16,10 +16,11 @@
 
 namespace rpp::operators::details
 {
-    template<rpp::constraint::decayed_type Fn>
+    template<rpp::constraint::decayed_type Fn, rpp::constraint::decayed_type MergeOperator>
     struct flat_map_t
     {
-        RPP_NO_UNIQUE_ADDRESS Fn m_fn;
+        RPP_NO_UNIQUE_ADDRESS Fn            m_fn;
+        RPP_NO_UNIQUE_ADDRESS MergeOperator m_merge;
 
         template<rpp::constraint::observable TObservable>
         auto operator()(TObservable&& observable) const &
@@ -27,7 +28,7 @@ namespace rpp::operators::details
             static_assert(std::invocable<Fn, rpp::utils::extract_observable_type_t<TObservable>> && rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::extract_observable_type_t<TObservable>>>, "fn should return observable");
             return std::forward<TObservable>(observable)
                  | rpp::ops::map(m_fn)
-                 | rpp::ops::merge();
+                 | m_merge;
         }
 
         template<rpp::constraint::observable TObservable>
@@ -36,7 +37,7 @@ namespace rpp::operators::details
             static_assert(std::invocable<Fn, rpp::utils::extract_observable_type_t<TObservable>> && rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::extract_observable_type_t<TObservable>>>, "fn should return observable");
             return std::forward<TObservable>(observable)
                  | rpp::ops::map(std::move(m_fn))
-                 | rpp::ops::merge();
+                 | std::move(m_merge);
         }
     };
 
@@ -67,7 +68,32 @@ namespace rpp::operators
         requires (!utils::is_not_template_callable<Fn> || rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::convertible_to_any>>)
     auto flat_map(Fn&& callable)
     {
-        return details::flat_map_t<std::decay_t<Fn>>{std::forward<Fn>(callable)};
+        return details::flat_map_t<std::decay_t<Fn>, details::merge_t>{std::forward<Fn>(callable), details::merge_t{}};
+    }
+
+    /**
+     * @brief Transform the items emitted by an Observable into Observables, then flatten the emissions from those into a single Observable, but subscribes on no more than `max_concurrent` of them at the same time
+     *
+     * @marble flat_map_max_concurrent
+            {
+                source observable                      : +-1-2-3-----|
+                operator "flat_map(x=>just(x,x), 1)"   : +-11-22-33--|
+            }
+     *
+     * @details Actually it makes `map(callable)` and then `merge(max_concurrent)`, so, items emitted while `max_concurrent` observables are active are transformed immediately, but resulting observables are subscribed only when any active observable completes. See `rpp::operators::merge(size_t)` for details.
+     *
+     * @param callable function that returns an observable for each item emitted by the source observable.
+     * @param max_concurrent maximum amount of observables subscribed at the same time.
+     * @note `#include <rpp/operators/flat_map.hpp>`
+     *
+     * @ingroup transforming_operators
+     * @see https://reactivex.io/documentation/operators/flatmap.html
+     */
+    template<typename Fn>
+        requires (!utils::is_not_template_callable<Fn> || rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::convertible_to_any>>)
+    auto flat_map(Fn&& callable, size_t max_concurrent)
+    {
+        return details::flat_map_t<std::decay_t<Fn>, details::merge_max_concurrent_t>{std::forward<Fn>(callable), details::merge_max_concurrent_t{max_concurrent}};
     }
 
 } // namespace rpp::operators
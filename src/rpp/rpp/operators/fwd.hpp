@@ -18,14 +18,58 @@
 #include <rpp/utils/constraints.hpp>
 #include <rpp/utils/utils.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 namespace rpp::operators
 {
+    /**
+     * @brief Behavior of bounded buffer in case of new value doesn't fit into it
+     */
+    enum class overflow_policy : uint8_t
+    {
+        block,       // producer waits till consumer frees space
+        drop_newest, // new value is dropped
+        drop_oldest, // the oldest not emitted value is dropped
+        latest_only, // only the latest value is kept (capacity is ignored)
+        error        // `rpp::utils::buffer_overflow` is emitted as on_error and upstream is disposed
+    };
+
+    /**
+     * @brief Counters of bounded `observe_on`. Can be shared between multiple operators and read from any thread.
+     */
+    struct observe_on_counters
+    {
+        // values dropped due to `overflow_policy::drop_newest`, `overflow_policy::drop_oldest` or `overflow_policy::latest_only`
+        std::atomic<uint64_t> dropped{};
+    };
+
+    /**
+     * @brief Tuning of `observe_on` without delay
+     */
+    struct observe_on_options
+    {
+        // max amount of emissions passed to observer in a row before yielding worker to other schedulables
+        size_t max_batch_size = 128;
+        // max amount of values waiting for emission, 0 means unbounded
+        size_t capacity = 0;
+        // behavior in case of `capacity` is reached
+        overflow_policy overflow = overflow_policy::block;
+        // optional counters updated by operator
+        std::shared_ptr<observe_on_counters> counters{};
+    };
+
     auto as_blocking();
 
     auto buffer(size_t count);
 
     auto concat();
 
+    template<typename Fn>
+        requires (!utils::is_not_template_callable<Fn> || rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::convertible_to_any>>)
+    auto concat_map_eager(Fn&& callable, size_t max_concurrency, size_t prefetch);
+
     template<typename TSelector, rpp::constraint::observable TObservable, rpp::constraint::observable... TObservables>
         requires (!rpp::constraint::observable<TSelector> && (!utils::is_not_template_callable<TSelector> || std::invocable<TSelector, rpp::utils::convertible_to_any, utils::extract_observable_type_t<TObservable>, utils::extract_observable_type_t<TObservables>...>))
     auto combine_latest(TSelector&& selector, TObservable&& observable, TObservables&&... observables);
@@ -60,6 +104,10 @@ namespace rpp::operators
         requires (!utils::is_not_template_callable<Fn> || rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::convertible_to_any>>)
     auto flat_map(Fn&& callable);
 
+    template<typename Fn>
+        requires (!utils::is_not_template_callable<Fn> || rpp::constraint::observable<std::invoke_result_t<Fn, rpp::utils::convertible_to_any>>)
+    auto flat_map(Fn&& callable, size_t max_concurrent);
+
     template<typename KeySelector,
              typename ValueSelector = std::identity,
              typename KeyComparator = rpp::utils::less>
@@ -83,9 +131,28 @@ namespace rpp::operators
         requires constraint::observables_of_same_type<std::decay_t<TObservable>, std::decay_t<TObservables>...>
     auto merge_with(TObservable&& observable, TObservables&&... observables);
     auto merge();
+    auto merge(size_t max_concurrent);
+
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto observe_on(Scheduler&& scheduler, observe_on_options options = {});
 
     template<rpp::schedulers::constraint::scheduler Scheduler>
-    auto observe_on(Scheduler&& scheduler, rpp::schedulers::duration delay_duration = {});
+    auto observe_on(Scheduler&& scheduler, rpp::schedulers::duration delay_duration);
+
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto observe_on(Scheduler&& scheduler, rpp::schedulers::priority priority, observe_on_options options = {});
+
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto observe_on(Scheduler&& scheduler, rpp::schedulers::priority priority, rpp::schedulers::duration delay_duration);
+
+    template<typename KeySelector, rpp::schedulers::constraint::scheduler Scheduler>
+        requires (!utils::is_not_template_callable<KeySelector> || !std::same_as<void, std::invoke_result_t<KeySelector, rpp::utils::convertible_to_any>>)
+    auto observe_on_partitioned(KeySelector&& key_selector, Scheduler&& scheduler, size_t partitions);
+
+    auto ordered_sequential();
+
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto parallel(size_t rails, Scheduler&& scheduler);
 
     auto publish();
 
@@ -113,6 +180,8 @@ namespace rpp::operators
     template<typename Fn>
     auto scan(Fn&& accumulator);
 
+    auto sequential();
+
     auto skip(size_t count);
 
     template<rpp::constraint::observable TObservable, rpp::constraint::observable... TObservables>
@@ -23,6 +23,8 @@ namespace rpp::operators::details
     struct map_observer_strategy
     {
         static constexpr auto preferred_disposables_mode = rpp::details::observers::disposables_mode::None;
+        // one value per value, so, demand of observer is demand for upstream too
+        static constexpr bool backpressured = TObserver::backpressured;
 
         RPP_NO_UNIQUE_ADDRESS TObserver observer;
         RPP_NO_UNIQUE_ADDRESS Fn        fn;
@@ -14,35 +14,181 @@
 
 #include <rpp/defs.hpp>
 #include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/disposables/details/demand.hpp>
+#include <rpp/operators/details/mpsc_queue.hpp>
 #include <rpp/operators/details/strategy.hpp>
 #include <rpp/schedulers/current_thread.hpp>
 #include <rpp/utils/tuple.hpp>
 #include <rpp/utils/utils.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
+#include <optional>
+#include <variant>
+#include <vector>
 
 namespace rpp::operators::details
 {
+    struct merge_inner_demand
+    {
+        rpp::disposable_wrapper upstream{};
+        // inner observable is requested for one value and not emitted it yet
+        bool requested{};
+    };
+
+    struct merge_demand
+    {
+        // demand of downstream not satisfied yet
+        size_t requested{};
+        // amount of inner observables requested for one value
+        size_t                                          in_flight{};
+        bool                                            requesting{};
+        std::deque<std::shared_ptr<merge_inner_demand>> idle{};
+    };
+
     template<rpp::constraint::observer TObserver>
     class merge_disposable final : public composite_disposable
     {
+        using emission = std::variant<rpp::utils::extract_observer_type_t<TObserver>, std::exception_ptr, rpp::utils::none>;
+
     public:
+        static constexpr bool backpressured = TObserver::backpressured;
+
         merge_disposable(TObserver&& observer)
             : m_observer(std::move(observer))
         {
         }
 
+        /**
+         * @brief Demand of backpressured observer is satisfied by requesting one value per inner observable: no more inner observables than not satisfied demand are requested at the same time, so, values are never buffered.
+         */
+        void request(size_t count) noexcept override
+        {
+            if constexpr (backpressured)
+            {
+                {
+                    rpp::utils::pointer_under_lock<merge_demand> demand{m_demand};
+                    demand->requested = rpp::details::disposables::add_demand(demand->requested, count);
+                }
+                request_inners();
+            }
+        }
+
+        void add_inner(const std::shared_ptr<merge_inner_demand>& inner)
+        {
+            rpp::utils::pointer_under_lock<merge_demand>{m_demand}->idle.push_back(inner);
+            request_inners();
+        }
+
+        void remove_inner(const std::shared_ptr<merge_inner_demand>& inner)
+        {
+            {
+                rpp::utils::pointer_under_lock<merge_demand> demand{m_demand};
+                if (std::exchange(inner->requested, false))
+                    --demand->in_flight;
+                else
+                    demand->idle.erase(std::remove(demand->idle.begin(), demand->idle.end(), inner), demand->idle.end());
+            }
+            request_inners();
+        }
+
+        void on_inner_next(const std::shared_ptr<merge_inner_demand>& inner)
+        {
+            rpp::utils::pointer_under_lock<merge_demand> demand{m_demand};
+            if (std::exchange(inner->requested, false))
+            {
+                --demand->in_flight;
+                demand->idle.push_back(inner);
+            }
+            if (demand->requested != unbounded_demand && demand->requested != 0)
+                --demand->requested;
+        }
+
+        void request_inners()
+        {
+            // requesting is done in loop by one thread to avoid recursion in case of inner observables emitting synchronously
+            if (std::exchange(rpp::utils::pointer_under_lock<merge_demand>{m_demand}->requesting, true))
+                return;
+
+            while (true)
+            {
+                std::shared_ptr<merge_inner_demand> inner{};
+                size_t                              count{1};
+                {
+                    rpp::utils::pointer_under_lock<merge_demand> demand{m_demand};
+                    if (demand->idle.empty() || demand->in_flight >= demand->requested)
+                    {
+                        demand->requesting = false;
+                        return;
+                    }
+
+                    inner = std::move(demand->idle.front());
+                    demand->idle.pop_front();
+                    // unbounded inner observable never returns to idle ones
+                    if (demand->requested == unbounded_demand)
+                        count = unbounded_demand;
+                    else
+                    {
+                        inner->requested = true;
+                        ++demand->in_flight;
+                    }
+                }
+                inner->upstream.request(count);
+            }
+        }
+
         // just need atomicity, not guarding anything
         void increment_on_completed() { m_on_completed_needed.fetch_add(1, std::memory_order::seq_cst); }
 
         // just need atomicity, not guarding anything
         bool decrement_on_completed() { return m_on_completed_needed.fetch_sub(1, std::memory_order::seq_cst) == 1; }
 
-        rpp::utils::pointer_under_lock<TObserver> get_observer_under_lock() { return m_observer; }
+        template<typename T>
+        void on_next(T&& v)
+        {
+            serialize(std::forward<T>(v));
+        }
+
+        void on_error(const std::exception_ptr& err) { serialize(err); }
+
+        void on_completed() { serialize(rpp::utils::none{}); }
+
+        // can be used only before subscription to any observable
+        TObserver& get_observer() { return m_observer; }
+
+    private:
+        /**
+         * @brief Emissions are serialized without blocking of producers: thread emitting while nobody else emits passes emission to observer directly, otherwise emission is queued and drained by thread emitting right now.
+         */
+        template<typename TT>
+        void serialize(TT&& value)
+        {
+            if (m_queue.try_acquire())
+                emit(std::forward<TT>(value));
+            else if (!m_queue.push(std::forward<TT>(value)))
+                return;
+
+            m_queue.drain([this](emission&& item) { std::visit([this](auto&& v) { emit(std::move(v)); }, std::move(item)); });
+        }
+
+        template<typename TT>
+        void emit(TT&& value)
+        {
+            if constexpr (rpp::constraint::decayed_same_as<TT, std::exception_ptr>)
+                m_observer.on_error(value);
+            else if constexpr (rpp::constraint::decayed_same_as<TT, rpp::utils::none>)
+                m_observer.on_completed();
+            else
+                m_observer.on_next(std::forward<TT>(value));
+        }
 
     private:
-        rpp::utils::value_with_mutex<TObserver> m_observer{};
-        std::atomic_size_t                      m_on_completed_needed{1};
+        // accessed only by owner of draining of queue
+        RPP_NO_UNIQUE_ADDRESS TObserver            m_observer;
+        mpsc_queue<emission>                       m_queue{};
+        std::atomic_size_t                         m_on_completed_needed{1};
+        rpp::utils::value_with_mutex<merge_demand> m_demand{};
     };
 
     template<rpp::constraint::observer TObserver>
@@ -59,10 +205,22 @@ namespace rpp::operators::details
         {
         }
 
+        static std::shared_ptr<merge_disposable<TObserver>> init_state(TObserver&& observer)
+        {
+            const auto d   = disposable_wrapper_impl<merge_disposable<TObserver>>::make(std::move(observer));
+            auto       ptr = d.lock();
+            ptr->get_observer().set_upstream(d.as_weak());
+            return ptr;
+        }
+
         void set_upstream(const rpp::disposable_wrapper& d) const
         {
             m_disposable->add(d);
-            m_disposables.push_back(d);
+            // observables usually pass only one upstream, so, vector is not allocated in most cases
+            if (!m_upstream)
+                m_upstream.emplace(d);
+            else
+                m_extra_upstreams.push_back(d);
         }
 
         bool is_disposed() const
@@ -72,28 +230,37 @@ namespace rpp::operators::details
 
         void on_error(const std::exception_ptr& err) const
         {
-            m_disposable->get_observer_under_lock()->on_error(err);
+            m_disposable->on_error(err);
         }
 
         void on_completed() const
         {
             if (m_disposable->decrement_on_completed())
             {
-                m_disposable->get_observer_under_lock()->on_completed();
+                m_disposable->on_completed();
             }
             else
             {
-                for (const auto& v : m_disposables)
-                {
-                    m_disposable->remove(v);
-                    v.dispose();
-                }
+                if (m_upstream)
+                    dispose_upstream(*m_upstream);
+                for (const auto& v : m_extra_upstreams)
+                    dispose_upstream(v);
             }
         }
 
+    private:
+        void dispose_upstream(const rpp::disposable_wrapper& d) const
+        {
+            m_disposable->remove(d);
+            d.dispose();
+        }
+
     protected:
         std::shared_ptr<merge_disposable<TObserver>> m_disposable;
-        mutable std::vector<rpp::disposable_wrapper> m_disposables{};
+
+    private:
+        mutable std::optional<rpp::disposable_wrapper> m_upstream{};
+        mutable std::vector<rpp::disposable_wrapper>   m_extra_upstreams{};
     };
 
     template<rpp::constraint::observer TObserver>
@@ -101,11 +268,52 @@ namespace rpp::operators::details
     {
         using merge_observer_base_strategy<TObserver>::merge_observer_base_strategy;
 
+        static constexpr bool backpressured = TObserver::backpressured;
+
         template<typename T>
         void on_next(T&& v) const
         {
-            merge_observer_base_strategy<TObserver>::m_disposable->get_observer_under_lock()->on_next(std::forward<T>(v));
+            const auto& disposable = merge_observer_base_strategy<TObserver>::m_disposable;
+            if constexpr (backpressured)
+            {
+                if (m_demand)
+                {
+                    disposable->on_inner_next(m_demand);
+                    disposable->on_next(std::forward<T>(v));
+                    disposable->request_inners();
+                    return;
+                }
+            }
+
+            disposable->on_next(std::forward<T>(v));
+        }
+
+        void set_upstream(const rpp::disposable_wrapper& d) const
+        {
+            merge_observer_base_strategy<TObserver>::set_upstream(d);
+            if constexpr (backpressured)
+            {
+                // only first upstream is used to request values
+                if (!m_demand)
+                {
+                    m_demand = std::make_shared<merge_inner_demand>(merge_inner_demand{.upstream = d});
+                    merge_observer_base_strategy<TObserver>::m_disposable->add_inner(m_demand);
+                }
+            }
         }
+
+        void on_completed() const
+        {
+            if constexpr (backpressured)
+            {
+                if (m_demand)
+                    merge_observer_base_strategy<TObserver>::m_disposable->remove_inner(m_demand);
+            }
+            merge_observer_base_strategy<TObserver>::on_completed();
+        }
+
+    private:
+        RPP_NO_UNIQUE_ADDRESS mutable std::conditional_t<backpressured, std::shared_ptr<merge_inner_demand>, rpp::utils::none> m_demand{};
     };
 
     template<rpp::constraint::observer TObserver>
@@ -113,7 +321,7 @@ namespace rpp::operators::details
     {
     public:
         explicit merge_observer_strategy(TObserver&& observer)
-            : merge_observer_base_strategy<TObserver>{init_state(std::move(observer))}
+            : merge_observer_base_strategy<TObserver>{merge_observer_base_strategy<TObserver>::init_state(std::move(observer))}
         {
         }
 
@@ -123,15 +331,153 @@ namespace rpp::operators::details
             merge_observer_base_strategy<TObserver>::m_disposable->increment_on_completed();
             std::forward<T>(v).subscribe(rpp::observer<rpp::utils::extract_observer_type_t<TObserver>, merge_observer_inner_strategy<TObserver>>{merge_observer_inner_strategy<TObserver>{merge_observer_base_strategy<TObserver>::m_disposable}});
         }
+    };
+
+    template<rpp::constraint::observable TObservable>
+    struct merge_pending
+    {
+        // observables emitted by upstream but not subscribed yet
+        std::deque<TObservable> observables{};
+        size_t                  active{};
+        bool                    subscribing{};
+        rpp::disposable_wrapper outer{};
+    };
+
+    template<rpp::constraint::observable TObservable, rpp::constraint::observer TObserver>
+    class merge_concurrency_limiter final : public std::enable_shared_from_this<merge_concurrency_limiter<TObservable, TObserver>>
+    {
+    public:
+        merge_concurrency_limiter(const std::shared_ptr<merge_disposable<TObserver>>& disposable, size_t max_concurrent)
+            : m_disposable{disposable}
+            , m_max_concurrent{std::max(size_t{1}, max_concurrent)}
+        {
+        }
+
+        /**
+         * @brief Backpressured upstream is requested for no more observables than could be subscribed, so, observables are not kept in queue.
+         */
+        void set_outer_upstream(const rpp::disposable_wrapper& d)
+        {
+            rpp::utils::pointer_under_lock<merge_pending<TObservable>>{m_pending}->outer = d;
+            d.request(m_max_concurrent);
+        }
+
+        template<typename T>
+        void on_next(T&& observable)
+        {
+            m_disposable->increment_on_completed();
+            rpp::utils::pointer_under_lock<merge_pending<TObservable>>{m_pending}->observables.emplace_back(std::forward<T>(observable));
+            subscribe_pending();
+        }
+
+        void on_inner_completed()
+        {
+            rpp::disposable_wrapper outer{};
+            {
+                rpp::utils::pointer_under_lock<merge_pending<TObservable>> pending{m_pending};
+                --pending->active;
+                outer = pending->outer;
+            }
+            outer.request(1);
+            subscribe_pending();
+        }
 
     private:
-        static std::shared_ptr<merge_disposable<TObserver>> init_state(TObserver&& observer)
+        void subscribe_pending();
+
+    private:
+        std::shared_ptr<merge_disposable<TObserver>>             m_disposable;
+        const size_t                                             m_max_concurrent;
+        rpp::utils::value_with_mutex<merge_pending<TObservable>> m_pending{};
+    };
+
+    template<rpp::constraint::observable TObservable, rpp::constraint::observer TObserver>
+    struct merge_concurrent_inner_strategy final
+    {
+        static constexpr auto preferred_disposables_mode = merge_observer_inner_strategy<TObserver>::preferred_disposables_mode;
+        static constexpr bool backpressured              = TObserver::backpressured;
+
+        merge_observer_inner_strategy<TObserver>                           inner;
+        std::shared_ptr<merge_concurrency_limiter<TObservable, TObserver>> limiter;
+
+        template<typename T>
+        void on_next(T&& v) const
+        {
+            inner.on_next(std::forward<T>(v));
+        }
+
+        void on_error(const std::exception_ptr& err) const { inner.on_error(err); }
+
+        void on_completed() const
+        {
+            inner.on_completed();
+            limiter->on_inner_completed();
+        }
+
+        void set_upstream(const rpp::disposable_wrapper& d) const { inner.set_upstream(d); }
+
+        bool is_disposed() const { return inner.is_disposed(); }
+    };
+
+    template<rpp::constraint::observable TObservable, rpp::constraint::observer TObserver>
+    void merge_concurrency_limiter<TObservable, TObserver>::subscribe_pending()
+    {
+        // subscribing is done in loop by one thread to avoid recursion in case of inner observables completing synchronously
+        if (std::exchange(rpp::utils::pointer_under_lock<merge_pending<TObservable>>{m_pending}->subscribing, true))
+            return;
+
+        while (true)
+        {
+            std::optional<TObservable> observable{};
+            {
+                rpp::utils::pointer_under_lock<merge_pending<TObservable>> pending{m_pending};
+                if (m_disposable->is_disposed())
+                    pending->observables.clear();
+
+                if (pending->observables.empty() || pending->active >= m_max_concurrent)
+                {
+                    pending->subscribing = false;
+                    return;
+                }
+
+                observable.emplace(std::move(pending->observables.front()));
+                pending->observables.pop_front();
+                ++pending->active;
+            }
+
+            std::move(observable).value().subscribe(rpp::observer<rpp::utils::extract_observable_type_t<TObservable>, merge_concurrent_inner_strategy<TObservable, TObserver>>{
+                merge_observer_inner_strategy<TObserver>{m_disposable},
+                this->shared_from_this()});
+        }
+    }
+
+    template<rpp::constraint::observable TObservable, rpp::constraint::observer TObserver>
+    class merge_concurrent_observer_strategy final : public merge_observer_base_strategy<TObserver>
+    {
+    public:
+        // upstream is requested for observables as soon as they could be subscribed
+        static constexpr bool backpressured = true;
+
+        merge_concurrent_observer_strategy(TObserver&& observer, size_t max_concurrent)
+            : merge_observer_base_strategy<TObserver>{merge_observer_base_strategy<TObserver>::init_state(std::move(observer))}
+            , m_limiter{std::make_shared<merge_concurrency_limiter<TObservable, TObserver>>(merge_observer_base_strategy<TObserver>::m_disposable, max_concurrent)}
         {
-            const auto d   = disposable_wrapper_impl<merge_disposable<TObserver>>::make(std::move(observer));
-            auto       ptr = d.lock();
-            ptr->get_observer_under_lock()->set_upstream(d.as_weak());
-            return ptr;
         }
+
+        template<typename T>
+        void on_next(T&& v) const
+        {
+            m_limiter->on_next(std::forward<T>(v));
+        }
+
+        void set_upstream(const rpp::disposable_wrapper& d) const
+        {
+            merge_observer_base_strategy<TObserver>::set_upstream(d);
+            m_limiter->set_outer_upstream(d);
+        }
+
+    private:
+        std::shared_ptr<merge_concurrency_limiter<TObservable, TObserver>> m_limiter;
     };
 
     struct merge_t : lift_operator<merge_t>
@@ -155,6 +501,27 @@ namespace rpp::operators::details
         using updated_optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<1>;
     };
 
+    struct merge_max_concurrent_t : lift_operator<merge_max_concurrent_t, size_t>
+    {
+        using lift_operator<merge_max_concurrent_t, size_t>::lift_operator;
+
+        template<rpp::constraint::decayed_type T>
+        struct operator_traits
+        {
+            static_assert(rpp::constraint::observable<T>, "T is not observable");
+
+            using result_type = rpp::utils::extract_observable_type_t<T>;
+
+            constexpr static bool own_current_queue = true;
+
+            template<rpp::constraint::observer_of_type<result_type> TObserver>
+            using observer_strategy = merge_concurrent_observer_strategy<T, std::decay_t<TObserver>>;
+        };
+
+        template<rpp::details::observables::constraint::disposables_strategy Prev>
+        using updated_optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<1>;
+    };
+
     template<rpp::constraint::observable... TObservables>
     struct merge_with_t
     {
@@ -198,7 +565,7 @@ namespace rpp::operators
     /**
      * @brief Converts observable of observables of items into observable of items via merging emissions.
      *
-     * @invariant According to observable contract (https://reactivex.io/documentation/contract.html) emissions from any observable should be serialized, so, resulting observable uses mutex to satisfy this requirement
+     * @invariant According to observable contract (https://reactivex.io/documentation/contract.html) emissions from any observable should be serialized, so, resulting observable uses lock-free queue to satisfy this requirement: thread emitting while nobody else emits passes emission to observer directly, otherwise emission is queued and passed to observer by thread emitting right now. As a result, producers never block each other, but emission could be passed to observer from another thread after return of producer's `on_next`.
      *
      * @attention During on subscribe operator takes ownership over rpp::schedulers::current_thread to allow mixing of underlying emissions
      *
@@ -213,10 +580,12 @@ namespace rpp::operators
          }
      *
      * @details Actually it subscribes on each observable from emissions. Resulting observables completes when ALL observables completes
+     * In case of backpressured observer each inner observable is requested for one value at a time and no more inner observables than demand of observer are requested simultaneously, so, values are never buffered.
      *
      * @par Performance notes:
      * - 2 heap allocation (1 for state, 1 to convert observer to dynamic_observer)
-     * - Acquiring mutex during all observer's calls
+     * - Emission without contention costs a few atomic operations without acquiring of any mutex
+     * - Emission during another emission costs 1 heap allocation and a few atomic operations; queued emissions are passed to observer in batches
      *
      * @note `#include <rpp/operators/merge.hpp>`
      *
@@ -231,10 +600,46 @@ namespace rpp::operators
         return details::merge_t{};
     }
 
+    /**
+     * @brief Converts observable of observables of items into observable of items via merging emissions, but subscribes on no more than `max_concurrent` observables at the same time.
+     *
+     * @marble merge_max_concurrent
+         {
+             source observable                :
+             {
+                 +1---2|
+                 .+3|
+                 ..+4|
+             }
+             operator "merge(2)" : +13-42|
+         }
+     *
+     * @details Observables emitted while `max_concurrent` observables are active are kept in queue and subscribed one by one as soon as any active observable completes. Upstream is treated as backpressured observable: it is requested for `max_concurrent` observables and then for one more observable per completed one, so, backpressure-aware upstream (like `rpp::source::from_iterable`) emits observables only when they could be subscribed and queue stays empty.
+     * Resulting observable completes when upstream and ALL observables complete.
+     *
+     * @par Performance notes:
+     * - 3 heap allocations (1 for state, 1 for queue of observables, 1 to convert observer to dynamic_observer)
+     * - Acquiring mutex to queue each observable and to subscribe on next observable
+     * - Emissions are serialized same as in `rpp::operators::merge()`
+     *
+     * @param max_concurrent maximum amount of observables subscribed at the same time. `0` is treated as `1`.
+     * @note `#include <rpp/operators/merge.hpp>`
+     *
+     * @par Example:
+     * @snippet merge.cpp merge_max_concurrent
+     *
+     * @ingroup combining_operators
+     * @see https://reactivex.io/documentation/operators/merge.html
+     */
+    inline auto merge(size_t max_concurrent)
+    {
+        return details::merge_max_concurrent_t{max_concurrent};
+    }
+
     /**
      * @brief Combines submissions from current observable with other observables into one
      *
-     * @warning According to observable contract (https://reactivex.io/documentation/contract.html) emissions from any observable should be serialized, so, resulting observable uses mutex to satisfy this requirement
+     * @warning According to observable contract (https://reactivex.io/documentation/contract.html) emissions from any observable should be serialized, so, resulting observable uses lock-free queue to satisfy this requirement: emissions happening while another emission is in progress are queued and passed to observer by thread emitting right now, so, producers never block each other.
      *
      * @warning During on subscribe operator takes ownership over rpp::schedulers::current_thread to allow mixing of underlying emissions
      *
@@ -249,7 +654,8 @@ namespace rpp::operators
      *
      * @par Performance notes:
      * - 2 heap allocation (1 for state, 1 to convert observer to dynamic_observer)
-     * - Acquiring mutex during all observer's calls
+     * - Emission without contention costs a few atomic operations without acquiring of any mutex
+     * - Emission during another emission costs 1 heap allocation and a few atomic operations; queued emissions are passed to observer in batches
      *
      * @param observables are observables whose emissions would be merged with current observable
      * @note `#include <rpp/operators/merge.hpp>`
@@ -12,10 +12,274 @@
 
 #include <rpp/operators/fwd.hpp>
 
+#include <rpp/defs.hpp>
+#include <rpp/disposables/composite_disposable.hpp>
 #include <rpp/operators/delay.hpp>
+#include <rpp/operators/details/bounded_queue.hpp>
+#include <rpp/operators/details/spsc_queue.hpp>
+#include <rpp/operators/details/strategy.hpp>
+#include <rpp/schedulers/prioritized.hpp>
+#include <rpp/utils/exceptions.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <variant>
+
+namespace rpp::operators::details
+{
+    template<rpp::constraint::observer Observer, typename Worker, rpp::details::disposables::constraint::disposables_container Container>
+    struct observe_on_disposable final : public rpp::composite_disposable_impl<Container>
+    {
+        using T                 = rpp::utils::extract_observer_type_t<Observer>;
+        using emission          = std::variant<T, std::exception_ptr, rpp::utils::none>;
+        using unbounded_queue_t = spsc_queue<emission>;
+        using bounded_queue_t   = bounded_queue<emission>;
+
+        observe_on_disposable(Observer&& in_observer, Worker&& in_worker, const observe_on_options& in_options)
+            : observer(std::move(in_observer))
+            , worker{std::move(in_worker)}
+            , options{in_options}
+        {
+            if (options.capacity == 0 && options.overflow != overflow_policy::latest_only)
+                queue.template emplace<unbounded_queue_t>();
+            else
+                queue.template emplace<bounded_queue_t>(options.capacity, options.overflow, options.counters.get());
+        }
+
+        RPP_NO_UNIQUE_ADDRESS Observer observer;
+        RPP_NO_UNIQUE_ADDRESS Worker   worker;
+        const observe_on_options       options;
+
+        std::variant<std::monostate, unbounded_queue_t, bounded_queue_t> queue{};
+        // set before pushing of error: values not emitted yet are dropped
+        std::atomic<bool> has_error{};
+        // backpressured upstream is requested for values as soon as they are emitted from bounded queue
+        rpp::utils::value_with_mutex<rpp::disposable_wrapper> upstream{};
+
+    private:
+        void composite_dispose_impl(interface_disposable::Mode) noexcept override
+        {
+            // producer could wait for free space which never appears after disposing
+            if (auto* bounded = std::get_if<bounded_queue_t>(&queue))
+                bounded->close();
+        }
+    };
+
+    template<rpp::constraint::observer Observer, typename Worker, rpp::details::disposables::constraint::disposables_container Container>
+    struct observe_on_disposable_wrapper
+    {
+        std::shared_ptr<observe_on_disposable<Observer, Worker, Container>> disposable{};
+
+        bool is_disposed() const { return disposable->is_disposed(); }
+
+        void on_error(const std::exception_ptr& err) const { disposable->observer.on_error(err); }
+    };
+
+    template<rpp::constraint::observer Observer, typename Worker, rpp::details::disposables::constraint::disposables_container Container>
+    struct observe_on_observer_strategy
+    {
+        using disposable_t      = observe_on_disposable<Observer, Worker, Container>;
+        using unbounded_queue_t = typename disposable_t::unbounded_queue_t;
+        using bounded_queue_t   = typename disposable_t::bounded_queue_t;
+
+        static constexpr auto         preferred_disposables_mode = rpp::details::observers::disposables_mode::Boolean;
+        static constexpr bool         backpressured              = true;
+        std::shared_ptr<disposable_t> disposable{};
+
+        void set_upstream(const rpp::disposable_wrapper& d) const
+        {
+            disposable->add(d);
+
+            if (auto* queue = std::get_if<bounded_queue_t>(&disposable->queue))
+            {
+                *rpp::utils::pointer_under_lock<rpp::disposable_wrapper>{disposable->upstream} = d;
+                d.request(queue->capacity());
+            }
+            else
+            {
+                d.request(unbounded_demand);
+            }
+        }
+
+        bool is_disposed() const
+        {
+            return disposable->is_disposed();
+        }
+
+        template<typename T>
+        void on_next(T&& v) const
+        {
+            // upstream is serialized, so, it is single producer: only emission into empty queue has to schedule draining
+            if (auto* queue = std::get_if<unbounded_queue_t>(&disposable->queue))
+            {
+                if (queue->push(std::forward<T>(v)))
+                    schedule_drain();
+                return;
+            }
+
+            switch (std::get<bounded_queue_t>(disposable->queue).push(std::forward<T>(v)))
+            {
+            case bounded_queue_t::push_result::queued:
+                return;
+            case bounded_queue_t::push_result::drain_required:
+                schedule_drain();
+                return;
+            case bounded_queue_t::push_result::overflow:
+                on_error(std::make_exception_ptr(rpp::utils::buffer_overflow{"observe_on buffer overflow"}));
+                return;
+            }
+        }
+
+        void on_error(const std::exception_ptr& err) const noexcept
+        {
+            disposable->has_error.store(true, std::memory_order::relaxed);
+            push_terminal(err);
+            disposable->clear();
+        }
+
+        void on_completed() const noexcept
+        {
+            push_terminal(rpp::utils::none{});
+            disposable->clear();
+        }
+
+    private:
+        template<typename TT>
+        void push_terminal(TT&& value) const
+        {
+            bool drain_required{};
+            if (auto* queue = std::get_if<unbounded_queue_t>(&disposable->queue))
+                drain_required = queue->push(std::forward<TT>(value));
+            else
+                drain_required = std::get<bounded_queue_t>(disposable->queue).push_terminal(std::forward<TT>(value), rpp::constraint::decayed_same_as<TT, std::exception_ptr>);
+
+            if (drain_required)
+                schedule_drain();
+        }
+
+        void schedule_drain() const
+        {
+            disposable->worker.schedule(
+                [](const observe_on_disposable_wrapper<Observer, Worker, Container>& wrapper) { return drain_queue(wrapper.disposable); },
+                observe_on_disposable_wrapper<Observer, Worker, Container>{disposable});
+        }
+
+        static schedulers::optional_delay_from_now drain_queue(const std::shared_ptr<disposable_t>& disposable)
+        {
+            size_t     emitted{};
+            const auto emit = [&](typename disposable_t::emission&& item) {
+                std::visit(rpp::utils::overloaded{[&](rpp::utils::extract_observer_type_t<Observer>&& v) {
+                                                      ++emitted;
+                                                      if (!disposable->has_error.load(std::memory_order::relaxed))
+                                                          disposable->observer.on_next(std::move(v));
+                                                  },
+                                                  [&](const std::exception_ptr& err) { disposable->observer.on_error(err); },
+                                                  [&](rpp::utils::none) {
+                                                      disposable->observer.on_completed();
+                                                  }},
+                           std::move(item));
+            };
+
+            const size_t max_batch_size = std::max(size_t{1}, disposable->options.max_batch_size);
+            const bool   has_more       = std::holds_alternative<unbounded_queue_t>(disposable->queue)
+                                            ? std::get<unbounded_queue_t>(disposable->queue).drain(emit, max_batch_size)
+                                            : std::get<bounded_queue_t>(disposable->queue).drain(emit, max_batch_size);
+
+            // requested only after releasing of draining: upstream could emit synchronously
+            if (emitted != 0 && std::holds_alternative<bounded_queue_t>(disposable->queue))
+            {
+                const auto upstream = *rpp::utils::pointer_under_lock<rpp::disposable_wrapper>{disposable->upstream};
+                upstream.request(emitted);
+            }
+
+            // yield worker to other schedulables before the next batch
+            if (has_more)
+                return schedulers::optional_delay_from_now{schedulers::delay_from_now{}};
+            return std::nullopt;
+        }
+    };
+
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    struct observe_on_t
+    {
+        template<rpp::constraint::decayed_type T>
+        struct operator_traits
+        {
+            using result_type = T;
+        };
+
+        template<rpp::details::observables::constraint::disposables_strategy Prev>
+        using updated_optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<1>;
+
+        observe_on_options              options;
+        RPP_NO_UNIQUE_ADDRESS Scheduler scheduler;
+
+        template<rpp::constraint::decayed_type Type, rpp::details::observables::constraint::disposables_strategy DisposableStrategy, rpp::constraint::observer Observer>
+        auto lift_with_disposables_strategy(Observer&& observer) const
+        {
+            using worker_t  = rpp::schedulers::utils::get_worker_t<Scheduler>;
+            // observer of upstream is backpressured: observables aware of backpressure pass upstream disposable to it
+            using container = typename DisposableStrategy::template add<1>::disposables_container;
+
+            const auto disposable = disposable_wrapper_impl<observe_on_disposable<std::decay_t<Observer>, worker_t, container>>::make(std::forward<Observer>(observer), scheduler.create_worker(), options);
+            auto       ptr        = disposable.lock();
+            ptr->observer.set_upstream(disposable.as_weak());
+            return rpp::observer<Type, observe_on_observer_strategy<std::decay_t<Observer>, worker_t, container>>{std::move(ptr)};
+        }
+    };
+} // namespace rpp::operators::details
 
 namespace rpp::operators
 {
+    /**
+     * @brief Specify the Scheduler on which an observer will observe this Observable
+     * @details The observe_on operator modifies its source Observable by emitting all emissions via provided scheduler, so, all emissions/callbacks happens via scheduler.
+     * Emissions are passed to scheduler via lock-free single-producer queue without timestamping: only emission into empty queue schedules draining, so, steady stream costs one atomic increment per emission. Draining passes emissions to observer in batches of up to `options.max_batch_size` emissions and re-schedules itself after each batch to not starve other schedulables of the same worker.
+     * In case of obtaining `on_error` this operator drops all not yet emitted emissions and forwards error as soon as possible.
+     *
+     * By default buffer of not emitted values is unbounded, so, slow observer makes memory grow without limit. Set `options.capacity` to bound it: `options.overflow` selects what happens with value which doesn't fit (see `rpp::operators::overflow_policy`), amount of dropped values is counted in `options.counters`. Bounded buffer is fixed ring guarded by mutex.
+     * @warning `overflow_policy::block` blocks thread of upstream till observer consumes values, so, it deadlocks in case of the same thread is expected to drain them (e.g. `run_loop` dispatched by the same thread).
+     *
+     * Observer of upstream is backpressured: bounded buffer requests `options.capacity` values from upstream and requests one more value per each emitted one, so, upstream aware of backpressure (e.g. `rpp::source::from_iterable`) never overflows buffer and overflow policy is applied only to upstreams not aware of it. Unbounded buffer requests unbounded demand.
+     *
+     * @param scheduler provides the threading model for emissions.
+     * @param options tuning of draining of emissions, see `rpp::operators::observe_on_options`.
+     * @note `#include <rpp/operators/observe_on.hpp>`
+     *
+     * @par Examples
+     * @snippet observe_on.cpp observe_on_without_delay
+     * @snippet observe_on.cpp observe_on_bounded
+     *
+     * @ingroup utility_operators
+     * @see https://reactivex.io/documentation/operators/observeon.html
+     */
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto observe_on(Scheduler&& scheduler, observe_on_options options)
+    {
+        return details::observe_on_t<std::decay_t<Scheduler>>{options, std::forward<Scheduler>(scheduler)};
+    }
+
+    /**
+     * @brief Same as `observe_on(scheduler, options)`, but all emissions are scheduled with provided priority.
+     * @details See `rpp::schedulers::prioritized` for details.
+     *
+     * @param scheduler provides the threading model for emissions.
+     * @param priority priority of emissions in queue of scheduler.
+     * @param options tuning of draining of emissions, see `rpp::operators::observe_on_options`.
+     * @note `#include <rpp/operators/observe_on.hpp>`
+     *
+     * @par Examples
+     * @snippet prioritized.cpp prioritized
+     *
+     * @ingroup utility_operators
+     */
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto observe_on(Scheduler&& scheduler, rpp::schedulers::priority priority, observe_on_options options)
+    {
+        using prioritized = rpp::schedulers::prioritized<std::decay_t<Scheduler>>;
+        return details::observe_on_t<prioritized>{options, prioritized{std::forward<Scheduler>(scheduler), priority}};
+    }
+
     /**
      * @brief Specify the Scheduler on which an observer will observe this Observable
      * @details The observe_on operator modifies its source Observable by emitting all emissions via provided scheduler, so, all emissions/callbacks happens via scheduler.
@@ -43,4 +307,25 @@ namespace rpp::operators
     {
         return details::delay_t<std::decay_t<Scheduler>, true>{delay_duration, std::forward<Scheduler>(scheduler)};
     }
+
+    /**
+     * @brief Same as `observe_on(scheduler, delay_duration)`, but all emissions are scheduled with provided priority.
+     * @details Queue-based schedulers execute ready emissions of higher priority before ready emissions of lower priority scheduled to the same worker (e.g. shared `run_loop` or `thread_pool`), so, latency-sensitive stream can bypass bulk streams. See `rpp::schedulers::prioritized` for details.
+     *
+     * @param scheduler provides the threading model for delay.
+     * @param priority priority of emissions in queue of scheduler.
+     * @param delay_duration is the delay duration for emitting items. Delay duration should be able to cast to rpp::schedulers::duration.
+     * @note `#include <rpp/operators/observe_on.hpp>`
+     *
+     * @par Examples
+     * @snippet prioritized.cpp prioritized
+     *
+     * @ingroup utility_operators
+     */
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto observe_on(Scheduler&& scheduler, rpp::schedulers::priority priority, rpp::schedulers::duration delay_duration)
+    {
+        using prioritized = rpp::schedulers::prioritized<std::decay_t<Scheduler>>;
+        return details::delay_t<prioritized, true>{delay_duration, prioritized{std::forward<Scheduler>(scheduler), priority}};
+    }
 } // namespace rpp::operators
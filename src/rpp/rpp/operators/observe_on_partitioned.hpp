@@ -0,0 +1,69 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/operators/fwd.hpp>
+
+#include <rpp/defs.hpp>
+#include <rpp/observables/parallel_observable.hpp>
+
+#include <algorithm>
+
+namespace rpp::operators::details
+{
+    template<rpp::constraint::decayed_type KeySelector, rpp::schedulers::constraint::scheduler Scheduler>
+    struct observe_on_partitioned_t
+    {
+        RPP_NO_UNIQUE_ADDRESS KeySelector key_selector;
+        RPP_NO_UNIQUE_ADDRESS Scheduler   scheduler;
+        size_t                            partitions;
+
+        template<rpp::constraint::observable TObservable>
+        auto operator()(TObservable&& observable) const
+        {
+            using distribution = rpp::details::parallel_by_key<KeySelector>;
+            using strategy     = rpp::details::parallel_strategy<std::decay_t<TObservable>, Scheduler, distribution, std::identity, false>;
+            return rpp::parallel_observable<std::decay_t<TObservable>, Scheduler, distribution>{strategy{std::forward<TObservable>(observable), partitions, scheduler, distribution{key_selector}, {}}};
+        }
+    };
+} // namespace rpp::operators::details
+
+namespace rpp::operators
+{
+    /**
+     * @brief Pass values to fixed set of `partitions` workers of `scheduler` selected by hash of key of value: values with the same key are processed by the same worker in order of original observable, values with different keys are processed in parallel.
+     * @details Returns `rpp::parallel_observable` where each partition is a "rail": operators applied to it via `operator|` are applied to each partition independently, so, processing of different keys runs on multiple threads while processing of each key stays ordered. Merge partitions back via `rpp::operators::sequential()` or `rpp::operators::ordered_sequential()`.
+     *
+     * @details Actually it is `group_by` + `observe_on` for each group without subject and worker per key: partition of value is `std::hash` of key mixed via fibonacci hashing (the same as `rpp::schedulers::shard_scheduler`) to spread poor hashes between `partitions`, each partition has its own lock-free queue drained by its worker in batches (the same as `rpp::operators::observe_on`), so, nothing is allocated per key.
+     *
+     * @par Performance notes:
+     * - 1 heap allocation for state and 1 heap allocation per partition, values are queued per partition without allocation per value
+     * - Key selector and `std::hash` of key are invoked once per value
+     * - Acquiring mutex for each value emitted by partitions when they are merged back
+     *
+     * @param key_selector function which returns key of value. Key has to be hashable via `std::hash`.
+     * @param scheduler provides workers of partitions. Expected to be `rpp::schedulers::thread_pool` or other scheduler with workers executing schedulables one by one: each partition creates its own worker.
+     * @param partitions amount of partitions. `0` is treated as `1`.
+     * @warning Operators of partitions are expected to be synchronous (have to emit during processing of value or completion): partition is considered finished after processing of completion of original observable.
+     * @note `#include <rpp/operators/observe_on_partitioned.hpp>`
+     *
+     * @par Example:
+     * @snippet observe_on_partitioned.cpp observe_on_partitioned
+     *
+     * @ingroup utility_operators
+     */
+    template<typename KeySelector, rpp::schedulers::constraint::scheduler Scheduler>
+        requires (!utils::is_not_template_callable<KeySelector> || !std::same_as<void, std::invoke_result_t<KeySelector, rpp::utils::convertible_to_any>>)
+    auto observe_on_partitioned(KeySelector&& key_selector, Scheduler&& scheduler, size_t partitions)
+    {
+        return details::observe_on_partitioned_t<std::decay_t<KeySelector>, std::decay_t<Scheduler>>{std::forward<KeySelector>(key_selector), std::forward<Scheduler>(scheduler), std::max(size_t{1}, partitions)};
+    }
+} // namespace rpp::operators
@@ -0,0 +1,116 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/operators/fwd.hpp>
+
+#include <rpp/defs.hpp>
+#include <rpp/observables/parallel_observable.hpp>
+
+#include <algorithm>
+
+namespace rpp::operators::details
+{
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    struct parallel_t
+    {
+        size_t                          rails;
+        RPP_NO_UNIQUE_ADDRESS Scheduler scheduler;
+
+        template<rpp::constraint::observable TObservable>
+        auto operator()(TObservable&& observable) const
+        {
+            using strategy = rpp::details::parallel_strategy<std::decay_t<TObservable>, Scheduler, rpp::details::parallel_round_robin, std::identity, false>;
+            return rpp::parallel_observable<std::decay_t<TObservable>, Scheduler>{strategy{std::forward<TObservable>(observable), rails, scheduler, {}, {}}};
+        }
+    };
+
+    template<bool Ordered>
+    struct sequential_t
+    {
+        template<rpp::constraint::observable OriginalObservable, rpp::schedulers::constraint::scheduler Scheduler, rpp::constraint::decayed_type Distribution, rpp::constraint::decayed_type RailFn>
+        auto operator()(const rpp::parallel_observable<OriginalObservable, Scheduler, Distribution, RailFn>& observable) const
+        {
+            if constexpr (Ordered)
+                return observable.ordered_sequential();
+            else
+                return observable.sequential();
+        }
+    };
+} // namespace rpp::operators::details
+
+namespace rpp::operators
+{
+    /**
+     * @brief Split observable into `rails` "rails" processed in parallel: values are passed to rails in round-robin order and each rail emits its values via its own worker of `scheduler`.
+     * @details Returns `rpp::parallel_observable`: operators applied to it via `operator|` are applied to each rail independently, so, CPU-heavy `map`/`filter` of one stream are executed by multiple threads at the same time. Merge rails back via `rpp::operators::sequential()` (values in order of production) or `rpp::operators::ordered_sequential()` (values in order of original observable).
+     *
+     * @marble parallel
+         {
+             source observable                                       : +-1-2-3-4-|
+             operator "parallel(2) | map: x=>x*10 | sequential"      : +--20-10-40-30-|
+         }
+     *
+     * @details Each rail has its own lock-free queue drained by its worker in batches, the same as `rpp::operators::observe_on`. Values of rails are merged under mutex, but emitted to observer outside of it.
+     *
+     * @par Performance notes:
+     * - 1 heap allocation for state and 1 heap allocation per rail, values are queued per rail without allocation per value
+     * - Acquiring mutex for each value emitted by rails. `ordered_sequential()` additionally acquires mutex for each value of original observable
+     * - Operators of rails are type-erased at the input of rail (1 virtual call per value)
+     *
+     * @param rails amount of rails. `0` is treated as `1`.
+     * @param scheduler provides workers of rails. Expected to be `rpp::schedulers::thread_pool` or other scheduler with workers executing schedulables one by one: each rail creates its own worker.
+     * @warning Operators of rails are expected to be synchronous (have to emit during processing of value or completion): rail is considered finished after processing of completion of original observable.
+     * @note `#include <rpp/operators/parallel.hpp>`
+     *
+     * @par Example:
+     * @snippet parallel.cpp parallel
+     *
+     * @ingroup utility_operators
+     */
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    auto parallel(size_t rails, Scheduler&& scheduler)
+    {
+        return details::parallel_t<std::decay_t<Scheduler>>{std::max(size_t{1}, rails), std::forward<Scheduler>(scheduler)};
+    }
+
+    /**
+     * @brief Merge rails of `rpp::parallel_observable` back to common observable. Values are emitted as soon as rails produce them, so, order of original observable is not preserved.
+     *
+     * @note `#include <rpp/operators/parallel.hpp>`
+     *
+     * @par Example:
+     * @snippet parallel.cpp parallel
+     *
+     * @ingroup utility_operators
+     */
+    inline auto sequential()
+    {
+        return details::sequential_t<false>{};
+    }
+
+    /**
+     * @brief Merge rails of `rpp::parallel_observable` back to common observable preserving order of original observable: values produced by rails for some value are emitted only after values produced for all previous values.
+     * @details Values produced ahead of order are buffered till all previous values are processed by their rails.
+     * @warning Order is tracked by value processed by rail while operators of rail emit, so, operators of rails have to emit synchronously during processing of value. Values emitted by rails on completion (e.g. `reduce`) are emitted after all other values.
+     *
+     * @note `#include <rpp/operators/parallel.hpp>`
+     *
+     * @par Example:
+     * @snippet parallel.cpp ordered_sequential
+     *
+     * @ingroup utility_operators
+     */
+    inline auto ordered_sequential()
+    {
+        return details::sequential_t<true>{};
+    }
+} // namespace rpp::operators
@@ -19,7 +19,14 @@
 
 #include <rpp/schedulers/computational.hpp>
 #include <rpp/schedulers/current_thread.hpp>
+#include <rpp/schedulers/elastic.hpp>
+#include <rpp/schedulers/epoll_loop.hpp>
 #include <rpp/schedulers/immediate.hpp>
+#include <rpp/schedulers/metrics.hpp>
 #include <rpp/schedulers/new_thread.hpp>
+#include <rpp/schedulers/prioritized.hpp>
 #include <rpp/schedulers/run_loop.hpp>
+#include <rpp/schedulers/shard_scheduler.hpp>
 #include <rpp/schedulers/thread_pool.hpp>
+#include <rpp/schedulers/virtual_time.hpp>
+#include <rpp/schedulers/watchdog.hpp>
@@ -19,6 +19,7 @@ namespace rpp::schedulers
     /**
      * @brief Scheduler owning static thread pool of workers and using "some" thread from this pool on `create_worker` call
      * @warning Actually it is static variable to `thread_pool` scheduler
+     * @note Amount of threads equals to amount of cpus available for the process (respecting cpu affinity mask and cgroup CPU quota)
      * @note Expected to pass to this scheduler intensive CPU bound tasks with relatevely small duration of execution (to be sure that no any thread with tasks from some other operators would be blocked on that task)
      *
      * @par Examples
@@ -35,4 +36,23 @@ namespace rpp::schedulers
             return s_tp.create_worker();
         }
     };
+
+    /**
+     * @brief Same as `computational`, but static thread pool uses `thread_pool::mode::work_stealing`: idle threads steal ready workers from busy ones instead of pinning each worker to one thread.
+     * @note Schedulables of the same worker are still executed serially in scheduling order.
+     *
+     * @par Examples
+     * @snippet thread_pool.cpp work_stealing_computational
+     *
+     * @ingroup schedulers
+     */
+    class work_stealing_computational final
+    {
+    public:
+        static auto create_worker()
+        {
+            static thread_pool s_tp{details::get_available_concurrency(), thread_pool::mode::work_stealing};
+            return s_tp.create_worker();
+        }
+    };
 } // namespace rpp::schedulers
@@ -15,6 +15,7 @@
 #include <rpp/schedulers/details/queue.hpp>
 #include <rpp/schedulers/details/utils.hpp>
 #include <rpp/schedulers/details/worker.hpp>
+#include <rpp/schedulers/metrics.hpp>
 #include <rpp/utils/functors.hpp>
 
 namespace rpp::schedulers
@@ -94,6 +95,21 @@ namespace rpp::schedulers
             return s_queue;
         }
 
+    private:
+        // metrics of queue owned by current_thread itself (not by new_thread/thread_pool)
+        static const details::metrics_hook& get_metrics()
+        {
+            thread_local const details::metrics_hook s_metrics{"current_thread"};
+            return s_metrics;
+        }
+
+        static void own_queue(details::schedulables_queue<worker_strategy>& queue)
+        {
+            queue.set_metrics(get_metrics());
+            get_queue() = &queue;
+        }
+
+    public:
         struct is_queue_is_empty
         {
             const details::schedulables_queue<worker_strategy>& queue;
@@ -104,13 +120,17 @@ namespace rpp::schedulers
 
         static void drain_queue() noexcept
         {
+            const details::now_cache::scope now_scope{};
             while (get_queue() && !get_queue()->is_empty())
             {
+                details::now_cache::tick();
+
                 auto top = get_queue()->pop();
                 if (top->is_disposed())
                     continue;
 
                 details::sleep_until(top->get_timepoint());
+                const auto execution_metrics = get_metrics().on_execution(*top);
 
                 while (true)
                 {
@@ -122,7 +142,7 @@ namespace rpp::schedulers
                             {
                                 if (const auto d = std::get_if<delay_from_now>(&res->get()))
                                 {
-                                    std::this_thread::sleep_for(d->value);
+                                    details::sleep_for(d->value);
                                 }
                                 else
                                 {
@@ -153,7 +173,7 @@ namespace rpp::schedulers
                 if (!get_queue())
                 {
                     details::schedulables_queue<worker_strategy> queue{};
-                    get_queue() = &queue;
+                    own_queue(queue);
 
                     const auto timepoint = details::immediate_scheduling_while_condition<worker_strategy>(duration, is_queue_is_empty{queue}, fn, handler, args...);
                     if (!timepoint || handler.is_disposed())
@@ -193,7 +213,7 @@ namespace rpp::schedulers
                 : m_clear_on_destruction{!get_queue()}
             {
                 if (m_clear_on_destruction)
-                    get_queue() = &m_queue;
+                    own_queue(m_queue);
             }
             ~own_queue_guard()
             {
@@ -0,0 +1,238 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define RPP_SCHEDULERS_HAS_TSC 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#else
+    #define RPP_SCHEDULERS_HAS_TSC 0
+#endif
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Source of "now" based on `clock_type` (std::chrono::steady_clock). Default one.
+     */
+    struct steady_clock_source
+    {
+        static time_point now() { return clock_type::now(); }
+    };
+
+    /**
+     * @brief Source of "now" based on CLOCK_MONOTONIC_COARSE: several times cheaper than steady_clock, but resolution is about 1-4 milliseconds (one kernel tick).
+     * @details Returned value is the last kernel tick, so, it lags behind actual time up to one tick and is never later than actual time. As a result, schedulable is never executed before its time_point is reached, but delays are measured from lagging "now": actual delay can be shorter than requested up to one tick (and schedulable can be executed up to one tick later than its time_point).
+     * @note Falls back to `steady_clock_source` on non-linux platforms.
+     */
+    struct coarse_clock_source
+    {
+        static time_point now()
+        {
+#if defined(__linux__)
+            // steady_clock is CLOCK_MONOTONIC, so, both clocks have the same epoch
+            timespec ts{};
+            ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+            return time_point{to_duration(ts)};
+#else
+            return steady_clock_source::now();
+#endif
+        }
+
+#if defined(__linux__)
+    private:
+        static duration to_duration(const timespec& ts)
+        {
+            return std::chrono::duration_cast<duration>(std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec});
+        }
+#endif
+    };
+
+    /**
+     * @brief Source of "now" based on cpu's time-stamp counter calibrated against steady_clock.
+     * @details Each thread anchors counter to steady_clock and extrapolates time from the counter for `s_reanchor_interval`, after that anchor is refreshed and rate of counter is re-calibrated from the distance between anchors. As a result, steady_clock is read once per interval instead of each call, while error of extrapolation is bounded by few microseconds. Returned values are monotonic inside each thread.
+     * @warning Expects invariant and synchronized between cores TSC (any modern x86 cpu). Falls back to `steady_clock_source` on non-x86 platforms.
+     */
+    class tsc_clock_source
+    {
+#if RPP_SCHEDULERS_HAS_TSC
+        static constexpr std::chrono::nanoseconds s_reanchor_interval = std::chrono::milliseconds{1};
+
+        struct anchor
+        {
+            uint64_t   tsc{};
+            time_point time{};
+            double     ns_per_tick{};
+            uint64_t   max_ticks{};
+            time_point last{};
+        };
+
+        static uint64_t read_tsc() { return __rdtsc(); }
+
+        static double calibrate()
+        {
+            static const double s_ns_per_tick = [] {
+                const auto start_time = clock_type::now();
+                const auto start_tsc  = read_tsc();
+                while (clock_type::now() - start_time < s_reanchor_interval)
+                {
+                }
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start_time).count();
+                return static_cast<double>(elapsed) / static_cast<double>(std::max(uint64_t{1}, read_tsc() - start_tsc));
+            }();
+            return s_ns_per_tick;
+        }
+
+        static void reanchor(anchor& a)
+        {
+            const auto tsc  = read_tsc();
+            const auto time = clock_type::now();
+            if (a.max_ticks != 0 && tsc > a.tsc && time > a.time)
+                a.ns_per_tick = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(time - a.time).count()) / static_cast<double>(tsc - a.tsc);
+            else
+                a.ns_per_tick = calibrate();
+
+            a.tsc       = tsc;
+            a.time      = time;
+            a.max_ticks = std::max(uint64_t{1}, static_cast<uint64_t>(static_cast<double>(s_reanchor_interval.count()) / a.ns_per_tick));
+        }
+#endif
+
+    public:
+        static time_point now()
+        {
+#if RPP_SCHEDULERS_HAS_TSC
+            thread_local anchor s_anchor{};
+
+            // counter can be slightly behind in case of migration to another core: unsigned overflow forces re-anchoring too
+            const auto ticks = read_tsc() - s_anchor.tsc;
+            if (s_anchor.max_ticks == 0 || ticks >= s_anchor.max_ticks)
+            {
+                reanchor(s_anchor);
+                return s_anchor.last = std::max(s_anchor.last, s_anchor.time);
+            }
+
+            const auto elapsed = std::chrono::nanoseconds{static_cast<int64_t>(static_cast<double>(ticks) * s_anchor.ns_per_tick)};
+            return s_anchor.last = std::max(s_anchor.last, s_anchor.time + std::chrono::duration_cast<time_point::duration>(elapsed));
+#else
+            return steady_clock_source::now();
+#endif
+        }
+    };
+
+    // clock used by schedulers for `now()` can be selected via `RPP_SCHEDULERS_USE_COARSE_CLOCK=1` or `RPP_SCHEDULERS_USE_TSC_CLOCK=1`
+#if defined(RPP_SCHEDULERS_USE_COARSE_CLOCK) && RPP_SCHEDULERS_USE_COARSE_CLOCK
+    using clock_source = coarse_clock_source;
+#elif defined(RPP_SCHEDULERS_USE_TSC_CLOCK) && RPP_SCHEDULERS_USE_TSC_CLOCK
+    using clock_source = tsc_clock_source;
+#else
+    using clock_source = steady_clock_source;
+#endif
+
+    /**
+     * @brief Thread-local cache of "now" used by schedulers during processing of batch of schedulables (same as "loop time" of event loops)
+     * @details Enabled only if `RPP_SCHEDULERS_CACHE_NOW=1` is defined. In this case `details::now()` called inside of `scope` returns cached value and actual clock is read only once per `s_max_uses` calls of `details::now()` and processed schedulables (see `tick`). Each usage of cached value is checked against `coarse_clock_source` (much cheaper than actual clock), so, cached value is refreshed as soon as it is older than `s_max_staleness` plus resolution of coarse clock (one kernel tick) even in case of long-running schedulable. Cache is invalidated after any waiting/sleeping of scheduler's thread and at the end of batch. Cached value is never later than actual time, so, schedulables are never executed earlier than requested.
+     */
+    class now_cache
+    {
+    public:
+        static constexpr size_t                   s_max_uses      = 32;
+        static constexpr std::chrono::nanoseconds s_max_staleness = std::chrono::milliseconds{1};
+
+        /**
+         * @brief RAII scope of processing of batch of schedulables by scheduler's thread. "now" is cached only inside such an scope.
+         */
+        class scope
+        {
+        public:
+#if defined(RPP_SCHEDULERS_CACHE_NOW) && RPP_SCHEDULERS_CACHE_NOW
+            scope() { ++get_state().depth; }
+
+            ~scope() noexcept
+            {
+                if (--get_state().depth == 0)
+                    invalidate();
+            }
+#else
+            scope() = default;
+#endif
+            scope(const scope&) = delete;
+            scope(scope&&)      = delete;
+        };
+
+        /**
+         * @brief Mark that one more schedulable is going to be processed inside current scope
+         */
+        static void tick()
+        {
+#if defined(RPP_SCHEDULERS_CACHE_NOW) && RPP_SCHEDULERS_CACHE_NOW
+            ++get_state().uses;
+#endif
+        }
+
+        static void invalidate()
+        {
+#if defined(RPP_SCHEDULERS_CACHE_NOW) && RPP_SCHEDULERS_CACHE_NOW
+            get_state().uses = s_max_uses;
+#endif
+        }
+
+        /**
+         * @brief Check if cached "now" can be used. In case of false, caller is expected to refresh cached value.
+         */
+        static bool try_use()
+        {
+#if defined(RPP_SCHEDULERS_CACHE_NOW) && RPP_SCHEDULERS_CACHE_NOW
+            auto& s = get_state();
+            if (s.depth == 0)
+                return false;
+
+            const auto coarse_now = coarse_clock_source::now();
+            if (s.uses < s_max_uses && coarse_now - s.refreshed_at < s_max_staleness)
+            {
+                ++s.uses;
+                return true;
+            }
+            s.uses         = 0;
+            s.refreshed_at = coarse_now;
+#endif
+            return false;
+        }
+
+#if defined(RPP_SCHEDULERS_CACHE_NOW) && RPP_SCHEDULERS_CACHE_NOW
+    private:
+        struct state
+        {
+            size_t     depth{};
+            size_t     uses{s_max_uses};
+            time_point refreshed_at{};
+        };
+
+        static state& get_state()
+        {
+            thread_local state s_state{};
+            return s_state;
+        }
+#endif
+    };
+} // namespace rpp::schedulers::details
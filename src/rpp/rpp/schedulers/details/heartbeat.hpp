@@ -0,0 +1,202 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Human-readable name of type `T` obtained at compile-time without RTTI
+     */
+    template<typename T>
+    constexpr std::string_view type_name()
+    {
+#if defined(__clang__) || defined(__GNUC__)
+        // "... type_name() [with T = TYPE; ...]" (gcc) or "... type_name() [T = TYPE]" (clang)
+        constexpr std::string_view function = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix   = "T = ";
+        constexpr auto             begin    = function.find(prefix) + prefix.size();
+        constexpr auto             end      = function.find_first_of(";]", begin);
+        return function.substr(begin, end - begin);
+#elif defined(_MSC_VER)
+        // "... type_name<TYPE>(void)"
+        constexpr std::string_view function = __FUNCSIG__;
+        constexpr std::string_view prefix   = "type_name<";
+        constexpr auto             begin    = function.find(prefix) + prefix.size();
+        constexpr auto             end      = function.rfind(">(void)");
+        return function.substr(begin, end - begin);
+#else
+        return "unknown";
+#endif
+    }
+
+    template<typename T>
+    inline constexpr std::string_view type_name_v = type_name<T>();
+
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+    /**
+     * @brief Heartbeat of thread executing schedulables: updated by the thread itself, checked by `rpp::schedulers::watchdog`.
+     * @details Sequence is odd while schedulable is executed. Description of schedulable is published together with sequence, so, reader validates it via re-reading of sequence (same as seqlock). Writing costs few plain stores to cache line owned by the thread.
+     */
+    class heartbeat
+    {
+    public:
+        struct sample
+        {
+            size_t                  id;
+            std::thread::id         thread;
+            uint64_t                sequence;
+            const char*             scheduler;
+            const std::string_view* schedulable;
+        };
+
+        explicit heartbeat(size_t id)
+            : m_id{id}
+            , m_thread{std::this_thread::get_id()}
+        {
+        }
+
+        void begin(const char* scheduler, const std::string_view* schedulable)
+        {
+            // nested executions (e.g. current_thread's queue drained inside schedulable of another scheduler) belong to the outer one
+            if (m_depth++ != 0)
+                return;
+
+            // description of previous execution has to be "replaced" strictly after its end
+            std::atomic_thread_fence(std::memory_order_release);
+            m_scheduler.store(scheduler, std::memory_order_relaxed);
+            m_schedulable.store(schedulable, std::memory_order_relaxed);
+            m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        void end()
+        {
+            if (--m_depth != 0)
+                return;
+
+            m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /**
+         * @return consistent sample of currently executed schedulable or nullopt if thread is idle right now
+         */
+        std::optional<sample> get_sample() const
+        {
+            const auto sequence    = m_sequence.load(std::memory_order_acquire);
+            const auto scheduler   = m_scheduler.load(std::memory_order_relaxed);
+            const auto schedulable = m_schedulable.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence % 2 == 0 || sequence != m_sequence.load(std::memory_order_relaxed))
+                return std::nullopt;
+            return sample{m_id, m_thread, sequence, scheduler, schedulable};
+        }
+
+    private:
+        const size_t                         m_id;
+        const std::thread::id                m_thread;
+        size_t                               m_depth{};
+        std::atomic<uint64_t>                m_sequence{};
+        std::atomic<const char*>             m_scheduler{};
+        std::atomic<const std::string_view*> m_schedulable{};
+    };
+
+    /**
+     * @brief Global list of heartbeats of alive threads executing schedulables
+     */
+    class heartbeat_registry
+    {
+    public:
+        static heartbeat_registry& instance()
+        {
+            static heartbeat_registry s_registry{};
+            return s_registry;
+        }
+
+        static heartbeat& get_current()
+        {
+            thread_local const std::shared_ptr<heartbeat> s_heartbeat = instance().create();
+            return *s_heartbeat;
+        }
+
+        std::vector<heartbeat::sample> collect()
+        {
+            std::vector<heartbeat::sample> result{};
+
+            std::lock_guard lock{m_mutex};
+            std::erase_if(m_heartbeats, [&](const std::weak_ptr<heartbeat>& weak) {
+                const auto locked = weak.lock();
+                if (!locked)
+                    return true;
+                if (const auto sample = locked->get_sample())
+                    result.push_back(sample.value());
+                return false;
+            });
+            return result;
+        }
+
+    private:
+        std::shared_ptr<heartbeat> create()
+        {
+            std::lock_guard lock{m_mutex};
+            auto            result = std::make_shared<heartbeat>(m_next_id++);
+            m_heartbeats.push_back(result);
+            return result;
+        }
+
+    private:
+        std::mutex                            m_mutex{};
+        std::vector<std::weak_ptr<heartbeat>> m_heartbeats{};
+        size_t                                m_next_id{};
+    };
+#endif
+
+    /**
+     * @brief RAII marker of execution of schedulable by the current thread for `rpp::schedulers::watchdog`. Does nothing in case of watchdog is disabled.
+     */
+    class heartbeat_scope
+    {
+    public:
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+        template<typename Schedulable>
+        heartbeat_scope(const char* scheduler, const Schedulable& schedulable)
+            : m_heartbeat{heartbeat_registry::get_current()}
+        {
+            m_heartbeat.begin(scheduler, &schedulable.get_type_name());
+        }
+
+        ~heartbeat_scope() noexcept { m_heartbeat.end(); }
+#else
+        template<typename Schedulable>
+        constexpr heartbeat_scope(const char*, const Schedulable&)
+        {
+        }
+#endif
+
+        heartbeat_scope(const heartbeat_scope&) = delete;
+        heartbeat_scope(heartbeat_scope&&)      = delete;
+
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+    private:
+        heartbeat& m_heartbeat;
+#endif
+    };
+} // namespace rpp::schedulers::details
@@ -0,0 +1,74 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Hint to cpu that current thread is spinning: reduces power consumption and contention with sibling hyper-thread.
+     */
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        _mm_pause();
+#elif (defined(__aarch64__) || defined(__arm__)) && defined(__GNUC__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    // timepoints closer than this margin are awaited via spinning instead of sleeping due to sleeping is not precise enough (timer slack, wake-up latency)
+    inline constexpr duration s_precise_sleep_margin = std::chrono::microseconds{100};
+
+    /**
+     * @brief Spin according to `strategy` till `predicate` is satisfied or `deadline` is reached
+     * @details
+     * - `idle_strategy::blocking` doesn't spin at all
+     * - `idle_strategy::spin_yield_park` spins with cpu pause, then yields, then gives up. In case of deadline is closer than `s_precise_sleep_margin` spins till deadline.
+     * - `idle_strategy::busy_spin` spins till predicate or deadline.
+     *
+     * @return true if predicate is satisfied or deadline is reached, false if thread should be parked
+     */
+    template<std::predicate Predicate>
+    bool spin_until(idle_strategy strategy, time_point deadline, const Predicate& predicate)
+    {
+        if (strategy == idle_strategy::blocking)
+            return false;
+
+        constexpr size_t spins_count  = 1024;
+        constexpr size_t yields_count = 64;
+
+        for (size_t i = 0;; ++i)
+        {
+            if (predicate())
+                return true;
+
+            const auto now = clock_type::now();
+            if (now >= deadline)
+                return true;
+
+            if (strategy == idle_strategy::busy_spin || deadline - now <= s_precise_sleep_margin || i < spins_count)
+                cpu_relax();
+            else if (i < spins_count + yields_count)
+                std::this_thread::yield();
+            else
+                return false;
+        }
+    }
+} // namespace rpp::schedulers::details
@@ -0,0 +1,109 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <rpp/schedulers/details/pool_allocator.hpp>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Lock-free multi-producer single-consumer inbox.
+     * @details Producers push values to intrusive stack via CAS. Consumer grabs whole stack at once via exchange and processes values in order of pushing. As a result, consumer takes all pending values with one atomic operation and producers never block each other or consumer.
+     */
+    template<typename T>
+    class mpsc_inbox
+    {
+        struct node
+        {
+            T     value;
+            node* next;
+        };
+
+        using allocator        = schedulables_allocator<node>;
+        using allocator_traits = std::allocator_traits<allocator>;
+
+    public:
+        mpsc_inbox() = default;
+
+        mpsc_inbox(const mpsc_inbox&) = delete;
+        mpsc_inbox(mpsc_inbox&&)      = delete;
+
+        ~mpsc_inbox() noexcept
+        {
+            destroy(m_head.exchange(nullptr));
+        }
+
+        /**
+         * @brief Push value to inbox. Can be called from any thread.
+         * @return true if inbox was empty before this push
+         */
+        bool push(T&& value)
+        {
+            allocator a{};
+            node*     n = allocator_traits::allocate(a, 1);
+            allocator_traits::construct(a, n, node{std::move(value), nullptr});
+
+            // seq_cst to be properly ordered with consumer's "sleeping" flag
+            node* head = m_head.load(std::memory_order_relaxed);
+            do
+            {
+                n->next = head;
+            } while (!m_head.compare_exchange_weak(head, n, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+            return head == nullptr;
+        }
+
+        bool is_empty() const { return m_head.load(std::memory_order_seq_cst) == nullptr; }
+
+        /**
+         * @brief Extract all values pushed till this moment and pass them to `fn` in order of pushing. Can be called only from consumer thread.
+         */
+        template<typename Fn>
+        void drain(Fn&& fn)
+        {
+            node* head = m_head.exchange(nullptr, std::memory_order_acquire);
+            if (!head)
+                return;
+
+            node* reversed{};
+            while (head)
+                reversed = std::exchange(head, std::exchange(head->next, reversed));
+
+            while (reversed)
+            {
+                node* next = reversed->next;
+                fn(std::move(reversed->value));
+                destroy_node(reversed);
+                reversed = next;
+            }
+        }
+
+    private:
+        static void destroy_node(node* n) noexcept
+        {
+            allocator a{};
+            allocator_traits::destroy(a, n);
+            allocator_traits::deallocate(a, n, 1);
+        }
+
+        static void destroy(node* head) noexcept
+        {
+            while (head)
+                destroy_node(std::exchange(head, head->next));
+        }
+
+    private:
+        std::atomic<node*> m_head{};
+    };
+} // namespace rpp::schedulers::details
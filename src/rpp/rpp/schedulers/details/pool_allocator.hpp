@@ -0,0 +1,179 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Thread-local freelist of memory blocks of fixed size.
+     * @details Blocks are allocated via global `operator new` and on deallocation returned to the freelist of the current thread. As a result, blocks can safely migrate between threads (for example, schedulable created in one thread and destroyed inside new_thread). Amount of cached bytes per thread is limited to avoid unbounded growth in producer-consumer scenarios.
+     */
+    template<size_t BlockSize>
+    class memory_blocks_cache
+    {
+        static_assert(BlockSize >= sizeof(void*));
+
+        static constexpr size_t s_max_cached_bytes  = 256 * 1024;
+        static constexpr size_t s_max_cached_blocks = std::max(size_t{16}, s_max_cached_bytes / BlockSize);
+
+        struct node
+        {
+            node* next;
+        };
+
+        // trivially destructible to be available till the end of thread even after destruction of other thread_local objects
+        struct state
+        {
+            node*  head;
+            size_t size;
+            bool   cleaned_up;
+        };
+
+        struct cleanup
+        {
+            cleanup()               = default;
+            cleanup(const cleanup&) = delete;
+            cleanup(cleanup&&)      = delete;
+
+            ~cleanup() noexcept
+            {
+                auto& s      = get_state();
+                s.cleaned_up = true;
+                while (s.head)
+                    ::operator delete(std::exchange(s.head, s.head->next));
+                s.size = 0;
+            }
+        };
+
+    public:
+        static void* allocate()
+        {
+            auto& s = get_state();
+            if (!s.head)
+                return ::operator new(BlockSize);
+
+            --s.size;
+            return std::exchange(s.head, s.head->next);
+        }
+
+        static void deallocate(void* ptr) noexcept
+        {
+            auto& s = get_state();
+            if (s.cleaned_up || s.size >= s_max_cached_blocks)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            if (!s.head)
+                register_cleanup();
+
+            s.head = ::new (ptr) node{s.head};
+            ++s.size;
+        }
+
+    private:
+        static state& get_state() noexcept
+        {
+            thread_local state s_state{};
+            return s_state;
+        }
+
+        static void register_cleanup() noexcept
+        {
+            thread_local cleanup s_cleanup{};
+        }
+    };
+
+    /**
+     * @brief Allocator used by schedulers to allocate schedulables and internal data of queues without touching global heap in steady state.
+     * @details Memory is split into power-of-two size classes, each one served by thread-local freelist. Too big or over-aligned requests are forwarded to global `operator new`.
+     *
+     * @note Define `RPP_DISABLE_SCHEDULABLES_POOL=1` to use `std::allocator` instead (e.g. for better diagnostics from sanitizers).
+     */
+    template<typename T>
+    class pool_allocator
+    {
+        static constexpr size_t s_min_block_size = 16;
+        static constexpr size_t s_classes_count  = 11; // 16 bytes ... 16 kbytes
+        static constexpr size_t s_max_block_size = s_min_block_size << (s_classes_count - 1);
+
+        template<size_t... Is>
+        static consteval auto make_allocate_table(std::index_sequence<Is...>)
+        {
+            return std::array<void* (*)(), sizeof...(Is)>{&memory_blocks_cache<(s_min_block_size << Is)>::allocate...};
+        }
+
+        template<size_t... Is>
+        static consteval auto make_deallocate_table(std::index_sequence<Is...>)
+        {
+            return std::array<void (*)(void*) noexcept, sizeof...(Is)>{&memory_blocks_cache<(s_min_block_size << Is)>::deallocate...};
+        }
+
+        static constexpr bool is_poolable(size_t bytes) { return bytes <= s_max_block_size && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__; }
+
+        static constexpr size_t get_class(size_t bytes)
+        {
+            return bytes <= s_min_block_size ? 0 : static_cast<size_t>(std::bit_width(bytes - 1)) - static_cast<size_t>(std::bit_width(s_min_block_size - 1));
+        }
+
+    public:
+        using value_type = T;
+
+        pool_allocator() = default;
+
+        template<typename U>
+        pool_allocator(const pool_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            const auto bytes = n * sizeof(T);
+            if (!is_poolable(bytes))
+                return std::allocator<T>{}.allocate(n);
+
+            static constexpr auto s_table = make_allocate_table(std::make_index_sequence<s_classes_count>{});
+            return static_cast<T*>(s_table[get_class(bytes)]());
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            const auto bytes = n * sizeof(T);
+            if (!is_poolable(bytes))
+                return std::allocator<T>{}.deallocate(ptr, n);
+
+            static constexpr auto s_table = make_deallocate_table(std::make_index_sequence<s_classes_count>{});
+            s_table[get_class(bytes)](ptr);
+        }
+
+        template<typename U>
+        bool operator==(const pool_allocator<U>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+#if defined(RPP_DISABLE_SCHEDULABLES_POOL) && RPP_DISABLE_SCHEDULABLES_POOL
+    template<typename T>
+    using schedulables_allocator = std::allocator<T>;
+#else
+    template<typename T>
+    using schedulables_allocator = pool_allocator<T>;
+#endif
+} // namespace rpp::schedulers::details
@@ -12,20 +12,29 @@
 #include <rpp/schedulers/fwd.hpp>
 
 #include <rpp/defs.hpp>
+#include <rpp/schedulers/details/heartbeat.hpp>
+#include <rpp/schedulers/details/pool_allocator.hpp>
 #include <rpp/schedulers/details/utils.hpp>
+#include <rpp/schedulers/metrics.hpp>
 #include <rpp/utils/constraints.hpp>
 #include <rpp/utils/tuple.hpp>
 #include <rpp/utils/utils.hpp>
 
 #include "rpp/utils/functors.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <exception>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace rpp::schedulers::details
 {
@@ -34,6 +43,7 @@ namespace rpp::schedulers::details
     public:
         explicit schedulable_base(const time_point& time_point)
             : m_time_point{time_point}
+            , m_priority{s_scheduling_priority}
         {
         }
 
@@ -77,20 +87,16 @@ namespace rpp::schedulers::details
 
         virtual void on_error(const std::exception_ptr& ep) const = 0;
 
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+        // name of type of scheduled function reported by watchdog in case of stall
+        virtual const std::string_view& get_type_name() const noexcept = 0;
+#endif
+
         time_point get_timepoint() const { return m_time_point; }
 
         void set_timepoint(const time_point& timepoint) { m_time_point = timepoint; }
 
-        const std::shared_ptr<schedulable_base>& get_next() const { return m_next; }
-
-        void set_next(std::shared_ptr<schedulable_base>&& next) { m_next = std::move(next); }
-
-        void update_next(std::shared_ptr<schedulable_base>&& next)
-        {
-            if (next)
-                next->set_next(std::move(m_next));
-            m_next = std::move(next);
-        }
+        priority get_priority() const { return m_priority; }
 
     protected:
         template<typename NowStrategy>
@@ -109,8 +115,8 @@ namespace rpp::schedulers::details
         }
 
     private:
-        std::shared_ptr<schedulable_base> m_next{};
-        time_point                        m_time_point;
+        time_point     m_time_point;
+        const priority m_priority;
     };
 
     template<typename NowStrategy, rpp::constraint::decayed_type Fn, rpp::schedulers::constraint::schedulable_handler Handler, rpp::constraint::decayed_type... Args>
@@ -163,6 +169,10 @@ namespace rpp::schedulers::details
 
         void on_error(const std::exception_ptr& ep) const override { m_args.template get<0>().on_error(ep); }
 
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+        const std::string_view& get_type_name() const noexcept override { return type_name_v<Fn>; }
+#endif
+
     private:
         RPP_NO_UNIQUE_ADDRESS rpp::utils::tuple<Handler, Args...> m_args;
         RPP_NO_UNIQUE_ADDRESS Fn                                  m_fn;
@@ -201,7 +211,266 @@ namespace rpp::schedulers::details
         std::recursive_mutex        mutex{};
     };
 
-    template<typename NowStrategy>
+    template<typename NowStrategy, rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+    std::shared_ptr<schedulable_base> make_schedulable(const time_point& timepoint, Fn&& fn, Handler&& handler, Args&&... args)
+    {
+        using schedulable_type = specific_schedulable<NowStrategy, std::decay_t<Fn>, std::decay_t<Handler>, std::decay_t<Args>...>;
+
+        return std::allocate_shared<schedulable_type>(schedulables_allocator<schedulable_type>{}, timepoint, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Schedulable stored inside queue storage with order of insertion to keep FIFO order for same timepoint
+     */
+    struct queued_schedulable
+    {
+        time_point                        timepoint;
+        size_t                            index;
+        std::shared_ptr<schedulable_base> schedulable;
+
+        bool operator<(const queued_schedulable& other) const
+        {
+            if (timepoint != other.timepoint)
+                return timepoint < other.timepoint;
+            return index < other.index;
+        }
+    };
+
+    /**
+     * @brief Min d-ary heap of queued schedulables
+     */
+    template<size_t Arity = 4>
+    class schedulables_d_ary_heap
+    {
+        static_assert(Arity >= 2);
+
+    public:
+        bool   empty() const { return m_data.empty(); }
+        size_t size() const { return m_data.size(); }
+
+        const queued_schedulable& top() const { return m_data.front(); }
+
+        void push(queued_schedulable&& v)
+        {
+            size_t index = m_data.size();
+            m_data.push_back(std::move(v));
+
+            auto item = std::move(m_data.back());
+            while (index > 0)
+            {
+                const size_t parent = (index - 1) / Arity;
+                if (!(item < m_data[parent]))
+                    break;
+                m_data[index] = std::move(m_data[parent]);
+                index         = parent;
+            }
+            m_data[index] = std::move(item);
+        }
+
+        queued_schedulable pop()
+        {
+            auto result = std::move(m_data.front());
+            auto last   = std::move(m_data.back());
+            m_data.pop_back();
+
+            if (m_data.empty())
+                return result;
+
+            size_t       index = 0;
+            const size_t size  = m_data.size();
+            while (true)
+            {
+                const size_t first_child = index * Arity + 1;
+                if (first_child >= size)
+                    break;
+
+                size_t min_child = first_child;
+                for (size_t child = first_child + 1; child < std::min(first_child + Arity, size); ++child)
+                {
+                    if (m_data[child] < m_data[min_child])
+                        min_child = child;
+                }
+
+                if (!(m_data[min_child] < last))
+                    break;
+
+                m_data[index] = std::move(m_data[min_child]);
+                index         = min_child;
+            }
+            m_data[index] = std::move(last);
+            return result;
+        }
+
+    private:
+        std::vector<queued_schedulable, schedulables_allocator<queued_schedulable>> m_data{};
+    };
+
+    /**
+     * @brief Default storage of schedulables: d-ary heap plus FIFO "fast lane".
+     * @details Schedulable goes into FIFO lane if it is not earlier than last schedulable inside lane and not later than heap's top. As a result, lane is always sorted and most of "due now" schedulables (which are scheduled with increasing timepoints) are inserted/popped in O(1) without heap's sifting.
+     */
+    class schedulables_heap_storage
+    {
+    public:
+        bool empty() const { return m_lane.empty() && m_heap.empty(); }
+
+        void push(queued_schedulable&& v)
+        {
+            if ((m_lane.empty() || !(v.timepoint < m_lane.back().timepoint)) && (m_heap.empty() || !(m_heap.top().timepoint < v.timepoint)))
+                m_lane.push_back(std::move(v));
+            else
+                m_heap.push(std::move(v));
+        }
+
+        const queued_schedulable& top() const
+        {
+            return is_lane_top() ? m_lane.front() : m_heap.top();
+        }
+
+        queued_schedulable pop()
+        {
+            if (!is_lane_top())
+                return m_heap.pop();
+
+            auto result = std::move(m_lane.front());
+            m_lane.pop_front();
+            return result;
+        }
+
+        // lane keeps only schedulables in order of insertion, so, previously popped schedulable goes to heap
+        void restore(queued_schedulable&& v) { m_heap.push(std::move(v)); }
+
+    private:
+        bool is_lane_top() const
+        {
+            return !m_lane.empty() && (m_heap.empty() || m_lane.front() < m_heap.top());
+        }
+
+    private:
+        std::deque<queued_schedulable, schedulables_allocator<queued_schedulable>> m_lane{};
+        schedulables_d_ary_heap<>                                                  m_heap{};
+    };
+
+    /**
+     * @brief Storage of schedulables based on hierarchical timer wheel. Expected to be used for huge amount of pending delayed schedulables.
+     * @details Timepoints are split into ticks (~1us). Each level of wheel has 64 slots and represents 6 bits of tick. Schedulable placed to level of the highest 6-bit digit differing from current tick, so, insertion is O(1). Earliest non-empty slot is cascaded to lower levels till it becomes due and then moved to small "front" heap to keep exact order by timepoint and insertion.
+     * @note Front heap is never empty if storage is not empty, so, `top` is always O(1).
+     */
+    class schedulables_timer_wheel_storage
+    {
+        static constexpr size_t s_tick_shift = 10;
+        static constexpr size_t s_level_bits = 6;
+        static constexpr size_t s_slots      = size_t{1} << s_level_bits;
+        static constexpr size_t s_levels     = (64 - s_tick_shift + s_level_bits - 1) / s_level_bits;
+
+        struct level
+        {
+            uint64_t                                                                                  occupied{};
+            std::array<std::vector<queued_schedulable, schedulables_allocator<queued_schedulable>>, s_slots> slots{};
+        };
+
+    public:
+        bool empty() const { return m_front.empty(); }
+
+        void push(queued_schedulable&& v)
+        {
+            if (m_front.empty())
+            {
+                m_current_tick = get_tick(v.timepoint);
+                m_front.push(std::move(v));
+                return;
+            }
+
+            push_impl(std::move(v));
+        }
+
+        const queued_schedulable& top() const { return m_front.top(); }
+
+        queued_schedulable pop()
+        {
+            auto result = m_front.pop();
+            if (m_front.empty() && m_wheel_size != 0)
+                refill();
+            return result;
+        }
+
+        void restore(queued_schedulable&& v) { push(std::move(v)); }
+
+    private:
+        static uint64_t get_tick(time_point tp)
+        {
+            const auto count = std::chrono::duration_cast<duration>(tp.time_since_epoch()).count();
+            return count <= 0 ? 0 : static_cast<uint64_t>(count) >> s_tick_shift;
+        }
+
+        static size_t get_digit(uint64_t tick, size_t level) { return static_cast<size_t>((tick >> (level * s_level_bits)) & (s_slots - 1)); }
+
+        void push_impl(queued_schedulable&& v)
+        {
+            const auto tick = get_tick(v.timepoint);
+            if (tick <= m_current_tick)
+            {
+                m_front.push(std::move(v));
+                return;
+            }
+
+            const auto differing_bits = static_cast<size_t>(std::bit_width(tick ^ m_current_tick));
+            const auto level_index    = (differing_bits - 1) / s_level_bits;
+            const auto slot           = get_digit(tick, level_index);
+
+            if (m_levels.empty())
+                m_levels.resize(s_levels);
+
+            auto& l = m_levels[level_index];
+            l.slots[slot].push_back(std::move(v));
+            l.occupied |= uint64_t{1} << slot;
+            ++m_wheel_size;
+        }
+
+        // moves earliest schedulables from wheel to front heap
+        void refill()
+        {
+            while (m_front.empty())
+            {
+                for (size_t level_index = 0; level_index < s_levels; ++level_index)
+                {
+                    auto&      l     = m_levels[level_index];
+                    const auto digit = get_digit(m_current_tick, level_index);
+                    const auto mask  = digit + 1 == s_slots ? uint64_t{} : l.occupied & (~uint64_t{} << (digit + 1));
+                    if (!mask)
+                        continue;
+
+                    const auto slot = static_cast<size_t>(std::countr_zero(mask));
+                    l.occupied &= ~(uint64_t{1} << slot);
+
+                    const auto shift     = level_index * s_level_bits;
+                    const auto high_mask = shift + s_level_bits >= 64 ? uint64_t{} : ~uint64_t{} << (shift + s_level_bits);
+                    m_current_tick       = (m_current_tick & high_mask) | (static_cast<uint64_t>(slot) << shift);
+
+                    auto items = std::move(l.slots[slot]);
+                    l.slots[slot].clear();
+                    m_wheel_size -= items.size();
+                    for (auto& item : items)
+                        push_impl(std::move(item));
+                    break;
+                }
+            }
+        }
+
+    private:
+        std::vector<level, schedulables_allocator<level>> m_levels{};
+        schedulables_d_ary_heap<>                         m_front{};
+        uint64_t                                          m_current_tick{};
+        size_t                                            m_wheel_size{};
+    };
+
+#if defined(RPP_SCHEDULERS_USE_TIMER_WHEEL) && RPP_SCHEDULERS_USE_TIMER_WHEEL
+    using default_schedulables_storage = schedulables_timer_wheel_storage;
+#else
+    using default_schedulables_storage = schedulables_heap_storage;
+#endif
+
+    template<typename NowStrategy, typename Storage = default_schedulables_storage>
     class schedulables_queue
     {
     public:
@@ -220,9 +489,7 @@ namespace rpp::schedulers::details
         template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
         void emplace(const time_point& timepoint, Fn&& fn, Handler&& handler, Args&&... args)
         {
-            using schedulable_type = specific_schedulable<NowStrategy, std::decay_t<Fn>, std::decay_t<Handler>, std::decay_t<Args>...>;
-
-            emplace_impl(std::make_shared<schedulable_type>(timepoint, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...));
+            emplace_impl(make_schedulable<NowStrategy>(timepoint, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...));
         }
 
         void emplace(const time_point& timepoint, std::shared_ptr<schedulable_base>&& schedulable)
@@ -234,22 +501,152 @@ namespace rpp::schedulers::details
             emplace_impl(std::move(schedulable));
         }
 
-        bool is_empty() const { return !m_head; }
+        bool is_empty() const
+        {
+            return m_storage.empty() && (!m_extra_lanes || std::ranges::all_of(*m_extra_lanes, [](const Storage& lane) { return lane.empty(); }));
+        }
+
+        /**
+         * @brief Report depth of this queue to metrics of worker. Expected to be called before any emplace.
+         */
+        void set_metrics(const metrics_hook& hook) { m_metrics = queue_metrics{hook}; }
+
+        void set_priority_policy(priority_policy policy) { m_policy = policy; }
 
         std::shared_ptr<schedulable_base> pop()
         {
-            return std::exchange(m_head, m_head->get_next());
+            return pop_queued().schedulable;
+        }
+
+        /**
+         * @brief Pop top schedulable together with its position inside queue to be able to return it back via `restore`
+         */
+        queued_schedulable pop_queued()
+        {
+            m_metrics.on_dequeued();
+            const auto selected = get_selection();
+            m_selection.reset();
+            commit_selection(selected);
+            return get_lane(selected.lane).pop();
+        }
+
+        /**
+         * @brief Return schedulable obtained via `pop_queued` back to the queue at the same position as it was before
+         */
+        void restore(queued_schedulable&& schedulable)
+        {
+            m_metrics.on_enqueued();
+            m_selection.reset();
+            get_lane(schedulable.schedulable->get_priority()).restore(std::move(schedulable));
         }
 
+        /**
+         * @brief Schedulable to be executed next: ready schedulable of the highest priority (according to policy) or schedulable with the earliest timepoint if nothing is ready yet
+         * @details Next `pop` returns exactly this schedulable unless queue is modified in between.
+         */
         const std::shared_ptr<schedulable_base>& top() const
         {
-            return m_head;
+            m_selection.reset();
+            return get_lane(get_selection().lane).top().schedulable;
         }
 
     private:
+        static constexpr size_t                 s_priorities_count = 3;
+        static constexpr std::array<int64_t, 3> s_weights{4, 2, 1};
+
+        struct selection
+        {
+            priority lane{priority::normal};
+            // bitmask of priorities having ready schedulables in case of weighted policy
+            uint8_t ready_mask{};
+        };
+
+        Storage& get_lane(priority p)
+        {
+            return p == priority::normal ? m_storage : (*m_extra_lanes)[p == priority::high ? 0 : 1];
+        }
+
+        const Storage& get_lane(priority p) const
+        {
+            return p == priority::normal ? m_storage : (*m_extra_lanes)[p == priority::high ? 0 : 1];
+        }
+
+        selection get_selection() const
+        {
+            if (!m_selection)
+                m_selection = select();
+            return m_selection.value();
+        }
+
+        selection select() const
+        {
+            // fast path: priorities are not used at all
+            if (!m_extra_lanes)
+                return {};
+
+            std::array<priority, s_priorities_count> non_empty{};
+            size_t                                   non_empty_count{};
+            for (const auto p : {priority::high, priority::normal, priority::low})
+            {
+                if (!get_lane(p).empty())
+                    non_empty[non_empty_count++] = p;
+            }
+
+            if (non_empty_count == 1)
+                return {non_empty[0]};
+
+            const auto             now = NowStrategy::now();
+            std::optional<size_t>  earliest{};
+            selection              result{};
+            std::optional<int64_t> best_credit{};
+            for (size_t i = 0; i < non_empty_count; ++i)
+            {
+                const auto  p         = non_empty[i];
+                const auto  idx       = static_cast<size_t>(p);
+                const auto& timepoint = get_lane(p).top().timepoint;
+                if (!earliest || timepoint < get_lane(non_empty[earliest.value()]).top().timepoint)
+                    earliest = i;
+
+                if (timepoint > now)
+                    continue;
+
+                result.ready_mask = static_cast<uint8_t>(result.ready_mask | (1u << idx));
+                if (m_policy == priority_policy::strict)
+                    return {p};
+
+                if (const auto credit = m_credits[idx] + s_weights[idx]; !best_credit || credit > best_credit.value())
+                {
+                    best_credit = credit;
+                    result.lane = p;
+                }
+            }
+
+            if (result.ready_mask == 0)
+                return {non_empty[earliest.value()]};
+            return result;
+        }
+
+        // smooth weighted round-robin: each ready priority earns its weight, selected one pays total weight of ready priorities
+        void commit_selection(const selection& selected)
+        {
+            if (selected.ready_mask == 0)
+                return;
+
+            int64_t total{};
+            for (size_t i = 0; i < s_priorities_count; ++i)
+            {
+                if (selected.ready_mask & (1u << i))
+                {
+                    m_credits[i] += s_weights[i];
+                    total += s_weights[i];
+                }
+            }
+            m_credits[static_cast<size_t>(selected.lane)] -= total;
+        }
+
         void emplace_impl(std::shared_ptr<schedulable_base>&& schedulable)
         {
-            // needed in case of new_thread and current_thread shares same queue
+            // needed in case of queue shared between current_thread and another thread (e.g. work-stealing strand)
             const auto                       s = m_shared_data.lock();
             const rpp::utils::finally_action _{[&] {
                 if (s)
@@ -259,26 +656,26 @@ namespace rpp::schedulers::details
             optional_mutex<std::recursive_mutex> mutex{s ? &s->mutex : nullptr};
             std::lock_guard                      lock{mutex};
 
-            if (!m_head || schedulable->get_timepoint() < m_head->get_timepoint())
-            {
-                schedulable->set_next(std::move(m_head));
-                m_head = std::move(schedulable);
-                return;
-            }
-
-            schedulable_base* current = m_head.get();
-            while (const auto& next = current->get_next())
-            {
-                if (schedulable->get_timepoint() < next->get_timepoint())
-                    break;
-                current = next.get();
-            }
+            const auto p = schedulable->get_priority();
+            if (p != priority::normal && !m_extra_lanes)
+                m_extra_lanes = std::make_unique<std::array<Storage, s_priorities_count - 1>>();
 
-            current->update_next(std::move(schedulable));
+            const auto timepoint = schedulable->get_timepoint();
+            get_lane(p).push(queued_schedulable{timepoint, m_index++, std::move(schedulable)});
+            m_selection.reset();
+            m_metrics.on_enqueued();
         }
 
     private:
-        std::shared_ptr<schedulable_base> m_head{};
-        std::weak_ptr<shared_queue_data>  m_shared_data{};
+        // lane of `priority::normal`
+        Storage m_storage{};
+        // lanes of `priority::high` and `priority::low` created on first usage
+        std::unique_ptr<std::array<Storage, s_priorities_count - 1>> m_extra_lanes{};
+        size_t                                                       m_index{};
+        std::weak_ptr<shared_queue_data>                             m_shared_data{};
+        RPP_NO_UNIQUE_ADDRESS queue_metrics                          m_metrics{};
+        priority_policy                                              m_policy{priority_policy::strict};
+        std::array<int64_t, s_priorities_count>                      m_credits{};
+        mutable std::optional<selection>                             m_selection{};
     };
 } // namespace rpp::schedulers::details
@@ -0,0 +1,89 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Bounded lock-free single-producer single-consumer ring buffer.
+     * @details Producer and consumer touch only their own index (plus cached copy of the other one), so, passing values between two fixed threads costs no CAS and no shared cache line writes except of the slot itself.
+     */
+    template<typename T>
+    class spsc_ring
+    {
+        static constexpr size_t s_cache_line_size = 64;
+
+    public:
+        explicit spsc_ring(size_t capacity)
+            : m_buffer(std::bit_ceil(std::max(size_t{2}, capacity)))
+            , m_mask{m_buffer.size() - 1}
+        {
+        }
+
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring(spsc_ring&&)      = delete;
+
+        /**
+         * @brief Push value to ring. Can be called only from producer thread.
+         * @return false if ring is full. In this case `value` is left untouched.
+         */
+        bool try_push(T& value)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_cached_head == m_buffer.size())
+            {
+                m_cached_head = m_head.load(std::memory_order_acquire);
+                if (tail - m_cached_head == m_buffer.size())
+                    return false;
+            }
+
+            m_buffer[tail & m_mask] = std::move(value);
+            // seq_cst to be properly ordered with consumer's "sleeping" flag
+            m_tail.store(tail + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        /**
+         * @brief Can be called only from consumer thread.
+         */
+        bool is_empty() const { return m_tail.load(std::memory_order_seq_cst) == m_head.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Extract all values pushed till this moment and pass them to `fn` in order of pushing. Can be called only from consumer thread.
+         */
+        template<typename Fn>
+        void drain(Fn&& fn)
+        {
+            size_t       head = m_head.load(std::memory_order_relaxed);
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            for (; head != tail; ++head)
+            {
+                fn(std::move(m_buffer[head & m_mask]));
+                m_head.store(head + 1, std::memory_order_release);
+            }
+        }
+
+    private:
+        std::vector<T> m_buffer;
+        const size_t   m_mask;
+
+        alignas(s_cache_line_size) std::atomic<size_t> m_head{};
+        alignas(s_cache_line_size) std::atomic<size_t> m_tail{};
+        // producer's copy of `m_head` to avoid touching consumer's cache line on each push
+        size_t m_cached_head{};
+    };
+} // namespace rpp::schedulers::details
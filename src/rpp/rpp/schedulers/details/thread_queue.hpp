@@ -0,0 +1,246 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/current_thread.hpp>
+#include <rpp/schedulers/details/clock.hpp>
+#include <rpp/schedulers/details/idle.hpp>
+#include <rpp/schedulers/details/mpsc_inbox.hpp>
+#include <rpp/schedulers/details/queue.hpp>
+#include <rpp/schedulers/metrics.hpp>
+#include <rpp/utils/utils.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief Queue of schedulables processed by one dedicated thread.
+     * @details Schedulings from the owning thread go directly to local queue, schedulings from other threads go via lock-free inbox which is spliced into local queue by owning thread. Owning thread is woken up only if it is sleeping.
+     * Before sleeping owning thread spins according to `idle_strategy`. Schedulable re-scheduled immediately is re-executed in-place while `execution_budget` allows it.
+     */
+    class thread_queue final
+    {
+    public:
+        /**
+         * @param scheduler name of owning scheduler reported via metrics
+         */
+        explicit thread_queue(idle_strategy strategy = idle_strategy::blocking, priority_policy policy = priority_policy::strict, execution_budget budget = {}, const char* scheduler = "new_thread")
+            : m_metrics{scheduler}
+            , m_idle_strategy{strategy}
+            , m_budget{budget}
+        {
+            m_queue.set_metrics(m_metrics);
+            m_queue.set_priority_policy(policy);
+        }
+
+        thread_queue(const thread_queue&) = delete;
+        thread_queue(thread_queue&&)      = delete;
+
+        template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+        void defer_to(time_point time_point, Fn&& fn, Handler&& handler, Args&&... args)
+        {
+            // schedulings from own thread goes directly to local queue, other ones - via lock-free inbox
+            if (current_thread::get_queue() == &m_queue)
+            {
+                m_queue.emplace(time_point, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                return;
+            }
+
+            defer(make_schedulable<current_thread::worker_strategy>(time_point, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...));
+        }
+
+        /**
+         * @brief Pass already created schedulable to owning thread via inbox. Can be called from any thread.
+         */
+        void defer(std::shared_ptr<schedulable_base>&& schedulable)
+        {
+            m_metrics.on_enqueued();
+            m_inbox.push(std::move(schedulable));
+            wake_up();
+        }
+
+        /**
+         * @brief Wake up owning thread after pushing to any of its inputs (see `run`)
+         */
+        void wake_up()
+        {
+            // wake up thread only if it is sleeping and nobody else woke up it already
+            if (m_is_sleeping.load() && m_is_sleeping.exchange(false))
+                notify();
+        }
+
+        /**
+         * @brief Request owning thread to return from `run` as soon as all schedulables are processed
+         */
+        void stop()
+        {
+            {
+                std::lock_guard lock{m_mutex};
+                m_is_stopping.store(true);
+            }
+            m_cv.notify_all();
+        }
+
+        /**
+         * @brief Cancel previous `stop` request to be able to reuse this queue (and its thread) again
+         */
+        void restart() { m_is_stopping.store(false); }
+
+        /**
+         * @brief Process schedulables in the current thread till `stop` request and empty queue
+         */
+        void run()
+        {
+            no_inputs inputs{};
+            run(inputs);
+        }
+
+        /**
+         * @brief Same as `run()`, but additionally drains `inputs` (e.g. SPSC rings from other threads) together with inbox.
+         * @details `Inputs` has to provide `is_empty()` and `drain(fn)` callable from the owning thread. Producers have to call `wake_up` after pushing to inputs.
+         */
+        template<typename Inputs>
+        void run(Inputs& inputs)
+        {
+            current_thread::get_queue() = &m_queue;
+            const now_cache::scope now_scope{};
+
+            while (true)
+            {
+                now_cache::tick();
+                splice_inbox(inputs);
+
+                if (m_queue.is_empty())
+                {
+                    if (m_is_stopping.load() && m_inbox.is_empty() && inputs.is_empty())
+                        break;
+
+                    wait_for_data(inputs);
+                    continue;
+                }
+
+                if (m_queue.top()->is_disposed())
+                {
+                    m_queue.pop();
+                    continue;
+                }
+
+                if (s_last_now_time < m_queue.top()->get_timepoint())
+                {
+                    if (const auto now = details::now(); now < m_queue.top()->get_timepoint())
+                    {
+                        wait_for_data(inputs);
+                        continue;
+                    }
+                }
+
+                auto                     top               = m_queue.pop();
+                const auto               execution_metrics = m_metrics.on_execution(*top);
+                execution_budget_tracker budget{m_budget};
+
+                while (true)
+                {
+                    if (const auto res = top->make_advanced_call())
+                    {
+                        if (!top->is_disposed())
+                        {
+                            if (res->can_run_immediately() && m_queue.is_empty() && m_inbox.is_empty() && inputs.is_empty() && budget.consume())
+                                continue;
+
+                            const auto tp = top->handle_advanced_call(res.value());
+                            m_queue.emplace(tp, std::move(top));
+                        }
+                    }
+                    break;
+                }
+            }
+
+            current_thread::get_queue() = nullptr;
+        }
+
+    private:
+        struct no_inputs
+        {
+            static bool is_empty() { return true; }
+
+            template<typename Fn>
+            static void drain(Fn&&)
+            {
+            }
+        };
+
+        void notify()
+        {
+            {
+                std::lock_guard lock{m_mutex};
+            }
+            m_cv.notify_one();
+        }
+
+        template<typename Inputs>
+        void splice_inbox(Inputs& inputs)
+        {
+            // inputs and inbox are independent: each producer uses only one of them, so, order between them doesn't matter
+            inputs.drain([&](std::shared_ptr<schedulable_base>&& schedulable) {
+                const auto timepoint = schedulable->get_timepoint();
+                m_queue.emplace(timepoint, std::move(schedulable));
+            });
+            m_inbox.drain([&](std::shared_ptr<schedulable_base>&& schedulable) {
+                // moved from inbox to local queue which reports depth by itself
+                m_metrics.on_dequeued();
+                const auto timepoint = schedulable->get_timepoint();
+                m_queue.emplace(timepoint, std::move(schedulable));
+            });
+        }
+
+        template<typename Inputs>
+        void wait_for_data(Inputs& inputs)
+        {
+            // any waiting makes cached "now" outdated
+            now_cache::invalidate();
+            const rpp::utils::finally_action invalidate_now{[] { now_cache::invalidate(); }};
+
+            const auto has_data = [&] { return !m_inbox.is_empty() || !inputs.is_empty() || m_is_stopping.load(); };
+            const auto deadline = m_queue.is_empty() ? time_point::max() : m_queue.top()->get_timepoint();
+
+            // new schedulable or near-term timepoint can be expected soon, so, try to avoid expensive parking and waking up
+            if (spin_until(m_idle_strategy, deadline, has_data))
+                return;
+
+            std::unique_lock lock{m_mutex};
+            m_is_sleeping.store(true);
+
+            if (deadline == time_point::max())
+                m_cv.wait(lock, has_data);
+            // wake up a bit earlier to spin till exact timepoint instead of oversleeping
+            else if (const auto wake_up = m_idle_strategy == idle_strategy::blocking ? deadline : deadline - s_precise_sleep_margin, now = details::now(); now < wake_up)
+                m_cv.wait_for(lock, wake_up - now, has_data);
+
+            m_is_sleeping.store(false);
+        }
+
+    private:
+        const metrics_hook                                  m_metrics;
+        schedulables_queue<current_thread::worker_strategy> m_queue{};
+        mpsc_inbox<std::shared_ptr<schedulable_base>>       m_inbox{};
+        std::mutex                                          m_mutex{};
+        std::condition_variable                             m_cv{};
+        std::atomic_bool                                    m_is_stopping{};
+        std::atomic_bool                                    m_is_sleeping{};
+        const idle_strategy                                 m_idle_strategy;
+        const execution_budget                              m_budget;
+    };
+} // namespace rpp::schedulers::details
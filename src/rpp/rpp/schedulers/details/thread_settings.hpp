@@ -0,0 +1,260 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace rpp::schedulers::details
+{
+    /**
+     * @brief OS-level settings applied to thread right after its start and before processing of any schedulable.
+     */
+    struct thread_settings
+    {
+        // indexes of cpus this thread is allowed to run on. Empty means "no restrictions"
+        std::vector<size_t> cpus{};
+        // nice value of thread (-20 ... 19)
+        std::optional<int> nice{};
+        // priority for SCHED_FIFO real-time policy (1 ... 99)
+        std::optional<int> fifo_priority{};
+
+        bool is_default() const { return cpus.empty() && !nice && !fifo_priority; }
+
+        /**
+         * @brief Apply settings to the calling thread
+         * @throws std::system_error in case of OS rejected any of settings (for example, due to lack of permissions for real-time priority)
+         */
+        void apply_to_current_thread() const
+        {
+            if (is_default())
+                return;
+
+#if defined(__linux__)
+            if (!cpus.empty())
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                for (const auto cpu : cpus)
+                {
+                    if (cpu >= CPU_SETSIZE)
+                        throw std::system_error{std::make_error_code(std::errc::invalid_argument), "cpu index is out of range"};
+                    CPU_SET(cpu, &set);
+                }
+                if (const auto res = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set))
+                    throw std::system_error{res, std::system_category(), "can't set thread affinity"};
+            }
+
+            if (nice)
+            {
+                // on linux nice value is per-thread attribute, so, tid is used instead of pid
+                if (::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), nice.value()) != 0)
+                    throw std::system_error{errno, std::system_category(), "can't set thread nice value"};
+            }
+
+            if (fifo_priority)
+            {
+                sched_param param{};
+                param.sched_priority = fifo_priority.value();
+                if (const auto res = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param))
+                    throw std::system_error{res, std::system_category(), "can't set SCHED_FIFO thread priority"};
+            }
+#else
+            throw std::system_error{std::make_error_code(std::errc::not_supported), "thread settings are supported only on linux"};
+#endif
+        }
+    };
+
+    /**
+     * @brief Start new thread executing `fn` after applying of `settings` to it.
+     * @details In case of non-default settings waits till settings are applied by new thread to be able to rethrow error to the caller.
+     */
+    template<typename Fn>
+    std::thread start_thread(const thread_settings& settings, Fn&& fn)
+    {
+        if (settings.is_default())
+            return std::thread{std::forward<Fn>(fn)};
+
+        std::promise<void> applied{};
+        auto               future = applied.get_future();
+        std::thread        thread{[settings, applied = std::move(applied), fn = std::forward<Fn>(fn)]() mutable {
+            try
+            {
+                settings.apply_to_current_thread();
+            }
+            catch (...)
+            {
+                applied.set_exception(std::current_exception());
+                return;
+            }
+            applied.set_value();
+            fn();
+        }};
+
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            thread.join();
+            throw;
+        }
+        return thread;
+    }
+
+#if defined(__linux__)
+    // returns path of cgroup of current process from `/proc/self/cgroup`: for cgroup v2 if `controller` is empty, for cgroup v1 hierarchy with `controller` otherwise
+    inline std::optional<std::string> get_self_cgroup_path(std::string_view controller)
+    {
+        std::ifstream file{"/proc/self/cgroup"};
+        std::string   line{};
+        while (std::getline(file, line))
+        {
+            // "<hierarchy-id>:<comma-separated controllers>:<path>"
+            const auto first  = line.find(':');
+            const auto second = first == std::string::npos ? std::string::npos : line.find(':', first + 1);
+            if (second == std::string::npos)
+                continue;
+
+            const auto controllers = std::string_view{line}.substr(first + 1, second - first - 1);
+            if (controller.empty() ? controllers.empty() : (',' + std::string{controllers} + ',').find(',' + std::string{controller} + ',') != std::string::npos)
+                return line.substr(second + 1);
+        }
+        return std::nullopt;
+    }
+
+    // invokes `fn` for cgroup `path` and all of its parents till root of hierarchy (root is passed as empty path)
+    template<typename Fn>
+    void for_each_cgroup_ancestor(std::string path, Fn&& fn)
+    {
+        while (!path.empty() && path.back() == '/')
+            path.pop_back();
+
+        while (true)
+        {
+            fn(path);
+            if (path.empty())
+                return;
+            path.resize(path.rfind('/'));
+        }
+    }
+
+    // returns amount of cpus allowed by cgroup CPU quota (v2 or v1) if any. Quota of cgroup is limited by quotas of its parents, so, the smallest one is used
+    inline std::optional<size_t> get_cgroup_cpu_limit()
+    {
+        const auto to_cpus = [](double quota, double period) -> std::optional<size_t> {
+            if (quota <= 0 || period <= 0)
+                return std::nullopt;
+            return std::max(size_t{1}, static_cast<size_t>(std::ceil(quota / period)));
+        };
+
+        std::optional<size_t> result{};
+        const auto            update_result = [&](std::optional<size_t> limit) {
+            if (limit && (!result || limit.value() < result.value()))
+                result = limit;
+        };
+
+        // cgroup v2: "<quota> <period>" or "max <period>". Cgroup of process is missing in hierarchy in case of cgroup namespace, so, path is checked till root of mount
+        if (const auto path = get_self_cgroup_path({}))
+        {
+            bool is_v2{};
+            for_each_cgroup_ancestor(path.value(), [&](const std::string& dir) {
+                std::ifstream file{"/sys/fs/cgroup" + dir + "/cpu.max"};
+                std::string   quota{};
+                double        period{};
+                if (!(file >> quota >> period))
+                    return;
+
+                is_v2 = true;
+                if (quota != "max")
+                    update_result(to_cpus(std::strtod(quota.c_str(), nullptr), period));
+            });
+            if (is_v2)
+                return result;
+        }
+
+        // cgroup v1: quota is -1 in case of no limit
+        const auto path = get_self_cgroup_path("cpu").value_or("/");
+        for (const char* mount : {"/sys/fs/cgroup/cpu,cpuacct", "/sys/fs/cgroup/cpu"})
+        {
+            for_each_cgroup_ancestor(path, [&](const std::string& dir) {
+                std::ifstream quota_file{mount + dir + "/cpu.cfs_quota_us"};
+                std::ifstream period_file{mount + dir + "/cpu.cfs_period_us"};
+                double        quota{};
+                double        period{};
+                if (quota_file >> quota && period_file >> period)
+                    update_result(to_cpus(quota, period));
+            });
+            if (result)
+                return result;
+        }
+        return std::nullopt;
+    }
+#endif
+
+    /**
+     * @brief Indexes of cpus calling thread is allowed to run on. Empty on non-linux platforms.
+     */
+    inline std::vector<size_t> get_allowed_cpus()
+    {
+        std::vector<size_t> result{};
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                    result.push_back(cpu);
+            }
+        }
+#endif
+        return result;
+    }
+
+    /**
+     * @brief Amount of cpus actually available for current process: `std::thread::hardware_concurrency()` limited by cpu affinity mask and cgroup CPU quota of container.
+     */
+    inline size_t get_available_concurrency()
+    {
+        size_t result = std::max(1u, std::thread::hardware_concurrency());
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+            result = std::min(result, std::max(size_t{1}, static_cast<size_t>(CPU_COUNT(&set))));
+
+        if (const auto limit = get_cgroup_cpu_limit())
+            result = std::min(result, limit.value());
+#endif
+        return result;
+    }
+} // namespace rpp::schedulers::details
@@ -11,17 +11,97 @@
 
 #include <rpp/schedulers/fwd.hpp>
 
+#include <rpp/schedulers/details/clock.hpp>
+
 #include <exception>
 #include <optional>
 #include <thread>
+#include <utility>
 
 namespace rpp::schedulers::details
 {
     inline thread_local time_point s_last_now_time{};
 
+    // priority assigned to schedulables created by current thread right now, see `rpp::schedulers::prioritized`
+    inline thread_local priority s_scheduling_priority{priority::normal};
+
+    /**
+     * @brief RAII scope assigning `priority` to all schedulables created by current thread inside this scope
+     */
+    class scheduling_priority_scope
+    {
+    public:
+        explicit scheduling_priority_scope(priority p)
+            : m_previous{std::exchange(s_scheduling_priority, p)}
+        {
+        }
+
+        ~scheduling_priority_scope() noexcept { s_scheduling_priority = m_previous; }
+
+        scheduling_priority_scope(const scheduling_priority_scope&) = delete;
+        scheduling_priority_scope(scheduling_priority_scope&&)      = delete;
+
+    private:
+        const priority m_previous;
+    };
+
+    /**
+     * @brief "now" used by schedulers: obtained from selected `clock_source` or from `now_cache` in case of it is enabled and current thread is processing batch of schedulables.
+     */
     inline rpp::schedulers::time_point now()
     {
-        return s_last_now_time = clock_type::now();
+        if (now_cache::try_use())
+            return s_last_now_time;
+        return s_last_now_time = clock_source::now();
+    }
+
+    /**
+     * @brief Tracks consumption of `execution_budget` by executions in a row
+     */
+    class execution_budget_tracker
+    {
+    public:
+        explicit execution_budget_tracker(const execution_budget& budget)
+            : m_items_left{budget.max_items}
+            , m_deadline{get_deadline(budget.max_duration)}
+        {
+        }
+
+        /**
+         * @brief Account one more execution
+         * @return true if one more execution in a row is allowed
+         */
+        bool consume()
+        {
+            if (m_items_left > 0)
+                --m_items_left;
+            return !is_exhausted();
+        }
+
+        bool is_exhausted() const
+        {
+            return m_items_left == 0 || (m_deadline != time_point::max() && m_deadline <= now());
+        }
+
+    private:
+        static time_point get_deadline(duration max_duration)
+        {
+            if (max_duration == duration::max())
+                return time_point::max();
+
+            const auto current = now();
+            return max_duration >= time_point::max() - current ? time_point::max() : current + max_duration;
+        }
+
+    private:
+        size_t           m_items_left;
+        const time_point m_deadline;
+    };
+
+    inline void sleep_for(const duration duration)
+    {
+        std::this_thread::sleep_for(duration);
+        now_cache::invalidate();
     }
 
     inline bool sleep_until(const time_point timepoint)
@@ -30,7 +110,7 @@ namespace rpp::schedulers::details
             return false;
 
         const auto now = clock_type::now();
-        std::this_thread::sleep_for(timepoint - now);
+        details::sleep_for(timepoint - now);
         details::s_last_now_time = std::max(now, timepoint);
         return timepoint > now;
     }
@@ -90,7 +170,7 @@ namespace rpp::schedulers::details
 
             if (duration > duration::zero())
             {
-                std::this_thread::sleep_for(duration);
+                details::sleep_for(duration);
 
                 if (handler.is_disposed())
                     return std::nullopt;
@@ -134,7 +214,7 @@ namespace rpp::schedulers::details
             {
                 if (duration > duration::zero())
                 {
-                    std::this_thread::sleep_for(duration);
+                    details::sleep_for(duration);
 
                     if (handler.is_disposed())
                         return std::nullopt;
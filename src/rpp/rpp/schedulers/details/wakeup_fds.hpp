@@ -0,0 +1,126 @@
+//                   ReactivePlusPlus library
+//
+//           Copyright Aleksey Loginov 2023 - present.
+//  Distributed under the Boost Software License, Version 1.0.
+//     (See accompanying file LICENSE_1_0.txt or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+//
+//  Project home: https://github.com/victimsnino/ReactivePlusPlus
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+
+#if defined(__linux__)
+    #include <sys/eventfd.h>
+    #include <sys/timerfd.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+namespace rpp::schedulers::details
+{
+#if defined(__linux__)
+    /**
+     * @brief Pair of eventfd and timerfd signalling that some schedulable is ready to be executed.
+     * @details eventfd becomes readable when schedulable is ready right now, timerfd becomes readable when timepoint of the earliest schedulable is reached. Both descriptors are non-blocking, so, they can be added to external epoll/poll loop.
+     * @warning Not thread-safe: expected to be guarded by owner.
+     */
+    class wakeup_fds final
+    {
+    public:
+        wakeup_fds()
+            : m_event_fd{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+            , m_timer_fd{::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)}
+        {
+            if (m_event_fd < 0 || m_timer_fd < 0)
+            {
+                const auto error = errno;
+                close();
+                throw std::system_error{error, std::system_category(), "can't create wakeup file descriptors"};
+            }
+        }
+
+        wakeup_fds(const wakeup_fds&) = delete;
+        wakeup_fds(wakeup_fds&&)      = delete;
+
+        ~wakeup_fds() noexcept { close(); }
+
+        int get_event_fd() const { return m_event_fd; }
+        int get_timer_fd() const { return m_timer_fd; }
+
+        /**
+         * @brief Make one of descriptors readable not later than `timepoint`. Does nothing if already armed to earlier timepoint.
+         */
+        void arm(time_point timepoint, time_point now)
+        {
+            if (m_armed_timepoint <= timepoint)
+                return;
+
+            m_armed_timepoint = timepoint;
+            if (timepoint <= now)
+            {
+                const uint64_t value = 1;
+
+                [[maybe_unused]] const auto res = ::write(m_event_fd, &value, sizeof(value));
+                return;
+            }
+
+            set_timer(timepoint);
+        }
+
+        /**
+         * @brief Make eventfd readable without touching armed timepoint. Unlike other methods can be called from any thread.
+         */
+        void notify() const
+        {
+            const uint64_t value = 1;
+
+            [[maybe_unused]] const auto res = ::write(m_event_fd, &value, sizeof(value));
+        }
+
+        /**
+         * @brief Make descriptors non-readable and forget armed timepoint
+         */
+        void reset()
+        {
+            uint64_t                    value{};
+            [[maybe_unused]] const auto event_res = ::read(m_event_fd, &value, sizeof(value));
+            [[maybe_unused]] const auto timer_res = ::read(m_timer_fd, &value, sizeof(value));
+
+            if (m_armed_timepoint != time_point::max())
+                set_timer(time_point{});
+            m_armed_timepoint = time_point::max();
+        }
+
+    private:
+        // steady_clock is CLOCK_MONOTONIC on linux, zero timepoint disarms timer
+        void set_timer(time_point timepoint) const
+        {
+            const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(timepoint.time_since_epoch()).count();
+            itimerspec spec{};
+            spec.it_value.tv_sec  = static_cast<time_t>(since_epoch / 1'000'000'000);
+            spec.it_value.tv_nsec = static_cast<long>(since_epoch % 1'000'000'000);
+            ::timerfd_settime(m_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+        }
+
+        void close() noexcept
+        {
+            if (m_event_fd >= 0)
+                ::close(m_event_fd);
+            if (m_timer_fd >= 0)
+                ::close(m_timer_fd);
+        }
+
+    private:
+        const int  m_event_fd;
+        const int  m_timer_fd;
+        time_point m_armed_timepoint{time_point::max()};
+    };
+#endif
+} // namespace rpp::schedulers::details
@@ -0,0 +1,618 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/current_thread.hpp>
+#include <rpp/schedulers/details/clock.hpp>
+#include <rpp/schedulers/details/idle.hpp>
+#include <rpp/schedulers/details/queue.hpp>
+#include <rpp/schedulers/details/thread_settings.hpp>
+#include <rpp/schedulers/metrics.hpp>
+#include <rpp/utils/utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rpp::schedulers::details
+{
+    class work_stealing_strand;
+
+    /**
+     * @brief Shared state of work-stealing pool: per-thread deques of ready strands, timers for delayed strands and sleeping logic.
+     * @details Each thread pops strands from its own deque. Idle thread steals strands from deques of other threads. Strand is serial queue of schedulables of one worker, so, only one thread executes it at any time.
+     * Amount of threads can be changed in runtime: new strands are submitted only to first `threads_count()` threads, threads removed from pool finish strands already queued to them and exit.
+     */
+    class work_stealing_state final
+    {
+    public:
+        explicit work_stealing_state(idle_strategy strategy = idle_strategy::blocking, priority_policy policy = priority_policy::strict, execution_budget budget = {})
+            : m_idle_strategy{strategy}
+            , m_priority_policy{policy}
+            , m_budget{budget}
+        {
+        }
+
+        size_t threads_count() const { return m_active.load(std::memory_order::seq_cst); }
+
+        /**
+         * @brief Change amount of threads used by pool.
+         * @return indexes of threads which have to be started by caller. Expected to be called by one thread at any moment.
+         */
+        std::vector<size_t> resize(size_t threads_count);
+
+        // marks thread returned by `resize` as not started
+        void on_thread_not_started(size_t index)
+        {
+            std::lock_guard lock{m_mutex};
+            m_alive[index] = false;
+        }
+
+        /**
+         * @brief Metrics of thread executing strands right now: each thread of pool reports its executions separately
+         */
+        const metrics_hook& get_thread_metrics() const { return m_queues[get_current().index].metrics; }
+
+        /**
+         * @brief Metrics reporting depth of queue of new strand. Strand is not bound to thread, so, its depth is reported by threads of pool in round-robin order.
+         */
+        const metrics_hook& get_strand_metrics() { return m_queues[m_next_queue.fetch_add(1, std::memory_order::relaxed) % threads_count()].metrics; }
+
+        priority_policy get_priority_policy() const { return m_priority_policy; }
+
+        const execution_budget& get_budget() const { return m_budget; }
+
+        void submit(std::shared_ptr<work_stealing_strand>&& strand);
+
+        void add_timer(time_point timepoint, std::shared_ptr<work_stealing_strand>&& strand, size_t epoch);
+
+        void stop()
+        {
+            {
+                std::lock_guard lock{m_mutex};
+                m_stopping = true;
+            }
+            m_cv.notify_all();
+        }
+
+        static void thread_loop(const std::shared_ptr<work_stealing_state>& state, size_t index);
+
+    private:
+        struct local_queue
+        {
+            std::mutex                                        mutex{};
+            std::deque<std::shared_ptr<work_stealing_strand>> strands{};
+            // set once before start of thread
+            metrics_hook metrics{};
+        };
+
+        /**
+         * @brief Queues of threads stored by chunks of doubling size: growing of pool never moves queues accessed by running threads.
+         */
+        class local_queues
+        {
+        public:
+            local_queue& operator[](size_t index) const
+            {
+                const auto chunk = static_cast<size_t>(std::bit_width(index + 1)) - 1;
+                return m_chunks[chunk][index + 1 - (size_t{1} << chunk)];
+            }
+
+            // not thread-safe: new size has to be published to other threads after this call
+            void reserve(size_t count)
+            {
+                while (m_capacity < count)
+                {
+                    const auto chunk = static_cast<size_t>(std::bit_width(m_capacity + 1)) - 1;
+                    m_chunks[chunk]  = std::make_unique<local_queue[]>(size_t{1} << chunk);
+                    m_capacity += size_t{1} << chunk;
+                }
+            }
+
+        private:
+            std::array<std::unique_ptr<local_queue[]>, std::numeric_limits<size_t>::digits> m_chunks{};
+            size_t                                                                          m_capacity{};
+        };
+
+        struct timer
+        {
+            time_point                            timepoint;
+            std::shared_ptr<work_stealing_strand> strand;
+            size_t                                epoch;
+
+            bool operator>(const timer& other) const { return timepoint > other.timepoint; }
+        };
+
+        struct current_context
+        {
+            const work_stealing_state* state{};
+            size_t                     index{};
+        };
+
+        static current_context& get_current()
+        {
+            thread_local current_context s_context{};
+            return s_context;
+        }
+
+        std::shared_ptr<work_stealing_strand> fetch(size_t index);
+
+        std::shared_ptr<work_stealing_strand> pop(size_t index, bool front);
+
+        void fire_due_timers(size_t index);
+
+        bool is_active(size_t index) const { return index < m_active.load(std::memory_order::seq_cst); }
+
+        // returns true if thread removed from pool can exit
+        bool retire(size_t index);
+
+        bool spin_for_work(size_t index) const;
+
+        bool wait(size_t index);
+
+        void notify_sleeper()
+        {
+            if (m_sleepers.load(std::memory_order::seq_cst) == 0)
+                return;
+
+            std::lock_guard lock{m_mutex};
+            m_cv.notify_one();
+        }
+
+    private:
+        local_queues       m_queues{};
+        std::atomic_size_t m_active{};
+        // amount of queues ever used by pool: removed threads can still have strands in their queues, so, they are available for stealing
+        std::atomic_size_t m_spawned{};
+        std::atomic_size_t m_pending{};
+        std::atomic_size_t m_sleepers{};
+        std::atomic_size_t m_next_queue{};
+
+        std::mutex                                                          m_mutex{};
+        std::condition_variable                                             m_cv{};
+        std::priority_queue<timer, std::vector<timer>, std::greater<timer>> m_timers{};
+        std::atomic<time_point::rep>                                        m_earliest_timer{time_point::max().time_since_epoch().count()};
+        std::atomic_bool                                                    m_stopping{};
+        std::vector<bool>                                                   m_alive{};
+        const idle_strategy                                                 m_idle_strategy;
+        const priority_policy                                               m_priority_policy;
+        const execution_budget                                              m_budget;
+    };
+
+    /**
+     * @brief Serial queue of schedulables for one worker of work-stealing pool.
+     * @details Strand is submitted to the pool only when it has ready schedulable and it is not submitted yet. As a result, all schedulables of the same worker are executed one-by-one in the same order as for `new_thread`, but thread executing them can differ.
+     */
+    class work_stealing_strand final : public shared_queue_data
+        , public std::enable_shared_from_this<work_stealing_strand>
+    {
+        enum class status : uint8_t
+        {
+            idle,
+            waiting,
+            ready
+        };
+
+        struct private_tag
+        {
+        };
+
+    public:
+        // max amount of schedulables executed by thread before re-submitting of strand back to the pool to let other strands run
+        static constexpr size_t s_max_schedulables_per_run = 64;
+
+        work_stealing_strand(private_tag, std::shared_ptr<work_stealing_state> state)
+            : m_pool{std::move(state)}
+        {
+        }
+
+        static std::shared_ptr<work_stealing_strand> create(std::shared_ptr<work_stealing_state> state)
+        {
+            auto strand     = std::make_shared<work_stealing_strand>(private_tag{}, std::move(state));
+            strand->m_queue = schedulables_queue<current_thread::worker_strategy>{std::weak_ptr<shared_queue_data>{strand}};
+            strand->m_queue.set_metrics(strand->m_pool->get_strand_metrics());
+            strand->m_queue.set_priority_policy(strand->m_pool->get_priority_policy());
+            return strand;
+        }
+
+        template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+        void defer_to(time_point timepoint, Fn&& fn, Handler&& handler, Args&&... args)
+        {
+            std::unique_lock lock{mutex};
+            m_queue.emplace(timepoint, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            m_has_fresh_data.store(true);
+
+            if (m_status == status::ready)
+                return;
+
+            const auto top_timepoint = m_queue.top()->get_timepoint();
+            if (m_status == status::waiting && m_wake_up_timepoint <= top_timepoint)
+                return;
+
+            ++m_epoch;
+            if (top_timepoint <= current_thread::worker_strategy::now())
+            {
+                m_status = status::ready;
+                lock.unlock();
+                m_pool->submit(shared_from_this());
+                return;
+            }
+
+            m_status            = status::waiting;
+            m_wake_up_timepoint = top_timepoint;
+            const auto epoch    = m_epoch;
+            lock.unlock();
+            m_pool->add_timer(top_timepoint, shared_from_this(), epoch);
+        }
+
+        bool on_timer(size_t epoch)
+        {
+            std::lock_guard lock{mutex};
+            if (m_status != status::waiting || m_epoch != epoch)
+                return false;
+
+            m_status = status::ready;
+            return true;
+        }
+
+        void run()
+        {
+            current_thread::get_queue() = &m_queue;
+            const rpp::utils::finally_action _{[] { current_thread::get_queue() = nullptr; }};
+            const now_cache::scope           now_scope{};
+            execution_budget_tracker         budget{m_pool->get_budget()};
+
+            for (size_t i = 0; i < s_max_schedulables_per_run && !budget.is_exhausted(); ++i)
+            {
+                now_cache::tick();
+
+                std::unique_lock lock{mutex};
+                if (m_queue.is_empty())
+                {
+                    m_status = status::idle;
+                    return;
+                }
+
+                if (m_queue.top()->is_disposed())
+                {
+                    m_queue.pop();
+                    continue;
+                }
+
+                if (const auto timepoint = m_queue.top()->get_timepoint(); current_thread::worker_strategy::now() < timepoint)
+                {
+                    m_status            = status::waiting;
+                    m_wake_up_timepoint = timepoint;
+                    const auto epoch    = ++m_epoch;
+                    lock.unlock();
+                    m_pool->add_timer(timepoint, shared_from_this(), epoch);
+                    return;
+                }
+
+                auto top = m_queue.pop();
+                m_has_fresh_data.store(!m_queue.is_empty());
+                lock.unlock();
+
+                const auto execution_metrics = m_pool->get_thread_metrics().on_execution(*top);
+                while (true)
+                {
+                    const auto res = top->make_advanced_call();
+                    // budget is shared by all schedulables of this run, so, exhausted budget lets other strands of this thread run
+                    const bool has_budget = budget.consume();
+                    if (res && !top->is_disposed())
+                    {
+                        if (has_budget && res->can_run_immediately() && !m_has_fresh_data.load())
+                            continue;
+
+                        const auto tp = top->handle_advanced_call(res.value());
+                        m_queue.emplace(tp, std::move(top));
+                    }
+                    break;
+                }
+            }
+
+            // strand is still "ready", so, just let other strands of this thread to be executed before
+            m_pool->submit(shared_from_this());
+        }
+
+    private:
+        std::shared_ptr<work_stealing_state>                m_pool;
+        schedulables_queue<current_thread::worker_strategy> m_queue{};
+        std::atomic_bool                                    m_has_fresh_data{};
+        status                                              m_status{status::idle};
+        size_t                                              m_epoch{};
+        time_point                                          m_wake_up_timepoint{};
+    };
+
+    inline void work_stealing_state::submit(std::shared_ptr<work_stealing_strand>&& strand)
+    {
+        const auto& current = get_current();
+        const auto  index   = current.state == this && is_active(current.index) ? current.index : m_next_queue.fetch_add(1, std::memory_order::relaxed) % threads_count();
+
+        // increment before push to be sure that counter is never less than actual amount of strands
+        m_pending.fetch_add(1, std::memory_order::seq_cst);
+        {
+            std::lock_guard lock{m_queues[index].mutex};
+            m_queues[index].strands.push_back(std::move(strand));
+        }
+        notify_sleeper();
+    }
+
+    inline void work_stealing_state::add_timer(time_point timepoint, std::shared_ptr<work_stealing_strand>&& strand, size_t epoch)
+    {
+        std::lock_guard lock{m_mutex};
+        m_timers.push(timer{timepoint, std::move(strand), epoch});
+        if (m_timers.top().timepoint == timepoint)
+        {
+            m_earliest_timer.store(timepoint.time_since_epoch().count(), std::memory_order::seq_cst);
+            // sleeping thread could wait for later timepoint
+            m_cv.notify_one();
+        }
+    }
+
+    inline std::vector<size_t> work_stealing_state::resize(size_t threads_count)
+    {
+        threads_count = std::max(size_t{1}, threads_count);
+
+        std::vector<size_t> to_start{};
+        {
+            std::lock_guard lock{m_mutex};
+            m_queues.reserve(threads_count);
+            for (size_t i = m_spawned.load(std::memory_order::seq_cst); i < threads_count; ++i)
+                m_queues[i].metrics = metrics_hook{"thread_pool"};
+            if (m_alive.size() < threads_count)
+                m_alive.resize(threads_count);
+
+            // thread removed from pool could be still finishing its strands, so, it is just re-activated
+            for (size_t i = 0; i < threads_count; ++i)
+            {
+                if (!m_alive[i])
+                {
+                    m_alive[i] = true;
+                    to_start.push_back(i);
+                }
+            }
+
+            m_spawned.store(std::max(m_spawned.load(std::memory_order::seq_cst), threads_count), std::memory_order::seq_cst);
+            m_active.store(threads_count, std::memory_order::seq_cst);
+        }
+        // wake up removed threads to let them exit
+        m_cv.notify_all();
+        return to_start;
+    }
+
+    inline bool work_stealing_state::retire(size_t index)
+    {
+        std::lock_guard lock{m_mutex};
+        if (is_active(index))
+            return false;
+
+        {
+            std::lock_guard queue_lock{m_queues[index].mutex};
+            if (!m_queues[index].strands.empty())
+                return false;
+        }
+
+        m_alive[index] = false;
+        return true;
+    }
+
+    inline void work_stealing_state::thread_loop(const std::shared_ptr<work_stealing_state>& state, size_t index)
+    {
+        get_current() = {state.get(), index};
+
+        while (true)
+        {
+            if (!state->is_active(index))
+            {
+                // thread removed from pool finishes strands queued to it before exit, new strands are submitted to other threads
+                if (const auto strand = state->pop(index, true))
+                    strand->run();
+                else if (state->retire(index))
+                    break;
+            }
+            else if (const auto strand = state->fetch(index))
+                strand->run();
+            else if (state->spin_for_work(index))
+                continue;
+            else if (!state->wait(index))
+                break;
+        }
+
+        get_current() = {};
+    }
+
+    inline std::shared_ptr<work_stealing_strand> work_stealing_state::fetch(size_t index)
+    {
+        fire_due_timers(index);
+
+        if (auto strand = pop(index, true))
+            return strand;
+
+        const auto spawned = m_spawned.load(std::memory_order::seq_cst);
+        for (size_t i = 1; i < spawned; ++i)
+        {
+            if (auto strand = pop((index + i) % spawned, false))
+                return strand;
+        }
+        return {};
+    }
+
+    inline std::shared_ptr<work_stealing_strand> work_stealing_state::pop(size_t index, bool front)
+    {
+        auto& queue = m_queues[index];
+
+        std::lock_guard lock{queue.mutex};
+        if (queue.strands.empty())
+            return {};
+
+        std::shared_ptr<work_stealing_strand> result{};
+        if (front)
+        {
+            result = std::move(queue.strands.front());
+            queue.strands.pop_front();
+        }
+        else
+        {
+            result = std::move(queue.strands.back());
+            queue.strands.pop_back();
+        }
+        m_pending.fetch_sub(1, std::memory_order::seq_cst);
+        return result;
+    }
+
+    inline void work_stealing_state::fire_due_timers(size_t index)
+    {
+        if (m_earliest_timer.load(std::memory_order::seq_cst) > clock_source::now().time_since_epoch().count())
+            return;
+
+        std::vector<timer> fired{};
+        {
+            std::lock_guard lock{m_mutex};
+            const auto      now = current_thread::worker_strategy::now();
+            while (!m_timers.empty() && m_timers.top().timepoint <= now)
+            {
+                fired.push_back(m_timers.top());
+                m_timers.pop();
+            }
+            m_earliest_timer.store((m_timers.empty() ? time_point::max() : m_timers.top().timepoint).time_since_epoch().count(), std::memory_order::seq_cst);
+        }
+
+        for (auto& t : fired)
+        {
+            if (!t.strand->on_timer(t.epoch))
+                continue;
+
+            m_pending.fetch_add(1, std::memory_order::seq_cst);
+            std::lock_guard lock{m_queues[index].mutex};
+            m_queues[index].strands.push_back(std::move(t.strand));
+        }
+
+        if (fired.size() > 1)
+            notify_sleeper();
+    }
+
+    inline bool work_stealing_state::spin_for_work(size_t index) const
+    {
+        const auto deadline = time_point{time_point::duration{m_earliest_timer.load(std::memory_order::seq_cst)}};
+        return spin_until(m_idle_strategy, deadline, [&] { return m_pending.load(std::memory_order::seq_cst) > 0 || m_stopping.load() || !is_active(index); }) && !m_stopping.load();
+    }
+
+    inline bool work_stealing_state::wait(size_t index)
+    {
+        std::unique_lock lock{m_mutex};
+
+        m_sleepers.fetch_add(1, std::memory_order::seq_cst);
+        const rpp::utils::finally_action _{[this] { m_sleepers.fetch_sub(1, std::memory_order::seq_cst); }};
+
+        if (m_pending.load(std::memory_order::seq_cst) > 0 || !is_active(index))
+            return true;
+
+        if (m_timers.empty())
+        {
+            if (m_stopping)
+                return false;
+
+            m_cv.wait(lock, [&] { return m_pending.load(std::memory_order::seq_cst) > 0 || !m_timers.empty() || m_stopping || !is_active(index); });
+            return true;
+        }
+
+        const auto timepoint = m_timers.top().timepoint;
+        // wake up a bit earlier to spin till exact timepoint instead of oversleeping
+        const auto wake_up = m_idle_strategy == idle_strategy::blocking ? timepoint : timepoint - s_precise_sleep_margin;
+        if (const auto now = current_thread::worker_strategy::now(); now < wake_up)
+            m_cv.wait_for(lock, wake_up - now, [&] { return m_pending.load(std::memory_order::seq_cst) > 0 || m_timers.empty() || m_timers.top().timepoint != timepoint || !is_active(index); });
+
+        return true;
+    }
+
+    /**
+     * @brief Owner of threads of work-stealing pool. Pool is stopped when last owner is destroyed, but threads still drain all scheduled schedulables before exit.
+     */
+    class work_stealing_pool final
+    {
+    public:
+        /**
+         * @param settings settings applied to threads of pool: i-th thread uses `settings[i % settings.size()]`. Empty means default settings for all threads.
+         */
+        explicit work_stealing_pool(size_t threads_count, const std::vector<thread_settings>& settings = {}, idle_strategy strategy = idle_strategy::blocking, priority_policy policy = priority_policy::strict, execution_budget budget = {})
+            : m_state{std::make_shared<work_stealing_state>(strategy, policy, budget)}
+        {
+            try
+            {
+                resize(threads_count, settings);
+            }
+            catch (...)
+            {
+                // already started threads would finish as soon as there is no any work for them
+                m_state->stop();
+                throw;
+            }
+        }
+
+        work_stealing_pool(const work_stealing_pool&) = delete;
+        work_stealing_pool(work_stealing_pool&&)      = delete;
+
+        ~work_stealing_pool() noexcept
+        {
+            m_state->stop();
+        }
+
+        /**
+         * @brief Change amount of threads of pool in place: extra threads are started or last threads finish strands queued to them and exit. Strands are not bound to threads, so, all of them are spread over new set of threads.
+         * @details Expected to be called by one thread at any moment. In case of failure amount of threads is restored.
+         */
+        void resize(size_t threads_count, const std::vector<thread_settings>& settings = {})
+        {
+            const auto previous = m_state->threads_count();
+            const auto to_start = m_state->resize(threads_count);
+            for (size_t i = 0; i < to_start.size(); ++i)
+            {
+                try
+                {
+                    const auto index = to_start[i];
+                    start_thread(settings.empty() ? thread_settings{} : settings[index % settings.size()], [state = m_state, index] { work_stealing_state::thread_loop(state, index); }).detach();
+                }
+                catch (...)
+                {
+                    for (size_t j = i; j < to_start.size(); ++j)
+                        m_state->on_thread_not_started(to_start[j]);
+                    if (previous)
+                        m_state->resize(previous);
+                    throw;
+                }
+            }
+        }
+
+        size_t threads_count() const { return m_state->threads_count(); }
+
+        std::shared_ptr<work_stealing_strand> create_strand() const
+        {
+            return work_stealing_strand::create(m_state);
+        }
+
+    private:
+        std::shared_ptr<work_stealing_state> m_state;
+    };
+} // namespace rpp::schedulers::details
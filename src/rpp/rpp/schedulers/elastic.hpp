@@ -0,0 +1,234 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/details/thread_queue.hpp>
+#include <rpp/schedulers/details/worker.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rpp::schedulers
+{
+    /**
+     * @brief Scheduler which acts like `rpp::schedulers::new_thread`, but caches threads instead of creating new thread for each worker (same as "io" scheduler in other Rx implementations).
+     *
+     * @details Each `create_worker` call takes idle thread from the cache (or starts new one if cache is empty) and all schedulables of this worker are executed by this thread. When last copy of worker is destroyed and all its schedulables are processed, thread returns back to the cache and waits for the next worker up to `keep_alive` duration. After that thread finishes.
+     * In case of `max_threads` threads are busy already, new workers share already busy threads in round-robin manner.
+     *
+     * @par Example
+     * @snippet elastic.cpp elastic
+     *
+     * @ingroup schedulers
+     */
+    class elastic final
+    {
+        struct cached_thread
+        {
+            std::shared_ptr<details::thread_queue> queue = std::make_shared<details::thread_queue>(idle_strategy::blocking, priority_policy::strict, execution_budget{}, "elastic");
+            std::condition_variable                wake_up{};
+            size_t                                 workers_count{};
+            bool                                   is_parked{};
+        };
+
+        class state final : public std::enable_shared_from_this<state>
+        {
+        public:
+            state(size_t max_threads, duration keep_alive)
+                : m_max_threads{std::max(size_t{1}, max_threads)}
+                , m_keep_alive{keep_alive}
+            {
+            }
+
+            std::shared_ptr<cached_thread> acquire()
+            {
+                std::lock_guard lock{m_mutex};
+
+                if (!m_idle.empty())
+                {
+                    // last released thread is the "hottest" one
+                    auto thread = std::move(m_idle.back());
+                    m_idle.pop_back();
+
+                    thread->workers_count = 1;
+                    thread->is_parked     = false;
+                    thread->queue->restart();
+                    thread->wake_up.notify_one();
+                    m_busy.push_back(thread);
+                    return thread;
+                }
+
+                if (m_busy.size() >= m_max_threads)
+                {
+                    auto& thread = m_busy[m_next_busy++ % m_busy.size()];
+                    // thread can be released already, but still processing last schedulables
+                    if (thread->workers_count++ == 0)
+                        thread->queue->restart();
+                    return thread;
+                }
+
+                auto thread           = std::make_shared<cached_thread>();
+                thread->workers_count = 1;
+                m_busy.push_back(thread);
+                std::thread{&state::thread_loop, shared_from_this(), thread}.detach();
+                return thread;
+            }
+
+            void release(const std::shared_ptr<cached_thread>& thread)
+            {
+                std::lock_guard lock{m_mutex};
+                if (--thread->workers_count == 0)
+                    thread->queue->stop();
+            }
+
+            void stop()
+            {
+                std::lock_guard lock{m_mutex};
+                m_is_stopping = true;
+                for (const auto& thread : m_idle)
+                    thread->wake_up.notify_one();
+            }
+
+        private:
+            static void thread_loop(const std::shared_ptr<state>& self, const std::shared_ptr<cached_thread>& thread)
+            {
+                do
+                {
+                    thread->queue->run();
+                } while (self->park(thread));
+            }
+
+            // returns true if thread is acquired again by some worker
+            bool park(const std::shared_ptr<cached_thread>& thread)
+            {
+                std::unique_lock lock{m_mutex};
+                // thread was acquired again while it was processing last schedulables
+                if (thread->workers_count != 0)
+                    return true;
+
+                std::erase(m_busy, thread);
+                if (m_is_stopping)
+                    return false;
+
+                // worker can be acquired and released again before this thread wakes up, so, can't rely on workers_count there
+                thread->is_parked = true;
+                m_idle.push_back(thread);
+                thread->wake_up.wait_for(lock, m_keep_alive, [&] { return !thread->is_parked || m_is_stopping; });
+                if (!thread->is_parked)
+                    return true;
+
+                std::erase(m_idle, thread);
+                return false;
+            }
+
+        private:
+            std::mutex                                  m_mutex{};
+            std::vector<std::shared_ptr<cached_thread>> m_idle{};
+            std::vector<std::shared_ptr<cached_thread>> m_busy{};
+            size_t                                      m_next_busy{};
+            const size_t                                m_max_threads;
+            const duration                              m_keep_alive;
+            bool                                        m_is_stopping{};
+        };
+
+        class worker_handle final
+        {
+        public:
+            explicit worker_handle(std::shared_ptr<state> state)
+                : m_state{std::move(state)}
+                , m_thread{m_state->acquire()}
+            {
+            }
+
+            worker_handle(const worker_handle&) = delete;
+            worker_handle(worker_handle&&)      = delete;
+
+            ~worker_handle() noexcept
+            {
+                m_state->release(m_thread);
+            }
+
+            details::thread_queue& get_queue() const { return *m_thread->queue; }
+
+        private:
+            std::shared_ptr<state>         m_state;
+            std::shared_ptr<cached_thread> m_thread;
+        };
+
+        class owner final
+        {
+        public:
+            explicit owner(std::shared_ptr<state> state)
+                : m_state{std::move(state)}
+            {
+            }
+
+            owner(const owner&) = delete;
+            owner(owner&&)      = delete;
+
+            ~owner() noexcept
+            {
+                m_state->stop();
+            }
+
+            const std::shared_ptr<state>& get_state() const { return m_state; }
+
+        private:
+            std::shared_ptr<state> m_state;
+        };
+
+    public:
+        class worker_strategy
+        {
+        public:
+            explicit worker_strategy(const std::shared_ptr<state>& state)
+                : m_handle{std::make_shared<worker_handle>(state)}
+            {
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
+            {
+                m_handle->get_queue().defer_to(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            static rpp::schedulers::time_point now() { return details::now(); }
+
+        private:
+            std::shared_ptr<worker_handle> m_handle;
+        };
+
+        /**
+         * @param max_threads maximum amount of threads used by this scheduler at the same time. In case of all of them are busy, new workers share already busy threads.
+         * @param keep_alive duration idle thread waits for the new worker before finishing.
+         */
+        explicit elastic(size_t max_threads = std::numeric_limits<size_t>::max(), duration keep_alive = std::chrono::seconds{60})
+            : m_owner{std::make_shared<owner>(std::make_shared<state>(max_threads, keep_alive))}
+        {
+        }
+
+        rpp::schedulers::worker<worker_strategy> create_worker() const
+        {
+            return rpp::schedulers::worker<worker_strategy>{m_owner->get_state()};
+        }
+
+    private:
+        std::shared_ptr<owner> m_owner;
+    };
+} // namespace rpp::schedulers
@@ -0,0 +1,477 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/disposables/callback_disposable.hpp>
+#include <rpp/disposables/disposable_wrapper.hpp>
+#include <rpp/schedulers/current_thread.hpp>
+#include <rpp/schedulers/details/clock.hpp>
+#include <rpp/schedulers/details/mpsc_inbox.hpp>
+#include <rpp/schedulers/details/queue.hpp>
+#include <rpp/schedulers/details/utils.hpp>
+#include <rpp/schedulers/details/wakeup_fds.hpp>
+#include <rpp/schedulers/details/worker.hpp>
+#include <rpp/schedulers/metrics.hpp>
+#include <rpp/utils/utils.hpp>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <sys/prctl.h>
+    #include <unistd.h>
+#endif
+
+namespace rpp::schedulers
+{
+#if defined(__linux__)
+    /**
+     * @brief Scheduler with native linux event loop based on epoll: delayed schedulables are waited via timerfd, wakeups from other threads are done via eventfd. Additionally the same loop can watch file descriptors (see `rpp::source::from_fd`).
+     * @warning Same as `run_loop` it doesn't own any thread: you need to call `run` in some thread and `stop` to return from it.
+     *
+     * @details Schedulings from thread running the loop go directly to local queue, schedulings from other threads go via lock-free inbox and write to eventfd only if loop is sleeping in `epoll_wait`. Timerfd is armed to absolute timepoint of the earliest delayed schedulable, so, accuracy of timers is bounded by timer slack of thread instead of millisecond timeout of `epoll_wait` (timer slack is reduced to minimum during `run` by default).
+     * Ready schedulables are executed in rounds limited by `execution_budget`, watched file descriptors are polled between rounds, so, busy scheduler doesn't starve them.
+     *
+     * @par Example
+     * @snippet epoll_loop.cpp epoll_loop
+     *
+     * @ingroup schedulers
+     */
+    class epoll_loop final
+    {
+    public:
+        /**
+         * @brief Readiness of watched file descriptor: `events` is mask of epoll events (`EPOLLIN`, `EPOLLOUT`, `EPOLLHUP` and etc)
+         */
+        struct fd_event
+        {
+            int      fd;
+            uint32_t events;
+        };
+
+        struct options
+        {
+            // how loop selects among ready schedulables of different priorities (see `rpp::schedulers::prioritized`)
+            priority_policy priorities{priority_policy::strict};
+            // limit of executions in a row before polling watched file descriptors again
+            execution_budget budget{.max_items = 1024};
+            // reduce timer slack of thread calling `run` to wake up delayed schedulables as close to their timepoints as possible
+            bool precise_timers = true;
+        };
+
+    private:
+        class fd_watch_base
+        {
+        public:
+            virtual ~fd_watch_base() noexcept = default;
+
+            void cancel() { m_cancelled.store(true); }
+
+            bool is_disposed() const { return m_cancelled.load() || is_handler_disposed(); }
+
+            virtual void on_event(const fd_event& event) const         = 0;
+            virtual void on_error(const std::exception_ptr& err) const = 0;
+
+        private:
+            virtual bool is_handler_disposed() const = 0;
+
+        private:
+            std::atomic_bool m_cancelled{};
+        };
+
+        template<typename Fn, rpp::schedulers::constraint::schedulable_handler Handler>
+        class fd_watch final : public fd_watch_base
+        {
+        public:
+            template<typename TFn, typename THandler>
+            fd_watch(TFn&& fn, THandler&& handler)
+                : m_fn{std::forward<TFn>(fn)}
+                , m_handler{std::forward<THandler>(handler)}
+            {
+            }
+
+            void on_event(const fd_event& event) const override
+            {
+                try
+                {
+                    m_fn(m_handler, event);
+                }
+                catch (...)
+                {
+                    m_handler.on_error(std::current_exception());
+                }
+            }
+
+            void on_error(const std::exception_ptr& err) const override { m_handler.on_error(err); }
+
+        private:
+            bool is_handler_disposed() const override { return m_handler.is_disposed(); }
+
+        private:
+            RPP_NO_UNIQUE_ADDRESS Fn      m_fn;
+            RPP_NO_UNIQUE_ADDRESS Handler m_handler;
+        };
+
+        // handler of internal tasks of loop (e.g. registration of watches) which are never disposed
+        struct loop_task_handler
+        {
+            static bool is_disposed() { return false; }
+
+            static void on_error(const std::exception_ptr&) {}
+        };
+
+        // reduces timer slack of current thread (50us by default) to minimal one till end of scope
+        class timer_slack_scope
+        {
+        public:
+            explicit timer_slack_scope(bool enabled)
+                : m_previous{enabled ? ::prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0) : -1}
+            {
+                if (m_previous > 0)
+                    ::prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+            }
+
+            timer_slack_scope(const timer_slack_scope&) = delete;
+            timer_slack_scope(timer_slack_scope&&)      = delete;
+
+            ~timer_slack_scope() noexcept
+            {
+                if (m_previous > 0)
+                    ::prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(m_previous), 0, 0, 0);
+            }
+
+        private:
+            const int m_previous;
+        };
+
+        class state_t final
+        {
+            static constexpr size_t s_max_events = 64;
+
+        public:
+            explicit state_t(const options& opts)
+                : m_budget{opts.budget}
+                , m_precise_timers{opts.precise_timers}
+                , m_epoll_fd{::epoll_create1(EPOLL_CLOEXEC)}
+            {
+                if (m_epoll_fd < 0)
+                    throw std::system_error{errno, std::system_category(), "can't create epoll file descriptor"};
+
+                m_queue.set_metrics(m_metrics);
+                m_queue.set_priority_policy(opts.priorities);
+
+                for (const int fd : {m_fds.get_event_fd(), m_fds.get_timer_fd()})
+                {
+                    if (const auto error = control(EPOLL_CTL_ADD, fd, EPOLLIN))
+                    {
+                        ::close(m_epoll_fd);
+                        throw std::system_error{error, std::system_category(), "can't add wakeup file descriptors to epoll"};
+                    }
+                }
+            }
+
+            state_t(const state_t&) = delete;
+            state_t(state_t&&)      = delete;
+
+            ~state_t() noexcept { ::close(m_epoll_fd); }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point time_point, Fn&& fn, Handler&& handler, Args&&... args)
+            {
+                // schedulings from thread running the loop goes directly to local queue, other ones - via lock-free inbox
+                if (current_thread::get_queue() == &m_queue)
+                {
+                    m_queue.emplace(time_point, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                    return;
+                }
+
+                m_metrics.on_enqueued();
+                m_inbox.push(details::make_schedulable<current_thread::worker_strategy>(time_point, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...));
+
+                // wake up loop only if it is sleeping and nobody else woke up it already
+                if (m_is_sleeping.load() && m_is_sleeping.exchange(false))
+                    m_fds.notify();
+            }
+
+            void watch(int fd, uint32_t events, std::shared_ptr<fd_watch_base> watch)
+            {
+                defer_to(details::now(), [this, fd, events, watch = std::move(watch)](const loop_task_handler&) {
+                    add_watch(fd, events, watch);
+                    return optional_delay_from_now{};
+                },
+                         loop_task_handler{});
+            }
+
+            void unwatch(int fd, std::weak_ptr<fd_watch_base> watch)
+            {
+                defer_to(details::now(), [this, fd, watch = std::move(watch)](const loop_task_handler&) {
+                    remove_watch(fd, watch.lock());
+                    return optional_delay_from_now{};
+                },
+                         loop_task_handler{});
+            }
+
+            void stop()
+            {
+                m_is_stopping.store(true);
+                m_fds.notify();
+            }
+
+            void run()
+            {
+                // thread could already own current_thread's queue (e.g. loop is run from schedulable of current_thread), so, restore it on exit
+                auto* const                           previous_queue = std::exchange(current_thread::get_queue(), &m_queue);
+                const rpp::utils::finally_action      restore_queue{[previous_queue] { current_thread::get_queue() = previous_queue; }};
+                const details::now_cache::scope       now_scope{};
+                const timer_slack_scope               slack_scope{m_precise_timers};
+                std::array<epoll_event, s_max_events> events{};
+
+                while (!m_is_stopping.load())
+                {
+                    splice_inbox();
+                    const bool has_ready = execute_ready();
+                    const auto count     = wait(events, has_ready);
+                    for (size_t i = 0; i < count; ++i)
+                        handle_event(events[i]);
+                }
+
+                m_is_stopping.store(false);
+            }
+
+        private:
+            int control(int operation, int fd, uint32_t events) const
+            {
+                epoll_event event{};
+                event.events  = events;
+                event.data.fd = fd;
+                return ::epoll_ctl(m_epoll_fd, operation, fd, &event) == 0 ? 0 : errno;
+            }
+
+            void add_watch(int fd, uint32_t events, const std::shared_ptr<fd_watch_base>& watch)
+            {
+                if (watch->is_disposed())
+                    return;
+
+                auto& current = m_watches[fd];
+                if (current && !current->is_disposed())
+                {
+                    watch->on_error(std::make_exception_ptr(std::system_error{EEXIST, std::system_category(), "file descriptor is already watched by epoll_loop"}));
+                    return;
+                }
+
+                // disposed watch of the same fd could be not removed yet
+                auto error = control(current ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, events);
+                // kernel removes registration of closed fd by itself, so, fd re-used after closing needs to be added again
+                if (error == ENOENT)
+                    error = control(EPOLL_CTL_ADD, fd, events);
+
+                if (error)
+                {
+                    if (!current)
+                        m_watches.erase(fd);
+                    watch->on_error(std::make_exception_ptr(std::system_error{error, std::system_category(), "can't watch file descriptor by epoll_loop"}));
+                    return;
+                }
+                current = watch;
+            }
+
+            void remove_watch(int fd, const std::shared_ptr<fd_watch_base>& watch)
+            {
+                const auto it = m_watches.find(fd);
+                if (!watch || it == m_watches.end() || it->second != watch)
+                    return;
+
+                m_watches.erase(it);
+                control(EPOLL_CTL_DEL, fd, 0);
+            }
+
+            void splice_inbox()
+            {
+                m_inbox.drain([&](std::shared_ptr<details::schedulable_base>&& schedulable) {
+                    // moved from inbox to local queue which reports depth by itself
+                    m_metrics.on_dequeued();
+                    const auto timepoint = schedulable->get_timepoint();
+                    m_queue.emplace(timepoint, std::move(schedulable));
+                });
+            }
+
+            /**
+             * @return true if there are ready schedulables not executed due to budget
+             */
+            bool execute_ready()
+            {
+                details::execution_budget_tracker budget{m_budget};
+                while (!m_queue.is_empty())
+                {
+                    details::now_cache::tick();
+                    if (m_queue.top()->is_disposed())
+                    {
+                        m_queue.pop();
+                        continue;
+                    }
+
+                    if (details::now() < m_queue.top()->get_timepoint())
+                        return false;
+
+                    if (budget.is_exhausted())
+                        return true;
+
+                    auto       top               = m_queue.pop();
+                    const auto execution_metrics = m_metrics.on_execution(*top);
+                    if (const auto timepoint = (*top)())
+                        m_queue.emplace(timepoint.value(), std::move(top));
+                    budget.consume();
+                }
+                return false;
+            }
+
+            size_t wait(std::array<epoll_event, s_max_events>& events, bool has_ready)
+            {
+                // any waiting makes cached "now" outdated
+                details::now_cache::invalidate();
+
+                if (has_ready || !m_inbox.is_empty())
+                    return poll(events, 0);
+
+                if (!m_queue.is_empty())
+                    m_fds.arm(m_queue.top()->get_timepoint(), details::now());
+
+                m_is_sleeping.store(true);
+                // producer could push to inbox right before publishing of "sleeping" flag and skip waking up
+                const bool has_data = !m_inbox.is_empty() || m_is_stopping.load();
+                const auto count    = poll(events, has_data ? 0 : -1);
+                m_is_sleeping.store(false);
+                return count;
+            }
+
+            size_t poll(std::array<epoll_event, s_max_events>& events, int timeout) const
+            {
+                const int count = ::epoll_wait(m_epoll_fd, events.data(), static_cast<int>(events.size()), timeout);
+                // EINTR is handled by next iteration of loop
+                return count > 0 ? static_cast<size_t>(count) : 0;
+            }
+
+            void handle_event(const epoll_event& event)
+            {
+                const int fd = event.data.fd;
+                if (fd == m_fds.get_event_fd() || fd == m_fds.get_timer_fd())
+                {
+                    // timer is re-armed for current top schedulable by next iteration of loop
+                    m_fds.reset();
+                    return;
+                }
+
+                const auto it = m_watches.find(fd);
+                if (it == m_watches.end())
+                    return;
+
+                // watch can be disposed, but not removed yet. Also copy is needed due to watch can be removed during emission
+                const auto watch = it->second;
+                if (!watch->is_disposed())
+                    watch->on_event(fd_event{fd, event.events});
+            }
+
+        private:
+            const details::metrics_hook                                     m_metrics{"epoll_loop"};
+            details::schedulables_queue<current_thread::worker_strategy>    m_queue{};
+            details::mpsc_inbox<std::shared_ptr<details::schedulable_base>> m_inbox{};
+            details::wakeup_fds                                             m_fds{};
+            std::unordered_map<int, std::shared_ptr<fd_watch_base>>         m_watches{};
+            std::atomic_bool                                                m_is_stopping{};
+            std::atomic_bool                                                m_is_sleeping{};
+            const execution_budget                                          m_budget;
+            const bool                                                      m_precise_timers;
+            const int                                                       m_epoll_fd;
+        };
+
+    public:
+        class worker_strategy
+        {
+        public:
+            explicit worker_strategy(std::shared_ptr<state_t> state)
+                : m_state{std::move(state)}
+            {
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
+            {
+                m_state->defer_to(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            static rpp::schedulers::time_point now() { return details::now(); }
+
+        private:
+            std::shared_ptr<state_t> m_state;
+        };
+
+        epoll_loop()
+            : epoll_loop{options{}}
+        {
+        }
+
+        /**
+         * @throws std::system_error in case of epoll or wakeup file descriptors can't be created
+         */
+        explicit epoll_loop(const options& opts)
+            : m_state{std::make_shared<state_t>(opts)}
+        {
+        }
+
+        /**
+         * @brief Process schedulables and events of watched file descriptors in the current thread till `stop` request
+         */
+        void run() const { m_state->run(); }
+
+        /**
+         * @brief Request thread inside `run` to return as soon as possible. Not processed schedulables are kept for the next `run`. Can be called from any thread.
+         */
+        void stop() const { m_state->stop(); }
+
+        /**
+         * @brief Watch file descriptor: `fn(handler, fd_event)` is invoked by thread running the loop each time `fd` is ready for any of `events` till `handler` or returned disposable is disposed.
+         * @details Descriptor is level-triggered by default (add `EPOLLET` to `events` to change it), so, `fn` is expected to consume readiness (e.g. read available data). Errors of registration (e.g. the same fd is watched already) and exceptions of `fn` are passed to `handler.on_error`.
+         * @note Registration is done asynchronously by thread running the loop.
+         */
+        template<rpp::schedulers::constraint::schedulable_handler Handler, std::invocable<const std::decay_t<Handler>&, const fd_event&> Fn>
+        rpp::disposable_wrapper watch(int fd, uint32_t events, Fn&& fn, Handler&& handler) const
+        {
+            auto watch = std::make_shared<fd_watch<std::decay_t<Fn>, std::decay_t<Handler>>>(std::forward<Fn>(fn), std::forward<Handler>(handler));
+            m_state->watch(fd, events, watch);
+            return rpp::make_callback_disposable([state = std::weak_ptr{m_state}, watch = std::weak_ptr<fd_watch_base>{watch}, fd]() noexcept {
+                if (const auto locked = watch.lock())
+                    locked->cancel();
+                if (const auto locked = state.lock())
+                    locked->unwatch(fd, watch);
+            });
+        }
+
+        rpp::schedulers::worker<worker_strategy> create_worker() const
+        {
+            return rpp::schedulers::worker<worker_strategy>{m_state};
+        }
+
+    private:
+        std::shared_ptr<state_t> m_state;
+    };
+#endif
+} // namespace rpp::schedulers
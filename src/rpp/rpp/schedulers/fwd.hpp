@@ -15,6 +15,9 @@
 #include <rpp/utils/constraints.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
 
 namespace rpp::schedulers
@@ -79,6 +82,53 @@ namespace rpp::schedulers
     using optional_delay_from_now            = std::optional<delay_from_now>;
     using optional_delay_from_this_timepoint = std::optional<delay_from_this_timepoint>;
     using optional_delay_to                  = std::optional<delay_to>;
+
+    /**
+     * @brief Strategy used by thread of scheduler to wait for new schedulables or timepoint of next schedulable.
+     */
+    enum class idle_strategy : uint8_t
+    {
+        // park thread via condition variable immediately. Lowest CPU usage, but each new schedulable pays for full wake-up of thread
+        blocking,
+        // spin for a while, then yield for a while, then park thread. Near-term timepoints are awaited via spinning for precise wake-up
+        spin_yield_park,
+        // never park thread and busy-spin with cpu pause instead. Lowest latency, but occupies whole cpu core
+        busy_spin
+    };
+
+    /**
+     * @brief Priority class of schedulable inside worker's queue. Priority matters only for schedulables which are ready to be executed at the same time: schedulable with earlier timepoint is never delayed by not-ready one.
+     * @see rpp::schedulers::prioritized
+     */
+    enum class priority : uint8_t
+    {
+        high,
+        normal,
+        low
+    };
+
+    /**
+     * @brief How worker's queue selects next schedulable among ready schedulables of different priorities
+     */
+    enum class priority_policy : uint8_t
+    {
+        // ready schedulable with higher priority is always executed first. Lower priorities can starve
+        strict,
+        // ready priorities share executions in proportion 4:2:1 (high:normal:low), so, lower priorities are never starved
+        weighted
+    };
+
+    /**
+     * @brief Limit of executions in a row by worker's thread without returning to its queue.
+     * @details Schedulable re-scheduling itself immediately (e.g. `from_iterable` or recursive `delay_from_now{}`) is re-executed in-place while nothing else is scheduled to the same thread. As soon as budget is exhausted, re-scheduled schedulable is forced back through the queue, so, co-located schedulables (and other workers of `thread_pool` in `mode::work_stealing`) get a chance to run. By default budget is unlimited.
+     */
+    struct execution_budget
+    {
+        // max amount of executions in a row
+        size_t max_items = std::numeric_limits<size_t>::max();
+        // max duration of executions in a row
+        duration max_duration = duration::max();
+    };
 } // namespace rpp::schedulers
 
 namespace rpp::schedulers::details
@@ -159,9 +209,19 @@ namespace rpp::schedulers
     class immediate;
     class current_thread;
     class new_thread;
+    class elastic;
     class run_loop;
+#if defined(__linux__)
+    class epoll_loop;
+#endif
+    class shard_scheduler;
+    class virtual_time;
     class thread_pool;
     class computational;
+    class work_stealing_computational;
+
+    template<typename Scheduler>
+    class prioritized;
 
     namespace defaults
     {
@@ -73,7 +73,7 @@ namespace rpp::schedulers
                 details::immediate_scheduling_while_condition<worker_strategy>(duration, rpp::utils::return_true{}, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
             }
 
-            static rpp::schedulers::time_point now() { return rpp::schedulers::clock_type::now(); }
+            static rpp::schedulers::time_point now() { return details::clock_source::now(); }
         };
 
         static rpp::schedulers::worker<worker_strategy> create_worker()
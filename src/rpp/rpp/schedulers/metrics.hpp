@@ -0,0 +1,398 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/defs.hpp>
+#include <rpp/schedulers/details/heartbeat.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rpp::schedulers::metrics
+{
+    /**
+     * @brief Snapshot of histogram of durations with log2 buckets
+     */
+    struct histogram_snapshot
+    {
+        static constexpr size_t buckets_count = 64;
+
+        // 0-th bucket counts durations less than 1ns, i-th bucket counts durations in range [2^(i-1); 2^i) nanoseconds
+        std::array<uint64_t, buckets_count> buckets{};
+        uint64_t                            count{};
+        duration                            sum{};
+        duration                            max{};
+
+        static duration bucket_upper_bound(size_t bucket)
+        {
+            return bucket + 1 >= buckets_count ? duration::max() : duration{int64_t{1} << bucket};
+        }
+
+        duration mean() const { return count == 0 ? duration::zero() : sum / static_cast<int64_t>(count); }
+
+        /**
+         * @brief Approximate value of percentile: upper bound of bucket containing it, but not more than max value
+         * @param p percentile in range [0; 1]
+         */
+        duration percentile(double p) const
+        {
+            if (count == 0)
+                return duration::zero();
+
+            const auto target = std::max(uint64_t{1}, static_cast<uint64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count)));
+            uint64_t   seen{};
+            for (size_t i = 0; i < buckets_count; ++i)
+            {
+                seen += buckets[i];
+                if (seen >= target)
+                    return std::min(bucket_upper_bound(i), max);
+            }
+            return max;
+        }
+    };
+
+    /**
+     * @brief Snapshot of metrics of one worker thread/queue of some scheduler
+     */
+    struct worker_snapshot
+    {
+        // unique id of the worker's metrics during process lifetime
+        size_t id{};
+        // name of scheduler: "new_thread", "thread_pool", "elastic", "shard_scheduler", "epoll_loop", "run_loop" or "current_thread"
+        std::string scheduler{};
+        // amount of schedulables waiting for execution right now
+        size_t queue_depth{};
+        // amount of executed schedulables since creation of worker
+        uint64_t executed{};
+        // lag between timepoint schedulable was scheduled to and actual start of its execution
+        histogram_snapshot lag{};
+        // duration of execution of schedulables
+        histogram_snapshot runtime{};
+    };
+
+    /**
+     * @brief Is metrics collection enabled. It is opt-in feature enabled via `RPP_SCHEDULERS_ENABLE_METRICS=1` define: without it schedulers don't collect anything and have zero overhead.
+     */
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+} // namespace rpp::schedulers::metrics
+
+namespace rpp::schedulers::details
+{
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+    class atomic_histogram
+    {
+    public:
+        void record(duration value)
+        {
+            const auto ns = static_cast<uint64_t>(std::max(duration::zero(), value).count());
+            m_buckets[std::min<size_t>(static_cast<size_t>(std::bit_width(ns)), m_buckets.size() - 1)].fetch_add(1, std::memory_order::relaxed);
+            m_count.fetch_add(1, std::memory_order::relaxed);
+            m_sum.fetch_add(ns, std::memory_order::relaxed);
+
+            auto max = m_max.load(std::memory_order::relaxed);
+            while (max < ns && !m_max.compare_exchange_weak(max, ns, std::memory_order::relaxed))
+            {
+            }
+        }
+
+        metrics::histogram_snapshot get_snapshot() const
+        {
+            metrics::histogram_snapshot result{};
+            for (size_t i = 0; i < m_buckets.size(); ++i)
+                result.buckets[i] = m_buckets[i].load(std::memory_order::relaxed);
+            result.count = m_count.load(std::memory_order::relaxed);
+            result.sum   = duration{static_cast<int64_t>(m_sum.load(std::memory_order::relaxed))};
+            result.max   = duration{static_cast<int64_t>(m_max.load(std::memory_order::relaxed))};
+            return result;
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, metrics::histogram_snapshot::buckets_count> m_buckets{};
+        std::atomic<uint64_t>                                                         m_count{};
+        std::atomic<uint64_t>                                                         m_sum{};
+        std::atomic<uint64_t>                                                         m_max{};
+    };
+
+    /**
+     * @brief Metrics of one worker thread/queue. Updated by scheduler via relaxed atomics, read by `metrics::collect`.
+     */
+    class metrics_recorder
+    {
+    public:
+        metrics_recorder(size_t id, const char* scheduler)
+            : m_id{id}
+            , m_scheduler{scheduler}
+        {
+        }
+
+        void on_enqueued(size_t count) { m_depth.fetch_add(static_cast<int64_t>(count), std::memory_order::relaxed); }
+        void on_dequeued(size_t count) { m_depth.fetch_sub(static_cast<int64_t>(count), std::memory_order::relaxed); }
+
+        void on_executed(duration lag, duration runtime)
+        {
+            m_executed.fetch_add(1, std::memory_order::relaxed);
+            m_lag.record(lag);
+            m_runtime.record(runtime);
+        }
+
+        metrics::worker_snapshot get_snapshot() const
+        {
+            return metrics::worker_snapshot{.id          = m_id,
+                                            .scheduler   = m_scheduler,
+                                            .queue_depth = static_cast<size_t>(std::max(int64_t{}, m_depth.load(std::memory_order::relaxed))),
+                                            .executed    = m_executed.load(std::memory_order::relaxed),
+                                            .lag         = m_lag.get_snapshot(),
+                                            .runtime     = m_runtime.get_snapshot()};
+        }
+
+    private:
+        const size_t          m_id;
+        const char*           m_scheduler;
+        std::atomic<int64_t>  m_depth{};
+        std::atomic<uint64_t> m_executed{};
+        atomic_histogram      m_lag{};
+        atomic_histogram      m_runtime{};
+    };
+
+    /**
+     * @brief Global list of alive recorders
+     */
+    class metrics_registry
+    {
+    public:
+        static metrics_registry& instance()
+        {
+            static metrics_registry s_registry{};
+            return s_registry;
+        }
+
+        std::shared_ptr<metrics_recorder> create(const char* scheduler)
+        {
+            std::lock_guard lock{m_mutex};
+            auto            recorder = std::make_shared<metrics_recorder>(m_next_id++, scheduler);
+            m_recorders.push_back(recorder);
+            return recorder;
+        }
+
+        std::vector<metrics::worker_snapshot> collect()
+        {
+            std::vector<metrics::worker_snapshot> result{};
+
+            std::lock_guard lock{m_mutex};
+            std::erase_if(m_recorders, [&](const std::weak_ptr<metrics_recorder>& weak) {
+                const auto recorder = weak.lock();
+                if (!recorder)
+                    return true;
+                result.push_back(recorder->get_snapshot());
+                return false;
+            });
+            return result;
+        }
+
+    private:
+        std::mutex                                   m_mutex{};
+        std::vector<std::weak_ptr<metrics_recorder>> m_recorders{};
+        size_t                                       m_next_id{};
+    };
+#endif
+
+    /**
+     * @brief RAII measurement of execution of one schedulable
+     */
+    class execution_metrics_scope
+    {
+    public:
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+        template<typename Schedulable>
+        execution_metrics_scope(metrics_recorder* recorder, const char* scheduler, const Schedulable& schedulable)
+            : m_heartbeat{scheduler, schedulable}
+            , m_recorder{recorder}
+            , m_scheduled{schedulable.get_timepoint()}
+            , m_start{recorder ? clock_type::now() : time_point{}}
+        {
+        }
+
+        ~execution_metrics_scope() noexcept
+        {
+            if (m_recorder)
+                m_recorder->on_executed(m_start - m_scheduled, clock_type::now() - m_start);
+        }
+#else
+        template<typename Schedulable>
+        execution_metrics_scope(const char* scheduler, const Schedulable& schedulable)
+            : m_heartbeat{scheduler, schedulable}
+        {
+        }
+
+        ~execution_metrics_scope() noexcept {}
+#endif
+
+        execution_metrics_scope(const execution_metrics_scope&) = delete;
+        execution_metrics_scope(execution_metrics_scope&&)      = delete;
+
+    private:
+        RPP_NO_UNIQUE_ADDRESS heartbeat_scope m_heartbeat;
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+        metrics_recorder* m_recorder;
+        time_point        m_scheduled;
+        time_point        m_start;
+#endif
+    };
+
+    /**
+     * @brief Handle to metrics of worker owned by scheduler. Does nothing in case of metrics are disabled or handle is default-constructed.
+     */
+    class metrics_hook
+    {
+    public:
+        metrics_hook() = default;
+
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+        explicit metrics_hook(const char* scheduler)
+            : m_scheduler{scheduler}
+            , m_recorder{metrics_registry::instance().create(scheduler)}
+        {
+        }
+
+        void on_enqueued(size_t count = 1) const
+        {
+            if (m_recorder)
+                m_recorder->on_enqueued(count);
+        }
+
+        void on_dequeued(size_t count = 1) const
+        {
+            if (m_recorder)
+                m_recorder->on_dequeued(count);
+        }
+
+        template<typename Schedulable>
+        execution_metrics_scope on_execution(const Schedulable& schedulable) const
+        {
+            return execution_metrics_scope{m_recorder.get(), m_scheduler, schedulable};
+        }
+
+    private:
+        const char*                       m_scheduler{};
+        std::shared_ptr<metrics_recorder> m_recorder{};
+#else
+        constexpr explicit metrics_hook(const char* scheduler)
+            : m_scheduler{scheduler}
+        {
+        }
+
+        void on_enqueued(size_t = 1) const {}
+        void on_dequeued(size_t = 1) const {}
+
+        template<typename Schedulable>
+        execution_metrics_scope on_execution(const Schedulable& schedulable) const
+        {
+            return execution_metrics_scope{m_scheduler, schedulable};
+        }
+
+    private:
+        const char* m_scheduler{};
+#endif
+    };
+
+    /**
+     * @brief Tracks depth of one queue: in case of destruction of queue with pending schedulables they are excluded from depth of worker.
+     */
+    class queue_metrics
+    {
+    public:
+        queue_metrics() = default;
+
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+        explicit queue_metrics(metrics_hook hook)
+            : m_hook{std::move(hook)}
+        {
+        }
+
+        queue_metrics(queue_metrics&& other) noexcept
+            : m_hook{std::move(other.m_hook)}
+            , m_size{std::exchange(other.m_size, 0)}
+        {
+        }
+
+        queue_metrics& operator=(queue_metrics&& other) noexcept
+        {
+            if (this != &other)
+            {
+                m_hook.on_dequeued(m_size);
+                m_hook = std::move(other.m_hook);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        ~queue_metrics() noexcept { m_hook.on_dequeued(m_size); }
+
+        void on_enqueued()
+        {
+            ++m_size;
+            m_hook.on_enqueued();
+        }
+
+        void on_dequeued()
+        {
+            --m_size;
+            m_hook.on_dequeued();
+        }
+
+    private:
+        metrics_hook m_hook{};
+        size_t       m_size{};
+#else
+        constexpr explicit queue_metrics(const metrics_hook&) {}
+
+        void on_enqueued() {}
+        void on_dequeued() {}
+#endif
+    };
+} // namespace rpp::schedulers::details
+
+namespace rpp::schedulers::metrics
+{
+    /**
+     * @brief Collect snapshots of metrics of all alive workers of schedulers (`new_thread`, `thread_pool`, `run_loop` and `current_thread`)
+     * @details Snapshot is cheap and thread-safe: it can be scraped periodically by metrics exporter while schedulers are running.
+     * @note Returns empty vector in case of metrics are disabled (see `metrics::enabled`)
+     *
+     * @par Example
+     * @snippet metrics.cpp metrics
+     *
+     * @ingroup schedulers
+     */
+    inline std::vector<worker_snapshot> collect()
+    {
+#if defined(RPP_SCHEDULERS_ENABLE_METRICS) && RPP_SCHEDULERS_ENABLE_METRICS
+        return details::metrics_registry::instance().collect();
+#else
+        return {};
+#endif
+    }
+} // namespace rpp::schedulers::metrics
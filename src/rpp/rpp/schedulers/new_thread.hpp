@@ -12,11 +12,10 @@
 
 #include <rpp/disposables/details/base_disposable.hpp>
 #include <rpp/schedulers/current_thread.hpp>
+#include <rpp/schedulers/details/thread_queue.hpp>
+#include <rpp/schedulers/details/thread_settings.hpp>
 
-#include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
 #include <thread>
 
 namespace rpp::schedulers
@@ -25,6 +24,8 @@ namespace rpp::schedulers
      * @brief Scheduler which schedules invoking of schedulables to another thread via queueing tasks with priority to time_point and order
      * @warning Creates new thread for each "create_worker" call, but not for each schedule
      * @details This scheduler useful when we want to have separate thread for processing starting from some timepoint.
+     * By default thread is parked as soon as there is no ready schedulables. Use `new_thread::with(idle_strategy::spin_yield_park)` or `new_thread::with(idle_strategy::busy_spin)` to reduce latency of waking up at cost of CPU usage.
+     * Schedulable re-scheduling itself immediately occupies thread while nothing else is scheduled. Use `new_thread::with(strategy, execution_budget)` to bound how long it runs in a row before going back through the queue.
      * @ingroup schedulers
      */
     class new_thread
@@ -32,103 +33,43 @@ namespace rpp::schedulers
         class state_t final
         {
         public:
-            state_t() = default;
+            explicit state_t(idle_strategy strategy, const details::thread_settings& settings, priority_policy policy, execution_budget budget, const char* scheduler)
+                : m_queue{std::make_shared<details::thread_queue>(strategy, policy, budget, scheduler)}
+                , m_thread{details::start_thread(settings, [queue = m_queue] { queue->run(); })}
+            {
+            }
 
             ~state_t() noexcept
             {
                 if (!m_thread.joinable())
                     return;
 
-                {
-                    std::lock_guard lock{m_state->mutex};
-                    m_state->is_stoping = true;
-                }
-                m_state->cv.notify_all();
+                m_queue->stop();
                 m_thread.detach();
             }
 
             template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
             void defer_to(time_point time_point, Fn&& fn, Handler&& handler, Args&&... args)
             {
-                m_state->queue.emplace(time_point, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
-                m_state->has_fresh_data.store(true);
+                m_queue->defer_to(time_point, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
             }
 
         private:
-            struct queue_data : public details::shared_queue_data
-            {
-                details::schedulables_queue<current_thread::worker_strategy> queue{};
-                bool                                                         is_stoping{};
-                std::atomic_bool                                             has_fresh_data{false};
-            };
-
-            static void data_thread(std::shared_ptr<queue_data> state)
-            {
-                current_thread::get_queue() = &state->queue;
-
-                while (true)
-                {
-                    std::unique_lock lock{state->mutex};
-                    if (state->queue.is_empty() && state->is_stoping)
-                        break;
-
-                    state->cv.wait(lock, [&] { return !state->queue.is_empty() || state->is_stoping; });
-
-                    if (state->queue.is_empty())
-                        break;
-
-                    if (state->queue.top()->is_disposed())
-                    {
-                        state->queue.pop();
-                        continue;
-                    }
-
-                    if (details::s_last_now_time < state->queue.top()->get_timepoint())
-                    {
-                        if (const auto now = worker_strategy::now(); now < state->queue.top()->get_timepoint())
-                        {
-                            state->cv.wait_for(lock, state->queue.top()->get_timepoint() - now, [&] { return state->queue.top()->is_disposed() || worker_strategy::now() >= state->queue.top()->get_timepoint(); });
-                            continue;
-                        }
-                    }
-
-                    auto top = state->queue.pop();
-                    state->has_fresh_data.store(!state->queue.is_empty());
-                    lock.unlock();
-
-                    while (true)
-                    {
-                        if (const auto res = top->make_advanced_call())
-                        {
-                            if (!top->is_disposed())
-                            {
-                                if (res->can_run_immediately() && !state->has_fresh_data.load())
-                                    continue;
-
-                                const auto tp = top->handle_advanced_call(res.value());
-                                state->queue.emplace(tp, std::move(top));
-                            }
-                        }
-                        break;
-                    }
-                }
-
-                current_thread::get_queue() = nullptr;
-            }
-
-        private:
-            std::shared_ptr<queue_data> m_state = std::make_shared<queue_data>();
-
-            RPP_CALL_DURING_CONSTRUCTION(m_state->queue = details::schedulables_queue<current_thread::worker_strategy>(m_state));
-
-            std::thread m_thread{&data_thread, m_state};
+            std::shared_ptr<details::thread_queue> m_queue;
+            std::thread                            m_thread;
         };
 
     public:
         class worker_strategy
         {
         public:
-            worker_strategy() = default;
+            /**
+             * @param scheduler name of scheduler owning this worker reported via metrics
+             */
+            explicit worker_strategy(idle_strategy strategy = idle_strategy::blocking, const details::thread_settings& settings = {}, priority_policy policy = priority_policy::strict, execution_budget budget = {}, const char* scheduler = "new_thread")
+                : m_state{std::make_shared<state_t>(strategy, settings, policy, budget, scheduler)}
+            {
+            }
 
             template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
             void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
@@ -139,12 +80,44 @@ namespace rpp::schedulers
             static rpp::schedulers::time_point now() { return details::now(); }
 
         private:
-            std::shared_ptr<state_t> m_state = std::make_shared<state_t>();
+            std::shared_ptr<state_t> m_state;
+        };
+
+        /**
+         * @brief Scheduler creating threads of workers with custom idle strategy and execution budget. Obtained via `new_thread::with`.
+         */
+        class configured
+        {
+        public:
+            configured(idle_strategy strategy, execution_budget budget)
+                : m_idle_strategy{strategy}
+                , m_budget{budget}
+            {
+            }
+
+            rpp::schedulers::worker<worker_strategy> create_worker() const
+            {
+                return rpp::schedulers::worker<worker_strategy>{m_idle_strategy, details::thread_settings{}, priority_policy::strict, m_budget};
+            }
+
+        private:
+            idle_strategy    m_idle_strategy;
+            execution_budget m_budget;
         };
 
         static rpp::schedulers::worker<worker_strategy> create_worker()
         {
             return rpp::schedulers::worker<worker_strategy>{};
         }
+
+        /**
+         * @brief Create scheduler with custom settings of threads of its workers
+         * @param strategy strategy used by thread of each worker to wait for new schedulables
+         * @param budget limit of executions in a row of immediately re-scheduled schedulable by thread of each worker
+         */
+        static configured with(idle_strategy strategy, execution_budget budget = {})
+        {
+            return configured{strategy, budget};
+        }
     };
 } // namespace rpp::schedulers
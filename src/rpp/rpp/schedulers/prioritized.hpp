@@ -0,0 +1,86 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/details/utils.hpp>
+#include <rpp/schedulers/details/worker.hpp>
+
+namespace rpp::schedulers
+{
+    /**
+     * @brief Scheduler adaptor scheduling all schedulables of original scheduler with provided priority.
+     * @details Queue-based schedulers (`current_thread`, `new_thread`, `thread_pool`, `run_loop`, ...) execute ready schedulables of higher priority before ready schedulables of lower priority even if they were scheduled later (see `priority_policy`). Timepoints are still respected: priority doesn't make schedulable to be executed earlier than its timepoint. Other schedulers just ignore priority.
+     * @warning Priority is applied to all schedulables created by thread during scheduling via this scheduler. In case of original scheduler executes schedulable immediately (e.g. `immediate` or `current_thread` with empty queue), nested schedulings inherit priority too.
+     *
+     * @par Example
+     * @snippet prioritized.cpp prioritized
+     *
+     * @ingroup schedulers
+     */
+    template<typename Scheduler>
+    class prioritized final
+    {
+        using original_worker = rpp::schedulers::utils::get_worker_t<Scheduler>;
+
+    public:
+        class worker_strategy
+        {
+        public:
+            worker_strategy(original_worker&& worker, priority p)
+                : m_worker{std::move(worker)}
+                , m_priority{p}
+            {
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_for(duration duration, Fn&& fn, Handler&& handler, Args&&... args) const
+            {
+                const details::scheduling_priority_scope scope{m_priority};
+                m_worker.schedule(duration, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
+            {
+                const details::scheduling_priority_scope scope{m_priority};
+                m_worker.schedule(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            static rpp::schedulers::time_point now() { return original_worker::now(); }
+
+        private:
+            original_worker m_worker;
+            priority        m_priority;
+        };
+
+        template<typename TScheduler>
+            requires rpp::constraint::decayed_same_as<TScheduler, Scheduler>
+        prioritized(TScheduler&& scheduler, priority p)
+            : m_scheduler{std::forward<TScheduler>(scheduler)}
+            , m_priority{p}
+        {
+        }
+
+        rpp::schedulers::worker<worker_strategy> create_worker() const
+        {
+            return rpp::schedulers::worker<worker_strategy>{m_scheduler.create_worker(), m_priority};
+        }
+
+    private:
+        Scheduler m_scheduler;
+        priority  m_priority;
+    };
+
+    template<rpp::schedulers::constraint::scheduler Scheduler>
+    prioritized(Scheduler&&, priority) -> prioritized<std::decay_t<Scheduler>>;
+} // namespace rpp::schedulers
@@ -16,15 +16,29 @@
 #include <rpp/disposables/disposable_wrapper.hpp>
 #include <rpp/schedulers/current_thread.hpp>
 #include <rpp/schedulers/details/queue.hpp>
+#include <rpp/schedulers/details/wakeup_fds.hpp>
 #include <rpp/schedulers/details/worker.hpp>
+#include <rpp/schedulers/metrics.hpp>
 #include <rpp/utils/functors.hpp>
 
+#include <limits>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <vector>
+
 namespace rpp::schedulers
 {
     /**
      * @brief scheduler which schedules execution via queueing tasks, but execution of tasks should be manually dispatched
      * @warning you need manually dispatch events for this scheduler in some thread.
      *
+     * @details On linux run_loop can expose eventfd/timerfd pair via `get_wakeup_handle` to be dispatched from external epoll based loop without polling.
+     *
+     * @par Example
+     * @snippet run_loop.cpp wakeup_handle
+     *
      * @ingroup schedulers
      */
     class run_loop final
@@ -34,8 +48,25 @@ namespace rpp::schedulers
         class state_t final : public rpp::details::base_disposable
         {
         public:
+            state_t(bool enable_wakeup_fds, priority_policy policy)
+            {
+                m_queue.set_metrics(m_metrics);
+                m_queue.set_priority_policy(policy);
+
+                if (!enable_wakeup_fds)
+                    return;
+
+#if defined(__linux__)
+                m_wakeup_fds = std::make_unique<details::wakeup_fds>();
+#else
+                throw std::system_error{std::make_error_code(std::errc::not_supported), "run_loop's wakeup handle is supported only on linux"};
+#endif
+            }
+
             ~state_t() noexcept override { dispose(); }
 
+            const details::metrics_hook& get_metrics() const { return m_metrics; }
+
             template<typename... Args>
             void emplace_and_notify(time_point timepoint, Args&&... args)
             {
@@ -46,6 +77,7 @@ namespace rpp::schedulers
                     std::lock_guard lock{m_mutex};
                     m_queue.emplace(timepoint, std::forward<Args>(args)...);
                 }
+                arm_wakeup_fds(timepoint);
                 m_cv.notify_one();
             }
 
@@ -61,16 +93,56 @@ namespace rpp::schedulers
 
                     const auto now = worker_strategy::now();
                     if (is_any_ready_schedulable_unsafe(now))
-                        return m_queue.pop();
+                    {
+                        auto top = m_queue.pop();
+                        lock.unlock();
+                        rearm_wakeup_fds();
+                        return top;
+                    }
 
                     if (!wait)
+                    {
+                        lock.unlock();
+                        rearm_wakeup_fds();
                         break;
+                    }
 
                     m_cv.wait_for(lock, m_queue.top()->get_timepoint() - now, [&]() { return is_disposed() || !m_queue.is_empty() || m_queue.top()->get_timepoint() <= worker_strategy::now(); });
                 }
                 return {};
             }
 
+            /**
+             * @brief Extract schedulables ready at `now` (but not more than `max_items`) into `batch` under one lock
+             */
+            void pop_ready(size_t max_items, time_point now, std::vector<details::queued_schedulable>& batch)
+            {
+                std::lock_guard lock{m_mutex};
+                while (batch.size() < max_items && is_any_ready_schedulable_unsafe(now))
+                    batch.push_back(m_queue.pop_queued());
+            }
+
+            /**
+             * @brief Return not executed schedulables of batch back to their original positions and emplace re-scheduled ones under one lock
+             */
+            void restore_and_emplace(std::vector<details::queued_schedulable>& not_executed, std::vector<std::pair<time_point, std::shared_ptr<details::schedulable_base>>>& rescheduled)
+            {
+                if (not_executed.empty() && rescheduled.empty())
+                    return;
+
+                if (is_disposed())
+                    return;
+
+                {
+                    std::lock_guard lock{m_mutex};
+                    for (auto& schedulable : not_executed)
+                        m_queue.restore(std::move(schedulable));
+                    for (auto& [timepoint, schedulable] : rescheduled)
+                        m_queue.emplace(timepoint, std::move(schedulable));
+                }
+                m_cv.notify_one();
+            }
+
             bool is_any_ready_schedulable()
             {
                 std::lock_guard lock{m_mutex};
@@ -83,7 +155,47 @@ namespace rpp::schedulers
                 return m_queue.is_empty();
             }
 
+            /**
+             * @brief Make wakeup fds readable only when top schedulable is ready
+             * @details Syscalls are made outside of queue's lock to not block producers. Lock of wakeup fds is acquired before queue's lock, so, arming by producer is never overwritten by re-arming to later timepoint.
+             */
+            void rearm_wakeup_fds()
+            {
+#if defined(__linux__)
+                if (!m_wakeup_fds)
+                    return;
+
+                std::lock_guard           wakeup_lock{m_wakeup_mutex};
+                const auto                now = worker_strategy::now();
+                std::optional<time_point> timepoint{};
+                {
+                    std::lock_guard lock{m_mutex};
+                    if (!m_queue.is_empty())
+                        timepoint = is_any_ready_schedulable_unsafe(now) ? now : m_queue.top()->get_timepoint();
+                }
+
+                m_wakeup_fds->reset();
+                if (timepoint)
+                    m_wakeup_fds->arm(timepoint.value(), now);
+#endif
+            }
+
+#if defined(__linux__)
+            const details::wakeup_fds* get_wakeup_fds() const { return m_wakeup_fds.get(); }
+#endif
+
         private:
+            void arm_wakeup_fds([[maybe_unused]] time_point timepoint)
+            {
+#if defined(__linux__)
+                if (!m_wakeup_fds)
+                    return;
+
+                std::lock_guard wakeup_lock{m_wakeup_mutex};
+                m_wakeup_fds->arm(timepoint, worker_strategy::now());
+#endif
+            }
+
             bool is_any_ready_schedulable_unsafe(time_point now = worker_strategy::now()) const
             {
                 return !m_queue.is_empty() && (m_queue.top()->is_disposed() || m_queue.top()->get_timepoint() <= now);
@@ -95,14 +207,20 @@ namespace rpp::schedulers
                     std::lock_guard lock{m_mutex};
                     m_queue = details::schedulables_queue<worker_strategy>{};
                 }
+                rearm_wakeup_fds();
                 m_cv.notify_one();
             }
 
         private:
+            const details::metrics_hook                  m_metrics{"run_loop"};
             std::mutex                                   m_mutex{};
             details::schedulables_queue<worker_strategy> m_queue{};
 
             std::condition_variable m_cv{};
+#if defined(__linux__)
+            std::mutex                           m_wakeup_mutex{};
+            std::unique_ptr<details::wakeup_fds> m_wakeup_fds{};
+#endif
         };
 
         class worker_strategy
@@ -127,6 +245,49 @@ namespace rpp::schedulers
         };
 
     public:
+        /**
+         * @brief File descriptors to integrate run_loop into external epoll/poll based loop.
+         * @details Add both descriptors to epoll set (level-triggered `EPOLLIN`) and call `dispatch_all_ready` when any of them becomes readable. `event_fd` becomes readable when some schedulable is ready right now, `timer_fd` - exactly at timepoint of the earliest delayed schedulable. Dispatching resets descriptors and re-arms them for the next schedulable.
+         */
+        struct wakeup_handle
+        {
+            int event_fd;
+            int timer_fd;
+        };
+
+        struct options
+        {
+            // create eventfd/timerfd pair available via `get_wakeup_handle` (linux only)
+            bool enable_wakeup_handle = false;
+            // how run_loop selects among ready schedulables of different priorities (see `rpp::schedulers::prioritized`)
+            priority_policy priorities{priority_policy::strict};
+        };
+
+        run_loop()
+            : run_loop{options{}}
+        {
+        }
+
+        /**
+         * @throws std::system_error in case of wakeup handle is requested, but can't be created
+         */
+        explicit run_loop(options opts)
+            : m_state{std::make_shared<state_t>(opts.enable_wakeup_handle, opts.priorities)}
+        {
+        }
+
+        /**
+         * @return wakeup handle if run_loop created with `options::enable_wakeup_handle`, otherwise nullopt
+         */
+        std::optional<wakeup_handle> get_wakeup_handle() const
+        {
+#if defined(__linux__)
+            if (const auto* fds = m_state->get_wakeup_fds())
+                return wakeup_handle{fds->get_event_fd(), fds->get_timer_fd()};
+#endif
+            return std::nullopt;
+        }
+
         bool is_empty() const
         {
             return m_state->is_empty();
@@ -147,6 +308,61 @@ namespace rpp::schedulers
             dispatch_impl(true);
         }
 
+        /**
+         * @brief Dispatch all ready schedulables, but not more than `max_items` and till `deadline`.
+         * @details Ready schedulables are extracted from queue in batches under one lock, so, cost of locking is paid once per batch instead of once per schedulable. Only schedulables ready at the moment of call are dispatched: schedulables became ready during dispatching (for example, re-scheduled ones) are left for the next call, so, schedulable re-scheduling itself immediately can't make this call endless. Schedulables which were not dispatched due to `deadline` keep their original order.
+         * @note Doesn't wait for not-ready schedulables.
+         *
+         * @return amount of dispatched schedulables
+         */
+        size_t dispatch_all_ready(size_t max_items = std::numeric_limits<size_t>::max(), time_point deadline = time_point::max()) const
+        {
+            // cached "now" is not used to respect time budget precisely
+            const auto is_deadline_reached = [deadline] { return deadline != time_point::max() && details::clock_source::now() >= deadline; };
+            const auto now                 = worker_strategy::now();
+
+            const details::now_cache::scope                                                now_scope{};
+            size_t                                                                         dispatched{};
+            std::vector<details::queued_schedulable>                                       batch{};
+            std::vector<std::pair<time_point, std::shared_ptr<details::schedulable_base>>> rescheduled{};
+            while (dispatched < max_items && !is_deadline_reached())
+            {
+                m_state->pop_ready(max_items - dispatched, now, batch);
+                if (batch.empty())
+                    break;
+
+                auto it = batch.begin();
+                for (; it != batch.end() && !is_deadline_reached(); ++it)
+                {
+                    if (it->schedulable->is_disposed())
+                        continue;
+
+                    ++dispatched;
+                    details::now_cache::tick();
+                    const auto execution_metrics = m_state->get_metrics().on_execution(*it->schedulable);
+                    if (const auto timepoint = (*it->schedulable)())
+                        rescheduled.emplace_back(timepoint.value(), std::move(it->schedulable));
+                }
+
+                batch.erase(batch.begin(), it);
+                m_state->restore_and_emplace(batch, rescheduled);
+                batch.clear();
+                rescheduled.clear();
+            }
+            m_state->rearm_wakeup_fds();
+            return dispatched;
+        }
+
+        /**
+         * @brief Same as `dispatch_all_ready`, but dispatches ready schedulables for no longer than `duration` (e.g. time budget of frame)
+         *
+         * @return amount of dispatched schedulables
+         */
+        size_t dispatch_for(duration duration) const
+        {
+            return dispatch_all_ready(std::numeric_limits<size_t>::max(), worker_strategy::now() + duration);
+        }
+
         rpp::schedulers::worker<worker_strategy> create_worker() const
         {
             return rpp::schedulers::worker<worker_strategy>{m_state};
@@ -160,12 +376,14 @@ namespace rpp::schedulers
                 if (top->is_disposed())
                     return;
 
+                const details::now_cache::scope now_scope{};
+                const auto                      execution_metrics = m_state->get_metrics().on_execution(*top);
                 if (const auto timepoint = (*top)())
                     m_state->emplace_and_notify(timepoint.value(), std::move(top));
             }
         }
 
     private:
-        std::shared_ptr<state_t> m_state = std::make_shared<state_t>();
+        std::shared_ptr<state_t> m_state;
     };
 } // namespace rpp::schedulers
@@ -0,0 +1,333 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/details/mpsc_inbox.hpp>
+#include <rpp/schedulers/details/spsc_ring.hpp>
+#include <rpp/schedulers/details/thread_queue.hpp>
+#include <rpp/schedulers/details/thread_settings.hpp>
+#include <rpp/schedulers/details/worker.hpp>
+#include <rpp/utils/utils.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace rpp::schedulers
+{
+    /**
+     * @brief Scheduler with shard-per-core execution model: each shard is one thread (pinned to its own cpu by default) with its own queue and timers.
+     *
+     * @details Unlike `thread_pool` shards never share queues: worker is bound to exactly one shard for its whole lifetime, so, state of worker (and of keyed stream using `create_worker_for_key`) never crosses cpus.
+     * Schedulings from one shard to another one go via dedicated lock-free SPSC ring per pair of shards (created on first usage), overflowing ring falls back to unbounded list of the same pair preserving order of schedulings. Schedulings from other threads go via lock-free MPSC inbox of target shard. Schedulings from shard to itself go directly to its local queue.
+     *
+     * @par Example
+     * @snippet shard_scheduler.cpp shard_scheduler
+     *
+     * @ingroup schedulers
+     */
+    class shard_scheduler final
+    {
+        using ring = details::spsc_ring<std::shared_ptr<details::schedulable_base>>;
+
+        struct current_shard
+        {
+            uint64_t scheduler_id{};
+            size_t   index{};
+        };
+
+        static current_shard& get_current()
+        {
+            thread_local current_shard s_current{};
+            return s_current;
+        }
+
+        static uint64_t get_next_scheduler_id()
+        {
+            static std::atomic<uint64_t> s_id{};
+            return ++s_id;
+        }
+
+        // channels from other shards to owning one. i-th channel is written only by thread of i-th shard
+        class shard_inputs final
+        {
+            using schedulable_ptr = std::shared_ptr<details::schedulable_base>;
+
+            /**
+             * @brief Bounded SPSC ring plus unbounded overflow used when ring is full.
+             * @details Once producer pushed to overflow, it keeps pushing to overflow till consumer splices all of it. As a result, ring never contains values newer than ones in overflow, and order of schedulings of producer is preserved.
+             */
+            struct channel
+            {
+                explicit channel(size_t capacity)
+                    : values{capacity}
+                {
+                }
+
+                ring                                 values;
+                details::mpsc_inbox<schedulable_ptr> overflow{};
+                // amount of values spliced from `overflow` by consumer
+                std::atomic<size_t> spliced{};
+                // amount of values pushed to `overflow`. Accessed only by producer
+                size_t overflowed{};
+            };
+
+        public:
+            explicit shard_inputs(size_t shards_count)
+                : m_channels(shards_count)
+            {
+            }
+
+            shard_inputs(const shard_inputs&) = delete;
+            shard_inputs(shard_inputs&&)      = delete;
+
+            ~shard_inputs() noexcept
+            {
+                for (auto& c : m_channels)
+                    delete c.load();
+            }
+
+            /**
+             * @brief Can be called only from thread of `producer` shard
+             */
+            void push(size_t producer, size_t capacity, schedulable_ptr&& schedulable)
+            {
+                auto& c = get_channel(producer, capacity);
+                if (c.overflowed == c.spliced.load(std::memory_order_acquire) && c.values.try_push(schedulable))
+                    return;
+
+                ++c.overflowed;
+                c.overflow.push(std::move(schedulable));
+            }
+
+            bool is_empty() const
+            {
+                return std::ranges::all_of(m_channels, [](const std::atomic<channel*>& c) {
+                    const auto* ptr = c.load(std::memory_order_seq_cst);
+                    return !ptr || (ptr->values.is_empty() && ptr->overflow.is_empty());
+                });
+            }
+
+            template<typename Fn>
+            void drain(Fn&& fn)
+            {
+                for (auto& c : m_channels)
+                {
+                    auto* ptr = c.load(std::memory_order_acquire);
+                    if (!ptr)
+                        continue;
+
+                    // overflow is taken before ring, but spliced after it: ring has only older values than ones taken from overflow, but can obtain newer ones while it is drained
+                    ptr->overflow.drain([&](schedulable_ptr&& schedulable) { m_overflow.push_back(std::move(schedulable)); });
+                    ptr->values.drain(fn);
+                    if (m_overflow.empty())
+                        continue;
+
+                    for (auto& schedulable : m_overflow)
+                        fn(std::move(schedulable));
+                    ptr->spliced.fetch_add(m_overflow.size(), std::memory_order_release);
+                    m_overflow.clear();
+                }
+            }
+
+        private:
+            channel& get_channel(size_t producer, size_t capacity)
+            {
+                if (auto* c = m_channels[producer].load(std::memory_order_relaxed))
+                    return *c;
+
+                // seq_cst to be properly ordered with consumer's "sleeping" flag as well as pushes to channel itself
+                auto* c = new channel{capacity};
+                m_channels[producer].store(c, std::memory_order_seq_cst);
+                return *c;
+            }
+
+        private:
+            std::vector<std::atomic<channel*>> m_channels;
+            // values taken from overflow by consumer during drain
+            std::vector<schedulable_ptr> m_overflow{};
+        };
+
+        class shard final
+        {
+        public:
+            shard(uint64_t scheduler_id, size_t index, size_t shards_count, size_t ring_capacity, std::shared_ptr<details::thread_queue> queue, const details::thread_settings& settings)
+                : m_scheduler_id{scheduler_id}
+                , m_index{index}
+                , m_ring_capacity{ring_capacity}
+                , m_inputs{std::make_shared<shard_inputs>(shards_count)}
+                , m_queue{std::move(queue)}
+                , m_thread{details::start_thread(settings, [queue = m_queue, inputs = m_inputs, current = current_shard{scheduler_id, index}] {
+                    get_current() = current;
+                    queue->run(*inputs);
+                    get_current() = {};
+                })}
+            {
+            }
+
+            shard(const shard&) = delete;
+            shard(shard&&)      = delete;
+
+            ~shard() noexcept
+            {
+                if (!m_thread.joinable())
+                    return;
+
+                m_queue->stop();
+                m_thread.detach();
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args)
+            {
+                // other threads go via inbox, own thread - directly to local queue
+                const auto& current = get_current();
+                if (current.scheduler_id != m_scheduler_id || current.index == m_index)
+                {
+                    m_queue->defer_to(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                    return;
+                }
+
+                m_inputs->push(current.index, m_ring_capacity, details::make_schedulable<current_thread::worker_strategy>(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...));
+                m_queue->wake_up();
+            }
+
+        private:
+            const uint64_t                         m_scheduler_id;
+            const size_t                           m_index;
+            const size_t                           m_ring_capacity;
+            std::shared_ptr<shard_inputs>          m_inputs;
+            std::shared_ptr<details::thread_queue> m_queue;
+            std::thread                            m_thread;
+        };
+
+    public:
+        struct options
+        {
+            // amount of shards (and their threads). By default equals to amount of cpus available for the process
+            size_t shards_count = details::get_available_concurrency();
+            // pin thread of i-th shard to i-th cpu allowed for the process (linux only, ignored on other platforms)
+            bool pin_to_cpus = true;
+            // capacity of SPSC ring between each pair of shards. Schedulings overflowing ring go via slower unbounded list till ring is drained
+            size_t ring_capacity = 1024;
+            // strategy used by threads of shards to wait for new schedulables
+            idle_strategy idle{idle_strategy::blocking};
+            // how threads of shards select among ready schedulables of different priorities (see `rpp::schedulers::prioritized`)
+            priority_policy priorities{priority_policy::strict};
+            // limit of executions in a row by thread of shard before going back through the queue (see `rpp::schedulers::execution_budget`)
+            execution_budget budget{};
+        };
+
+        class worker_strategy
+        {
+        public:
+            explicit worker_strategy(std::shared_ptr<shard> shard)
+                : m_shard{std::move(shard)}
+            {
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
+            {
+                m_shard->defer_to(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            static rpp::schedulers::time_point now() { return details::now(); }
+
+        private:
+            std::shared_ptr<shard> m_shard;
+        };
+
+        shard_scheduler()
+            : shard_scheduler{options{}}
+        {
+        }
+
+        /**
+         * @throws std::system_error in case of threads can't be pinned to cpus
+         */
+        explicit shard_scheduler(const options& opts)
+            : m_state{std::make_shared<state>(opts)}
+        {
+        }
+
+        /**
+         * @brief Worker bound to the next shard in round-robin manner
+         */
+        rpp::schedulers::worker<worker_strategy> create_worker() const
+        {
+            return rpp::schedulers::worker<worker_strategy>{m_state->get_next()};
+        }
+
+        /**
+         * @brief Worker bound to shard with index `shard_id`
+         * @throws std::out_of_range in case of `shard_id` is not less than `shards_count()`
+         */
+        rpp::schedulers::worker<worker_strategy> create_worker(size_t shard_id) const
+        {
+            return rpp::schedulers::worker<worker_strategy>{m_state->get(shard_id)};
+        }
+
+        /**
+         * @brief Worker bound to shard selected by `hash` of some key: the same key is always processed by the same shard
+         */
+        rpp::schedulers::worker<worker_strategy> create_worker_for_key(size_t hash) const
+        {
+            return create_worker(get_shard_for_key(hash));
+        }
+
+        /**
+         * @brief Index of shard used by `create_worker_for_key` for provided `hash`
+         */
+        size_t get_shard_for_key(size_t hash) const
+        {
+            return rpp::utils::get_bucket_for_hash(hash, shards_count());
+        }
+
+        size_t shards_count() const { return m_state->shards_count(); }
+
+    private:
+        class state final
+        {
+        public:
+            explicit state(const options& opts)
+            {
+                const auto scheduler_id = get_next_scheduler_id();
+                const auto shards_count = std::max(size_t{1}, opts.shards_count);
+                const auto cpus         = opts.pin_to_cpus ? details::get_allowed_cpus() : std::vector<size_t>{};
+
+                m_shards.reserve(shards_count);
+                for (size_t i = 0; i < shards_count; ++i)
+                {
+                    const auto settings = cpus.empty() ? details::thread_settings{} : details::thread_settings{.cpus = {cpus[i % cpus.size()]}};
+                    m_shards.push_back(std::make_shared<shard>(scheduler_id, i, shards_count, opts.ring_capacity, std::make_shared<details::thread_queue>(opts.idle, opts.priorities, opts.budget, "shard_scheduler"), settings));
+                }
+            }
+
+            const std::shared_ptr<shard>& get_next() { return m_shards[m_next.fetch_add(1, std::memory_order::relaxed) % m_shards.size()]; }
+
+            const std::shared_ptr<shard>& get(size_t index) const { return m_shards.at(index); }
+
+            size_t shards_count() const { return m_shards.size(); }
+
+        private:
+            std::vector<std::shared_ptr<shard>> m_shards{};
+            std::atomic<size_t>                 m_next{};
+        };
+
+        std::shared_ptr<state> m_state;
+    };
+} // namespace rpp::schedulers
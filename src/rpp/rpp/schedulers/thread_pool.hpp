@@ -12,8 +12,14 @@
 
 #include <rpp/schedulers/fwd.hpp>
 
+#include <rpp/schedulers/details/thread_settings.hpp>
+#include <rpp/schedulers/details/work_stealing.hpp>
 #include <rpp/schedulers/new_thread.hpp>
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <variant>
 #include <vector>
 
 namespace rpp::schedulers
@@ -22,44 +28,102 @@ namespace rpp::schedulers
      * @brief Scheduler owning static thread pool of workers and using "some" thread from this pool on `create_worker` call
      * @warning Expected to use this scheduler as local variable to share same threads between different operators or as static variable
      *
+     * @details Pool supports two modes:
+     * - `mode::round_robin` (default) - each `create_worker` call returns worker bound to next thread of pool. All schedulables of this worker are executed by this thread.
+     * - `mode::work_stealing` - each worker owns its own serial queue of schedulables. Ready workers are queued into per-thread deques, and idle threads steal them from busy ones. Schedulables of the same worker are still executed one-by-one in scheduling order, but thread executing them can change over time.
+     *
+     * By default amount of threads equals to amount of cpus available for the process: `std::thread::hardware_concurrency()` limited by cpu affinity mask and cgroup v1/v2 CPU quota (so, pool doesn't oversubscribe cpus inside containers). Threads of pool can be pinned to cpus and use custom priority via `thread_pool::options`.
+     *
      * @par Examples
      * @snippet thread_pool.cpp thread_pool
+     * @snippet thread_pool.cpp work_stealing
+     * @snippet thread_pool.cpp thread_pool_options
      *
      * @ingroup schedulers
      */
     class thread_pool final
     {
-        using original_worker = decltype(new_thread::create_worker());
+        using original_worker = rpp::schedulers::worker<new_thread::worker_strategy>;
+
+        struct work_stealing_worker
+        {
+            std::shared_ptr<details::work_stealing_pool>   pool;
+            std::shared_ptr<details::work_stealing_strand> strand;
+        };
 
         class worker_strategy
         {
         public:
             worker_strategy(const original_worker& original_worker)
-                : m_original_worker{original_worker}
+                : m_worker{original_worker}
+            {
+            }
+
+            worker_strategy(work_stealing_worker&& work_stealing_worker)
+                : m_worker{std::move(work_stealing_worker)}
             {
             }
 
             template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
             void defer_for(duration duration, Fn&& fn, Handler&& handler, Args&&... args) const
             {
-                m_original_worker.schedule(duration, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                if (const auto* w = std::get_if<work_stealing_worker>(&m_worker))
+                    w->strand->defer_to(now() + duration, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                else
+                    std::get<original_worker>(m_worker).schedule(duration, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
             }
 
             template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
             void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
             {
-                m_original_worker.schedule(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                if (const auto* w = std::get_if<work_stealing_worker>(&m_worker))
+                    w->strand->defer_to(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+                else
+                    std::get<original_worker>(m_worker).schedule(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
             }
 
             static rpp::schedulers::time_point now() { return original_worker::now(); }
 
         private:
-            original_worker m_original_worker;
+            std::variant<original_worker, work_stealing_worker> m_worker;
         };
 
     public:
-        explicit thread_pool(size_t threads_count = std::thread::hardware_concurrency())
-            : m_state{std::make_shared<state>(threads_count)}
+        enum class mode : uint8_t
+        {
+            round_robin,
+            work_stealing
+        };
+
+        struct options
+        {
+            // amount of threads of pool. By default equals to amount of cpus available for the process
+            size_t threads_count = details::get_available_concurrency();
+            mode   pool_mode     = mode::round_robin;
+            // i-th thread of pool is pinned to cpus `cpu_affinity[i % cpu_affinity.size()]`. Empty means no pinning
+            std::vector<std::vector<size_t>> cpu_affinity{};
+            // nice value for threads of pool
+            std::optional<int> nice{};
+            // if set, threads of pool use SCHED_FIFO real-time policy with this priority
+            std::optional<int> fifo_priority{};
+            // strategy used by threads of pool to wait for new schedulables
+            idle_strategy idle{idle_strategy::blocking};
+            // how threads of pool select among ready schedulables of different priorities (see `rpp::schedulers::prioritized`)
+            priority_policy priorities{priority_policy::strict};
+            // limit of executions in a row by thread of pool before going back through the queue (see `rpp::schedulers::execution_budget`)
+            execution_budget budget{};
+        };
+
+        explicit thread_pool(size_t threads_count = details::get_available_concurrency(), mode pool_mode = mode::round_robin)
+            : thread_pool{options{.threads_count = threads_count, .pool_mode = pool_mode}}
+        {
+        }
+
+        /**
+         * @throws std::system_error in case of cpu affinity or priority can't be applied to threads (unsupported platform or not enough permissions)
+         */
+        explicit thread_pool(options opts)
+            : m_state{std::make_shared<state>(std::move(opts))}
         {
         }
 
@@ -68,23 +132,93 @@ namespace rpp::schedulers
             return rpp::schedulers::worker<worker_strategy>{m_state->get()};
         }
 
+        /**
+         * @brief Change amount of threads of pool in runtime.
+         * @details New amount is used for workers created after this call. Already created workers keep their threads till destruction, so, no any scheduled schedulable is lost: threads removed from pool are finished only after processing of all schedulables of their workers.
+         * In `mode::round_robin` extra threads are appended or last threads are removed from pool. In `mode::work_stealing` pool is resized in place: removed threads finish already queued schedulables and exit, schedulables of all workers (including already created ones) are executed by new set of threads, so, pool never runs more threads than requested for long.
+         *
+         * @throws std::system_error in case of cpu affinity or priority can't be applied to new threads
+         */
+        void resize(size_t threads_count) const { m_state->resize(threads_count); }
+
+        size_t threads_count() const { return m_state->threads_count(); }
+
     private:
         class state
         {
         public:
-            explicit state(size_t threads_count)
+            explicit state(options opts)
+                : m_options{std::move(opts)}
+            {
+                resize(m_options.threads_count);
+            }
+
+            worker_strategy get()
+            {
+                std::lock_guard lock{m_mutex};
+                if (m_work_stealing_pool)
+                    return work_stealing_worker{m_work_stealing_pool, m_work_stealing_pool->create_strand()};
+
+                return m_workers[m_index++ % m_workers.size()];
+            }
+
+            void resize(size_t threads_count)
             {
                 threads_count = std::max(size_t{1}, threads_count);
-                m_workers.reserve(threads_count);
-                for (size_t i = 0; i < threads_count; ++i)
-                    m_workers.emplace_back(new_thread::create_worker());
+
+                std::lock_guard lock{m_mutex};
+                if (m_options.pool_mode == mode::work_stealing)
+                {
+                    std::vector<details::thread_settings> settings{};
+                    for (size_t i = 0; i < threads_count && !is_default_settings(); ++i)
+                        settings.push_back(get_thread_settings(i));
+
+                    // strands are not bound to threads, so, pool is resized in place and strands of existing workers are spread over new set of threads
+                    if (!m_work_stealing_pool)
+                        m_work_stealing_pool = std::make_shared<details::work_stealing_pool>(threads_count, settings, m_options.idle, m_options.priorities, m_options.budget);
+                    else if (m_work_stealing_pool->threads_count() != threads_count)
+                        m_work_stealing_pool->resize(threads_count, settings);
+                }
+                else
+                {
+                    std::vector<original_worker> new_workers{};
+                    new_workers.reserve(threads_count);
+                    for (size_t i = 0; i < threads_count; ++i)
+                    {
+                        // thread removed from pool is finished when all its workers are destroyed
+                        if (i < m_workers.size())
+                            new_workers.push_back(m_workers[i]);
+                        else
+                            new_workers.emplace_back(m_options.idle, get_thread_settings(i), m_options.priorities, m_options.budget, "thread_pool");
+                    }
+                    m_workers = std::move(new_workers);
+                }
+
+                m_options.threads_count = threads_count;
+            }
+
+            size_t threads_count()
+            {
+                std::lock_guard lock{m_mutex};
+                return m_options.threads_count;
             }
 
-            const original_worker& get() { return m_workers[m_index++ % m_workers.size()]; }
+        private:
+            bool is_default_settings() const { return m_options.cpu_affinity.empty() && !m_options.nice && !m_options.fifo_priority; }
+
+            details::thread_settings get_thread_settings(size_t index) const
+            {
+                return details::thread_settings{.cpus          = m_options.cpu_affinity.empty() ? std::vector<size_t>{} : m_options.cpu_affinity[index % m_options.cpu_affinity.size()],
+                                                .nice          = m_options.nice,
+                                                .fifo_priority = m_options.fifo_priority};
+            }
 
         private:
-            std::vector<original_worker> m_workers{};
-            size_t                       m_index{};
+            std::mutex                                   m_mutex{};
+            options                                      m_options;
+            std::vector<original_worker>                 m_workers{};
+            std::shared_ptr<details::work_stealing_pool> m_work_stealing_pool{};
+            size_t                                       m_index{};
         };
 
         std::shared_ptr<state> m_state{};
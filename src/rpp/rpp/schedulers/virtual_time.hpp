@@ -0,0 +1,160 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/details/queue.hpp>
+#include <rpp/schedulers/details/worker.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace rpp::schedulers
+{
+    /**
+     * @brief Scheduler with virtual time: schedulables are executed as fast as possible in order of their timepoints, and time jumps directly to timepoint of the next schedulable instead of real waiting.
+     *
+     * @details Useful to run time-based pipelines (`interval`, `debounce`, `delay`, `timeout` and etc) over recorded data (e.g. backtesting): hours of data are processed in fraction of second while operators observe the same timings as in real time.
+     * Schedulables are executed only by thread calling `run`, `advance_to` or `advance_by`. Virtual time is tracked per thread: `now()` of workers (and so, of all operators using them) returns virtual time of the current thread, which is shared by all `virtual_time` schedulers used in this thread and starts from `time_point{}`.
+     * Unlike `test_scheduler` schedulables are not executed during scheduling, so, recursive schedulings don't grow stack, and queue is backed by the same pooled priority queue as other schedulers, so, millions of pending timers are cheap.
+     *
+     * @warning Not thread-safe: scheduling and driving of scheduler are expected from the same thread.
+     *
+     * @par Example
+     * @snippet virtual_time.cpp virtual_time
+     *
+     * @ingroup schedulers
+     */
+    class virtual_time final
+    {
+        class worker_strategy;
+
+        static time_point& get_current_time()
+        {
+            thread_local time_point s_now{};
+            return s_now;
+        }
+
+        class state_t final
+        {
+        public:
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void emplace(time_point timepoint, Fn&& fn, Handler&& handler, Args&&... args)
+            {
+                m_queue.emplace(timepoint, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            size_t run_until(time_point limit)
+            {
+                auto&  now = get_current_time();
+                size_t executed{};
+                while (!m_queue.is_empty() && m_queue.top()->get_timepoint() <= limit)
+                {
+                    auto top = m_queue.pop();
+                    if (top->is_disposed())
+                        continue;
+
+                    // schedulable re-scheduled to the past is executed at current time
+                    now = std::max(now, top->get_timepoint());
+                    ++executed;
+                    if (const auto timepoint = (*top)())
+                        m_queue.emplace(timepoint.value(), std::move(top));
+                }
+                return executed;
+            }
+
+            std::optional<time_point> get_next_timepoint() const
+            {
+                if (m_queue.is_empty())
+                    return std::nullopt;
+                return m_queue.top()->get_timepoint();
+            }
+
+            bool is_empty() const { return m_queue.is_empty(); }
+
+        private:
+            details::schedulables_queue<worker_strategy> m_queue{};
+        };
+
+        class worker_strategy
+        {
+        public:
+            explicit worker_strategy(const std::weak_ptr<state_t>& state)
+                : m_state{state}
+            {
+            }
+
+            template<rpp::schedulers::constraint::schedulable_handler Handler, typename... Args, constraint::schedulable_fn<Handler, Args...> Fn>
+            void defer_to(time_point tp, Fn&& fn, Handler&& handler, Args&&... args) const
+            {
+                if (const auto shared = m_state.lock())
+                    shared->emplace(tp, std::forward<Fn>(fn), std::forward<Handler>(handler), std::forward<Args>(args)...);
+            }
+
+            static rpp::schedulers::time_point now() { return get_current_time(); }
+
+        private:
+            std::weak_ptr<state_t> m_state;
+        };
+
+    public:
+        /**
+         * @brief Virtual time of the current thread
+         */
+        static rpp::schedulers::time_point now() { return get_current_time(); }
+
+        /**
+         * @brief Execute schedulables till queue becomes empty advancing virtual time to timepoint of each of them
+         * @warning Never returns in case of endless schedulings (e.g. `interval` without `take`), use `advance_to`/`advance_by` for them.
+         *
+         * @return amount of executed schedulables
+         */
+        size_t run() const { return m_state->run_until(time_point::max()); }
+
+        /**
+         * @brief Execute schedulables with timepoints not later than `timepoint` (including scheduled during this call) and set virtual time to `timepoint`.
+         * @note Virtual time never goes backward: `timepoint` earlier than `now()` executes only already due schedulables.
+         *
+         * @return amount of executed schedulables
+         */
+        size_t advance_to(time_point timepoint) const
+        {
+            const auto target   = std::max(now(), timepoint);
+            const auto executed = m_state->run_until(target);
+            get_current_time()  = target;
+            return executed;
+        }
+
+        /**
+         * @brief Same as `advance_to(now() + duration)`
+         *
+         * @return amount of executed schedulables
+         */
+        size_t advance_by(duration duration) const { return advance_to(now() + duration); }
+
+        /**
+         * @brief Timepoint of the earliest pending schedulable (disposed ones are counted too)
+         */
+        std::optional<time_point> get_next_timepoint() const { return m_state->get_next_timepoint(); }
+
+        bool is_empty() const { return m_state->is_empty(); }
+
+        rpp::schedulers::worker<worker_strategy> create_worker() const
+        {
+            return rpp::schedulers::worker<worker_strategy>{m_state};
+        }
+
+    private:
+        std::shared_ptr<state_t> m_state = std::make_shared<state_t>();
+    };
+} // namespace rpp::schedulers
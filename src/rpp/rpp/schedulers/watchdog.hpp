@@ -0,0 +1,151 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/schedulers/fwd.hpp>
+
+#include <rpp/schedulers/details/heartbeat.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace rpp::schedulers
+{
+    /**
+     * @brief Background thread detecting schedulables running longer than threshold (e.g. user's callback blocked inside `thread_pool` or `new_thread` worker and so stalled all other streams of this worker).
+     *
+     * @details Each thread executing schedulables of schedulers (`new_thread`, `thread_pool`, `run_loop`, `current_thread` and etc) publishes heartbeat on start and end of each schedulable. Watchdog samples heartbeats each `check_period` and reports execution lasting longer than `threshold` via `on_stall` callback exactly once. Callback is invoked from the watchdog's thread.
+     * Elapsed time is measured by watchdog itself to keep hot path free of clock reads, so, it is less than actual one by up to `check_period`.
+     * Nested executions (e.g. `current_thread` queue drained inside schedulable of `run_loop`) are reported as outer schedulable.
+     *
+     * @note It is opt-in feature enabled via `RPP_SCHEDULERS_ENABLE_WATCHDOG=1` define: without it schedulers don't publish heartbeats at all and watchdog doesn't start thread (see `watchdog::enabled`).
+     *
+     * @par Example
+     * @snippet watchdog.cpp watchdog
+     *
+     * @ingroup schedulers
+     */
+    class watchdog
+    {
+    public:
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;
+#endif
+
+        struct stall
+        {
+            // name of scheduler, the same as in metrics (e.g. "thread_pool")
+            std::string_view scheduler;
+            // id of thread's heartbeat, unique for process
+            size_t worker_id;
+            // thread executing schedulable
+            std::thread::id thread;
+            // name of type of scheduled function
+            std::string_view schedulable;
+            // time spent in execution of schedulable at the moment of detection
+            duration elapsed;
+        };
+
+        struct options
+        {
+            duration                          threshold    = std::chrono::milliseconds{100};
+            duration                          check_period = std::chrono::milliseconds{10};
+            std::function<void(const stall&)> on_stall{};
+        };
+
+        explicit watchdog(options opts)
+        {
+            if constexpr (enabled)
+            {
+                m_thread = std::thread{[this, opts = std::move(opts)] { run(opts); }};
+            }
+        }
+
+        watchdog(const watchdog&) = delete;
+        watchdog(watchdog&&)      = delete;
+
+        ~watchdog() noexcept
+        {
+            if (!m_thread.joinable())
+                return;
+
+            {
+                std::lock_guard lock{m_mutex};
+                m_stopped = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
+
+    private:
+        void run(const options& opts)
+        {
+#if defined(RPP_SCHEDULERS_ENABLE_WATCHDOG) && RPP_SCHEDULERS_ENABLE_WATCHDOG
+            struct execution
+            {
+                uint64_t   sequence;
+                time_point first_seen;
+                bool       reported;
+            };
+
+            // heartbeat id -> currently observed execution
+            std::unordered_map<size_t, execution> executions{};
+
+            std::unique_lock lock{m_mutex};
+            while (!m_cv.wait_for(lock, opts.check_period, [&] { return m_stopped; }))
+            {
+                lock.unlock();
+
+                const auto now     = clock_type::now();
+                const auto samples = details::heartbeat_registry::instance().collect();
+
+                std::erase_if(executions, [&](const auto& pair) {
+                    return std::none_of(samples.cbegin(), samples.cend(), [&](const auto& sample) { return sample.id == pair.first; });
+                });
+
+                for (const auto& sample : samples)
+                {
+                    auto [it, inserted] = executions.try_emplace(sample.id, execution{sample.sequence, now, false});
+                    if (!inserted && it->second.sequence != sample.sequence)
+                        it->second = execution{sample.sequence, now, false};
+
+                    const auto elapsed = now - it->second.first_seen;
+                    if (it->second.reported || elapsed < opts.threshold)
+                        continue;
+
+                    it->second.reported = true;
+                    if (opts.on_stall)
+                        opts.on_stall(stall{sample.scheduler ? sample.scheduler : std::string_view{}, sample.id, sample.thread, *sample.schedulable, elapsed});
+                }
+
+                lock.lock();
+            }
+#else
+            static_cast<void>(opts);
+#endif
+        }
+
+    private:
+        std::mutex              m_mutex{};
+        std::condition_variable m_cv{};
+        bool                    m_stopped{};
+        std::thread             m_thread{};
+    };
+} // namespace rpp::schedulers
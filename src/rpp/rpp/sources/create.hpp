@@ -45,6 +45,7 @@ namespace rpp::source
      * 1) observable must to emit emissions in serial way
      * 2) observable must not to call any callbacks after termination events - on_error/on_completed
      * @warning Keep in mind, obtained observer is non-copyable, but movable by default. So, prefer perfect-forwarding. In case of you need to copy observer, cast it it dynamic_observer via passing it as argument type or via as_dynamic() member function
+     * @note To honour demand of backpressured observer pass disposable overriding `rpp::interface_disposable::request` to `set_upstream` and emit no more values than requested via it.
      *
      * @tparam Type is type of values observable would emit
      * @tparam OnSubscribe is callback function to implement core logic of observable
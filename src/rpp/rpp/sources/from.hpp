@@ -12,6 +12,8 @@
 #include <rpp/sources/fwd.hpp>
 
 #include <rpp/defs.hpp>
+#include <rpp/disposables/details/base_disposable.hpp>
+#include <rpp/disposables/details/demand.hpp>
 #include <rpp/observables/observable.hpp>
 #include <rpp/operators/map.hpp>
 #include <rpp/schedulers/current_thread.hpp>
@@ -79,10 +81,96 @@ namespace rpp::details
         }
     };
 
+    /**
+     * @brief State of `from_iterable` subscribed by backpressured observer: values are emitted only while observer's demand is not satisfied.
+     * @details Emitting is resumed via worker by request which increases demand from zero. Disposable keeps itself alive while waiting for demand: self-reference is released as soon as nothing can resume emitting anymore (disposed, completed, failed or observer is disposed).
+     */
+    template<constraint::decayed_type PackedContainer, rpp::constraint::observer TObserver, typename Worker>
+    class from_iterable_backpressured_disposable final : public rpp::details::base_disposable
+        , public rpp::details::enable_wrapper_from_this<from_iterable_backpressured_disposable<PackedContainer, TObserver, Worker>>
+    {
+    public:
+        from_iterable_backpressured_disposable(TObserver&& in_observer, const PackedContainer& in_container, Worker&& in_worker)
+            : observer{std::move(in_observer)}
+            , container{in_container}
+            , worker{std::move(in_worker)}
+            , m_itr{std::cbegin(container)}
+        {
+        }
+
+        void keep_alive_till_disposed(std::shared_ptr<from_iterable_backpressured_disposable> self) { m_self = std::move(self); }
+
+        void request(size_t count) noexcept override
+        {
+            if (count == 0 || is_disposed())
+                return;
+
+            if (disposables::add_demand(m_requested, count) != 0)
+                return;
+
+            // demand was satisfied, so, nobody emits values right now
+            if (const auto self = disposable_wrapper_impl<from_iterable_backpressured_disposable>{this->wrapper_from_this()}.lock())
+            {
+                worker.schedule([](const from_iterable_backpressured_disposable_wrapper& wrapper) { return wrapper.disposable->emit_next(); },
+                                from_iterable_backpressured_disposable_wrapper{self});
+            }
+        }
+
+        RPP_NO_UNIQUE_ADDRESS TObserver       observer;
+        RPP_NO_UNIQUE_ADDRESS PackedContainer container;
+        RPP_NO_UNIQUE_ADDRESS Worker          worker;
+
+    private:
+        struct from_iterable_backpressured_disposable_wrapper
+        {
+            std::shared_ptr<from_iterable_backpressured_disposable> disposable{};
+
+            bool is_disposed() const { return disposable->is_disposed(); }
+
+            void on_error(const std::exception_ptr& err) const { disposable->observer.on_error(err); }
+        };
+
+        rpp::schedulers::optional_delay_from_now emit_next()
+        {
+            try
+            {
+                // emit in place while demand is not satisfied: rescheduling is needed only to resume after request
+                while (!observer.is_disposed())
+                {
+                    observer.on_next(utils::as_const(*m_itr));
+                    if (++m_itr == std::cend(container))
+                    {
+                        observer.on_completed();
+                        break;
+                    }
+
+                    if (!disposables::consume_demand(m_requested) || is_disposed())
+                        return std::nullopt;
+                }
+            }
+            catch (...)
+            {
+                observer.on_error(std::current_exception());
+            }
+
+            dispose();
+            return std::nullopt;
+        }
+
+        void base_dispose_impl(interface_disposable::Mode) noexcept override { m_self.reset(); }
+
+    private:
+        // accessed only by the one who emits values right now
+        decltype(std::cbegin(std::declval<const PackedContainer&>())) m_itr;
+        std::atomic_size_t                                            m_requested{};
+        std::shared_ptr<from_iterable_backpressured_disposable>       m_self{};
+    };
+
     template<constraint::decayed_type PackedContainer, schedulers::constraint::scheduler TScheduler>
     struct from_iterable_strategy
     {
     public:
+        // upstream disposable is passed only to backpressured observers: they reserve place for it by themselves
         using value_type                   = rpp::utils::iterable_value_t<PackedContainer>;
         using optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<0>;
 
@@ -100,7 +188,23 @@ namespace rpp::details
         template<constraint::observer_strategy<utils::iterable_value_t<PackedContainer>> Strategy>
         void subscribe(observer<utils::iterable_value_t<PackedContainer>, Strategy>&& obs) const
         {
-            if constexpr (std::same_as<TScheduler, schedulers::immediate>)
+            if constexpr (observer<utils::iterable_value_t<PackedContainer>, Strategy>::backpressured)
+            {
+                if (std::cbegin(container) == std::cend(container))
+                {
+                    obs.on_completed();
+                    return;
+                }
+
+                using disposable_t = from_iterable_backpressured_disposable<PackedContainer, observer<utils::iterable_value_t<PackedContainer>, Strategy>, schedulers::utils::get_worker_t<TScheduler>>;
+
+                const auto disposable = disposable_wrapper_impl<disposable_t>::make(std::move(obs), container, scheduler.create_worker());
+                auto       ptr        = disposable.lock();
+                ptr->keep_alive_till_disposed(ptr);
+                // observer requests values from inside of set_upstream or later
+                ptr->observer.set_upstream(disposable.as_weak());
+            }
+            else if constexpr (std::same_as<TScheduler, schedulers::immediate>)
             {
                 try
                 {
@@ -162,6 +266,8 @@ namespace rpp::source
            operator "from_iterable({1,2,3,5})": +-1-2-3-5-|
        }
      *
+     * @details Backpressured observer receives values only when requested them via upstream disposable: emitting is paused when demand is satisfied and resumed via scheduler by the next request.
+     *
      * @tparam memory_model rpp::memory_model strategy used to handle provided iterable
      * @param scheduler is scheduler used for scheduling of submissions: next item will be submitted to scheduler when previous one is executed
      * @param iterable container with values which will be flattened
@@ -0,0 +1,70 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#pragma once
+
+#include <rpp/sources/fwd.hpp>
+
+#include <rpp/defs.hpp>
+#include <rpp/disposables/disposable_wrapper.hpp>
+#include <rpp/observables/observable.hpp>
+#include <rpp/schedulers/epoll_loop.hpp>
+
+#include <cstdint>
+
+#if defined(__linux__)
+namespace rpp::details
+{
+    struct from_fd_strategy
+    {
+        using value_type                   = rpp::schedulers::epoll_loop::fd_event;
+        using optimal_disposables_strategy = rpp::details::observables::fixed_disposables_strategy<1>;
+
+        rpp::schedulers::epoll_loop loop;
+        int                         fd;
+        uint32_t                    events;
+
+        template<rpp::constraint::observer_of_type<value_type> TObs>
+        void subscribe(TObs&& observer) const
+        {
+            // observer is moved to loop, so, disposable has to be set beforehand
+            const auto disposable = rpp::composite_disposable_wrapper::make();
+            observer.set_upstream(rpp::disposable_wrapper{disposable});
+            disposable.add(loop.watch(
+                fd,
+                events,
+                [](const auto& obs, const value_type& event) { obs.on_next(event); },
+                std::forward<TObs>(observer)));
+        }
+    };
+} // namespace rpp::details
+
+namespace rpp::source
+{
+    /**
+     * @brief Creates rpp::observable that emits `fd_event` each time file descriptor is ready for any of `events` (level-triggered by default). Emissions are done by thread running provided `epoll_loop`.
+     * @details Observable never completes by itself: `EPOLLHUP`/`EPOLLERR` are emitted as part of `fd_event::events` and it is up to observer to dispose subscription (or close descriptor) in this case.
+     * Descriptor is removed from the loop on disposing of subscription. Only one subscription per descriptor is allowed at the same time, other ones receive `std::system_error`.
+     *
+     * @param loop loop used to watch descriptor and to emit events
+     * @param fd file descriptor to watch. Observer is expected to consume readiness (e.g. read available data) during emission
+     * @param events mask of epoll events (`EPOLLIN`, `EPOLLOUT`, `EPOLLET` and etc)
+     *
+     * @par Example:
+     * @snippet epoll_loop.cpp from_fd
+     *
+     * @ingroup creational_operators
+     */
+    inline auto from_fd(const rpp::schedulers::epoll_loop& loop, int fd, uint32_t events = EPOLLIN)
+    {
+        return rpp::observable<rpp::schedulers::epoll_loop::fd_event, details::from_fd_strategy>{loop, fd, events};
+    }
+} // namespace rpp::source
+#endif
@@ -33,4 +33,9 @@ namespace rpp::utils
     {
         using std::range_error::range_error;
     };
+
+    struct buffer_overflow : public std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
 } // namespace rpp::utils
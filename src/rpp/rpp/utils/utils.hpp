@@ -15,6 +15,8 @@
 #include <rpp/utils/tuple.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <variant>
 
@@ -112,6 +114,15 @@ namespace rpp::utils
     template<auto Fn>
     using static_not_mem_fn = static_mem_fn<Fn, true>;
 
+    /**
+     * @brief Index of bucket among `buckets` for provided `hash`. Fibonacci hashing is used to spread poor hashes (e.g. identity hash of integers or aligned pointers) between buckets.
+     */
+    inline size_t get_bucket_for_hash(size_t hash, size_t buckets)
+    {
+        const auto mixed = static_cast<uint64_t>(hash) * uint64_t{0x9E3779B97F4A7C15};
+        return static_cast<size_t>((mixed >> 32) % buckets);
+    }
+
     /**
      * @brief Calls passed function during destruction
      */
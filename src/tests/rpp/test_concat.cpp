@@ -12,7 +12,9 @@
 
 #include <rpp/disposables/composite_disposable.hpp>
 #include <rpp/disposables/disposable_wrapper.hpp>
+#include <rpp/disposables/details/base_disposable.hpp>
 #include <rpp/observables/dynamic_observable.hpp>
+#include <rpp/observers/mock_observer.hpp>
 #include <rpp/operators/concat.hpp>
 #include <rpp/schedulers/immediate.hpp>
 #include <rpp/sources/concat.hpp>
@@ -28,6 +30,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <vector>
 
 struct my_container_with_error : std::vector<rpp::dynamic_observable<int>>
 {
@@ -292,6 +295,56 @@ TEST_CASE("concat disposes on looping")
     })) | rpp::ops::subscribe(mock);
 }
 
+TEST_CASE("concat passes demand of backpressured observer to inner observables")
+{
+    SUBCASE("not satisfied demand is passed to the next observable")
+    {
+        auto mock = backpressured_mock_observer_strategy<int>{1};
+        rpp::source::just(rpp::schedulers::immediate{}, rpp::source::just(rpp::schedulers::immediate{}, 1, 2), rpp::source::just(rpp::schedulers::immediate{}, 3, 4))
+            | rpp::ops::concat()
+            | rpp::ops::subscribe(mock);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1});
+
+        mock.request(2);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3});
+        CHECK(mock.get_mock().get_on_completed_count() == 0);
+
+        mock.request(5);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4});
+        CHECK(mock.get_mock().get_on_completed_count() == 1);
+    }
+
+    SUBCASE("observables are requested one by one")
+    {
+        struct request_recorder final : public rpp::details::base_disposable
+        {
+            explicit request_recorder(std::vector<size_t>& requests)
+                : requests{requests}
+            {
+            }
+
+            void request(size_t count) noexcept override { requests.push_back(count); }
+
+            std::vector<size_t>& requests;
+        };
+
+        std::vector<size_t> requests{};
+        auto                mock = backpressured_mock_observer_strategy<int>{10};
+        rpp::source::create<rpp::dynamic_observable<int>>([&requests](auto&& obs) {
+            obs.set_upstream(rpp::disposable_wrapper::make<request_recorder>(requests));
+            obs.on_next(rpp::source::just(rpp::schedulers::immediate{}, 1).as_dynamic());
+            obs.on_next(rpp::source::just(rpp::schedulers::immediate{}, 2).as_dynamic());
+            obs.on_completed();
+        })
+            | rpp::ops::concat()
+            | rpp::ops::subscribe(mock);
+
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2});
+        CHECK(mock.get_mock().get_on_completed_count() == 1);
+        CHECK(requests == std::vector<size_t>{1, 1, 1});
+    }
+}
+
 TEST_CASE("concat doesn't produce extra copies")
 {
     copy_count_tracker tracker{};
@@ -0,0 +1,183 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#include <doctest/doctest.h>
+
+#include <rpp/disposables/details/base_disposable.hpp>
+#include <rpp/observables/dynamic_observable.hpp>
+#include <rpp/observers/mock_observer.hpp>
+#include <rpp/operators/as_blocking.hpp>
+#include <rpp/operators/concat_map_eager.hpp>
+#include <rpp/operators/delay.hpp>
+#include <rpp/schedulers/immediate.hpp>
+#include <rpp/schedulers/new_thread.hpp>
+#include <rpp/sources/create.hpp>
+#include <rpp/sources/from.hpp>
+#include <rpp/sources/just.hpp>
+
+#include "disposable_observable.hpp"
+
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("concat_map_eager emits values of observables in order of upstream")
+{
+    auto mock = mock_observer_strategy<int>{};
+
+    std::vector<rpp::dynamic_observer<int>> observers{};
+    const auto                              inner = [&observers](int) {
+        return rpp::source::create<int>([&observers](auto&& obs) {
+            observers.push_back(std::forward<decltype(obs)>(obs).as_dynamic());
+        });
+    };
+
+    SUBCASE("values of not first observables are buffered till previous observables complete")
+    {
+        rpp::source::just(rpp::schedulers::immediate{}, 1, 2, 3)
+            | rpp::ops::concat_map_eager(inner, 3, 0)
+            | rpp::ops::subscribe(mock);
+
+        REQUIRE(observers.size() == 3);
+
+        observers[1].on_next(20);
+        observers[2].on_next(30);
+        CHECK(mock.get_received_values().empty());
+
+        observers[0].on_next(10);
+        CHECK(mock.get_received_values() == std::vector{10});
+
+        observers[2].on_completed();
+        observers[0].on_completed();
+        CHECK(mock.get_received_values() == std::vector{10, 20});
+
+        observers[1].on_next(21);
+        CHECK(mock.get_received_values() == std::vector{10, 20, 21});
+        CHECK(mock.get_on_completed_count() == 0);
+
+        observers[1].on_completed();
+        CHECK(mock.get_received_values() == std::vector{10, 20, 21, 30});
+        CHECK(mock.get_on_completed_count() == 1);
+    }
+
+    SUBCASE("no more than max_concurrency observables are subscribed")
+    {
+        rpp::source::just(rpp::schedulers::immediate{}, 1, 2, 3)
+            | rpp::ops::concat_map_eager(inner, 2, 0)
+            | rpp::ops::subscribe(mock);
+
+        REQUIRE(observers.size() == 2);
+
+        observers[1].on_completed();
+        CHECK(observers.size() == 2);
+
+        observers[0].on_completed();
+        REQUIRE(observers.size() == 3);
+
+        observers[2].on_next(30);
+        observers[2].on_completed();
+        CHECK(mock.get_received_values() == std::vector{30});
+        CHECK(mock.get_on_completed_count() == 1);
+    }
+
+    SUBCASE("error of any observable is emitted immediately")
+    {
+        rpp::source::just(rpp::schedulers::immediate{}, 1, 2)
+            | rpp::ops::concat_map_eager(inner, 2, 0)
+            | rpp::ops::subscribe(mock);
+
+        REQUIRE(observers.size() == 2);
+        observers[1].on_next(20);
+        observers[1].on_error({});
+
+        CHECK(mock.get_received_values().empty());
+        CHECK(mock.get_on_error_count() == 1);
+        CHECK(observers[0].is_disposed());
+    }
+}
+
+TEST_CASE("concat_map_eager requests no more than prefetch values from backpressured observables")
+{
+    struct request_recorder final : public rpp::details::base_disposable
+    {
+        explicit request_recorder(std::vector<size_t>& requests)
+            : requests{requests}
+        {
+        }
+
+        void request(size_t count) noexcept override { requests.push_back(count); }
+
+        std::vector<size_t>& requests;
+    };
+
+    auto mock = mock_observer_strategy<int>{};
+
+    std::vector<rpp::dynamic_observer<int>> observers{};
+    std::vector<std::vector<size_t>>        requests(2);
+
+    rpp::source::just(rpp::schedulers::immediate{}, 0, 1)
+        | rpp::ops::concat_map_eager([&](int v) {
+              return rpp::source::create<int>([&, v](auto&& obs) {
+                  obs.set_upstream(rpp::disposable_wrapper::make<request_recorder>(requests[static_cast<size_t>(v)]));
+                  observers.push_back(std::forward<decltype(obs)>(obs).as_dynamic());
+              });
+          },
+                                       2,
+                                       4)
+        | rpp::ops::subscribe(mock);
+
+    REQUIRE(observers.size() == 2);
+    CHECK(requests[0] == std::vector<size_t>{4});
+    CHECK(requests[1] == std::vector<size_t>{4});
+
+    for (int v : {1, 2, 3})
+        observers[0].on_next(v);
+    CHECK(requests[0] == std::vector<size_t>{4, 3});
+
+    for (int v : {10, 20, 30, 40})
+        observers[1].on_next(v);
+    CHECK(requests[1] == std::vector<size_t>{4});
+    CHECK(mock.get_received_values() == std::vector{1, 2, 3});
+
+    observers[0].on_completed();
+    CHECK(mock.get_received_values() == std::vector{1, 2, 3, 10, 20, 30, 40});
+    CHECK(requests[1] == std::vector<size_t>{4, 3});
+
+    observers[1].on_completed();
+    CHECK(mock.get_on_completed_count() == 1);
+}
+
+TEST_CASE("concat_map_eager keeps order of observables emitting from other threads")
+{
+    std::vector<int> values(50);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::vector<int> received{};
+    rpp::source::from_iterable(values)
+        | rpp::ops::concat_map_eager([](int v) {
+              return rpp::source::just(rpp::schedulers::immediate{}, v, v)
+                   | rpp::ops::delay(std::chrono::milliseconds{(50 - v) % 7}, rpp::schedulers::new_thread{});
+          },
+                                       8,
+                                       0)
+        | rpp::ops::as_blocking()
+        | rpp::ops::subscribe([&](int v) { received.push_back(v); });
+
+    std::vector<int> expected{};
+    for (int v : values)
+        expected.insert(expected.end(), {v, v});
+
+    CHECK(received == expected);
+}
+
+TEST_CASE("concat_map_eager satisfies disposable contracts")
+{
+    test_operator_with_disposable<int>(rpp::ops::concat_map_eager([](int v) { return rpp::source::just(v); }, 2, 0));
+}
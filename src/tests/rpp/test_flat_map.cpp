@@ -137,6 +137,31 @@ TEST_CASE_TEMPLATE("flat_map", TestType, rpp::memory_model::use_stack, rpp::memo
     }
 }
 
+TEST_CASE("flat_map with max_concurrent subscribes limited amount of observables")
+{
+    auto mock = mock_observer_strategy<int>{};
+
+    std::vector<rpp::dynamic_observer<int>> observers{};
+    rpp::source::just(rpp::schedulers::immediate{}, 1, 2, 3)
+        | rpp::ops::flat_map([&observers](int v) {
+              return rpp::source::create<int>([&observers, v](auto&& obs) {
+                  obs.on_next(v);
+                  observers.push_back(std::forward<decltype(obs)>(obs).as_dynamic());
+              });
+          },
+                             2)
+        | rpp::ops::subscribe(mock);
+
+    CHECK(mock.get_received_values() == std::vector{1, 2});
+
+    observers[0].on_completed();
+    CHECK(mock.get_received_values() == std::vector{1, 2, 3});
+
+    observers[1].on_completed();
+    observers[2].on_completed();
+    CHECK(mock.get_on_completed_count() == 1);
+}
+
 TEST_CASE("flat_map satisfies disposable contracts")
 {
     test_operator_with_disposable<int>(rpp::ops::flat_map([](const auto& v) { return rpp::source::just(v); }));
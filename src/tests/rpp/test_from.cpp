@@ -12,6 +12,7 @@
 
 #include <rpp/observers/mock_observer.hpp>
 #include <rpp/operators/take.hpp>
+#include <rpp/schedulers/run_loop.hpp>
 #include <rpp/sources/from.hpp>
 
 #include "copy_count_tracker.hpp"
@@ -24,6 +25,8 @@
 
 #include <cstddef>
 #include <functional>
+#include <list>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 
@@ -190,6 +193,98 @@ TEST_CASE_TEMPLATE("from iterable with different schedulers", TestType, rpp::mem
     }
 }
 
+TEST_CASE_TEMPLATE("from iterable emits values only on demand of backpressured observer", TestType, rpp::memory_model::use_stack, rpp::memory_model::use_shared)
+{
+    auto mock = backpressured_mock_observer_strategy<int>{2};
+
+    SUBCASE("immediate scheduler emits requested values synchronously")
+    {
+        rpp::source::from_iterable<TestType>(std::vector{1, 2, 3, 4, 5}, rpp::schedulers::immediate{}).subscribe(mock);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2});
+
+        mock.request(2);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4});
+        CHECK(mock.get_mock().get_on_completed_count() == 0);
+
+        mock.request(1);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4, 5});
+        CHECK(mock.get_mock().get_on_completed_count() == 1);
+    }
+
+    SUBCASE("unbounded demand emits all values")
+    {
+        rpp::source::from_iterable<TestType>(std::vector{1, 2, 3, 4, 5}, rpp::schedulers::immediate{}).subscribe(mock);
+        mock.request(rpp::unbounded_demand);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4, 5});
+        CHECK(mock.get_mock().get_on_completed_count() == 1);
+    }
+
+    SUBCASE("empty container completes without demand")
+    {
+        auto empty = backpressured_mock_observer_strategy<int>{0};
+        rpp::source::from_iterable<TestType>(std::vector<int>{}, rpp::schedulers::immediate{}).subscribe(empty);
+        CHECK(empty.get_mock().get_on_completed_count() == 1);
+    }
+
+    SUBCASE("requested values are emitted via scheduler")
+    {
+        auto run_loop = rpp::schedulers::run_loop{};
+        rpp::source::from_iterable<TestType>(std::vector{1, 2, 3, 4, 5}, run_loop).subscribe(mock);
+        CHECK(mock.get_mock().get_received_values().empty());
+
+        while (!run_loop.is_empty())
+            run_loop.dispatch_if_ready();
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2});
+
+        mock.request(10);
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2});
+        while (!run_loop.is_empty())
+            run_loop.dispatch_if_ready();
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4, 5});
+        CHECK(mock.get_mock().get_on_completed_count() == 1);
+    }
+
+    SUBCASE("state is released as soon as nothing can resume emitting")
+    {
+        const auto value = std::make_shared<int>(1);
+
+        auto d        = rpp::composite_disposable_wrapper::make();
+        auto observer = backpressured_mock_observer_strategy<std::shared_ptr<int>>{0};
+        rpp::source::from_iterable<TestType>(std::vector{value, value, value}, rpp::schedulers::immediate{}).subscribe(d, observer);
+        CHECK(value.use_count() > 1);
+
+        SUBCASE("on completion")
+        {
+            observer.request(rpp::unbounded_demand);
+            CHECK(observer.get_mock().get_on_completed_count() == 1);
+            CHECK(static_cast<size_t>(value.use_count()) == 1 + observer.get_mock().get_received_values().size());
+        }
+
+        SUBCASE("on disposing")
+        {
+            observer.request(1);
+            d.dispose();
+            CHECK(static_cast<size_t>(value.use_count()) == 1 + observer.get_mock().get_received_values().size());
+        }
+    }
+
+    SUBCASE("requested values are emitted by single schedulable")
+    {
+        auto run_loop = rpp::schedulers::run_loop{};
+        rpp::source::from_iterable<TestType>(std::list{1, 2, 3, 4, 5}, run_loop).subscribe(mock);
+
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2});
+        CHECK(run_loop.is_empty());
+
+        mock.request(rpp::unbounded_demand);
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4, 5});
+        CHECK(mock.get_mock().get_on_completed_count() == 1);
+        CHECK(run_loop.is_empty());
+    }
+}
+
 TEST_CASE_TEMPLATE("from iterable doesn't provides extra copies", TestType, rpp::schedulers::current_thread, rpp::schedulers::immediate)
 {
     copy_count_tracker tracker{};
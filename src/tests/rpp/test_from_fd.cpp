@@ -0,0 +1,106 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#include <doctest/doctest.h>
+
+#include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/observers/dynamic_observer.hpp>
+#include <rpp/observers/mock_observer.hpp>
+#include <rpp/operators/subscribe.hpp>
+#include <rpp/schedulers/epoll_loop.hpp>
+#include <rpp/sources/from_fd.hpp>
+
+#include <chrono>
+#include <string>
+
+#if defined(__linux__)
+    #include <unistd.h>
+
+TEST_CASE("from_fd emits readiness of file descriptor")
+{
+    int fds[2]{};
+    REQUIRE(::pipe(fds) == 0);
+
+    const auto loop   = rpp::schedulers::epoll_loop{};
+    const auto worker = loop.create_worker();
+    auto       obs    = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    const auto write      = [&](const std::string& data) { CHECK(::write(fds[1], data.data(), data.size()) == static_cast<ssize_t>(data.size())); };
+    const auto stop_after = [&](rpp::schedulers::duration delay) {
+        worker.schedule(delay, [&loop](const auto&) -> rpp::schedulers::optional_delay_from_now { loop.stop(); return {}; }, obs);
+    };
+
+    SUBCASE("readable descriptor emits events till disposing")
+    {
+        std::string received{};
+        const auto  d = rpp::composite_disposable_wrapper::make();
+        rpp::source::from_fd(loop, fds[0], EPOLLIN)
+            | rpp::operators::subscribe(d, [&](const rpp::schedulers::epoll_loop::fd_event& event) {
+                  CHECK(event.fd == fds[0]);
+                  CHECK((event.events & EPOLLIN) != 0);
+
+                  char       buffer[16]{};
+                  const auto size = ::read(event.fd, buffer, sizeof(buffer));
+                  received.append(buffer, static_cast<size_t>(size));
+                  loop.stop();
+              });
+
+        write("abc");
+        loop.run();
+        CHECK(received == "abc");
+
+        write("de");
+        loop.run();
+        CHECK(received == "abcde");
+
+        d.dispose();
+        write("f");
+        stop_after(std::chrono::milliseconds{20});
+        loop.run();
+        CHECK(received == "abcde");
+    }
+
+    SUBCASE("second subscription to the same descriptor receives error")
+    {
+        auto first  = mock_observer_strategy<rpp::schedulers::epoll_loop::fd_event>{};
+        auto second = mock_observer_strategy<rpp::schedulers::epoll_loop::fd_event>{};
+
+        rpp::source::from_fd(loop, fds[0]).subscribe(first);
+        rpp::source::from_fd(loop, fds[0]).subscribe(second);
+        stop_after({});
+        loop.run();
+
+        CHECK(first.get_on_error_count() == 0);
+        CHECK(second.get_on_error_count() == 1);
+    }
+
+    SUBCASE("descriptor can be watched again after disposing of previous subscription")
+    {
+        auto first  = mock_observer_strategy<rpp::schedulers::epoll_loop::fd_event>{};
+        auto second = mock_observer_strategy<rpp::schedulers::epoll_loop::fd_event>{};
+
+        const auto d = rpp::composite_disposable_wrapper::make();
+        rpp::source::from_fd(loop, fds[0]).subscribe(first.get_observer(d));
+        d.dispose();
+        rpp::source::from_fd(loop, fds[0]).subscribe(second);
+
+        write("a");
+        stop_after({});
+        loop.run();
+
+        CHECK(first.get_total_on_next_count() == 0);
+        CHECK(second.get_on_error_count() == 0);
+        CHECK(second.get_total_on_next_count() == 1);
+    }
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+#endif
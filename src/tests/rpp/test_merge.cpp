@@ -13,19 +13,26 @@
 #include <rpp/observables/dynamic_observable.hpp>
 #include <rpp/observers/mock_observer.hpp>
 #include <rpp/operators/as_blocking.hpp>
+#include <rpp/operators/map.hpp>
 #include <rpp/operators/merge.hpp>
 #include <rpp/schedulers/immediate.hpp>
 #include <rpp/schedulers/new_thread.hpp>
 #include <rpp/sources/create.hpp>
 #include <rpp/sources/error.hpp>
+#include <rpp/sources/from.hpp>
 #include <rpp/sources/just.hpp>
 #include <rpp/sources/never.hpp>
+#include <rpp/subjects/publish_subject.hpp>
 
 #include "copy_count_tracker.hpp"
 #include "disposable_observable.hpp"
 
+#include <atomic>
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE_TEMPLATE("merge for observable of observables", TestType, rpp::memory_model::use_stack, rpp::memory_model::use_shared)
 {
@@ -251,6 +258,74 @@ TEST_CASE_TEMPLATE("merge handles race condition", TestType, rpp::memory_model::
     }
 }
 
+TEST_CASE("merge doesn't block producers during emission")
+{
+    auto first  = rpp::subjects::publish_subject<int>{};
+    auto second = rpp::subjects::publish_subject<int>{};
+
+    std::vector<int>             received{};
+    std::vector<std::thread::id> threads{};
+    first.get_observable()
+        | rpp::ops::merge_with(second.get_observable())
+        | rpp::ops::subscribe([&](int v) {
+              received.push_back(v);
+              threads.push_back(std::this_thread::get_id());
+              // emission from other thread is queued instead of waiting for end of current emission
+              if (v == 1)
+              {
+                  std::thread{[&] { second.get_observer().on_next(2); }}.join();
+                  CHECK(received.size() == 1);
+              }
+          });
+
+    first.get_observer().on_next(1);
+
+    CHECK(received == std::vector{1, 2});
+    CHECK(threads == std::vector{std::this_thread::get_id(), std::this_thread::get_id()});
+}
+
+TEST_CASE("merge passes all emissions of concurrent producers")
+{
+    constexpr size_t producers_count = 8;
+    constexpr int    values_count    = 10'000;
+
+    std::vector<rpp::subjects::publish_subject<int>> subjects(producers_count);
+    std::vector<std::vector<int>>                    received(producers_count);
+    std::atomic_size_t                               emitting{};
+    std::atomic_bool                                 overlapped{};
+    size_t                                           completed{};
+
+    rpp::source::just(rpp::schedulers::immediate{}, 0, 1, 2, 3, 4, 5, 6, 7)
+        | rpp::ops::map([&](int i) { return subjects[static_cast<size_t>(i)].get_observable() | rpp::ops::map([i](int v) { return std::pair{i, v}; }); })
+        | rpp::ops::merge()
+        | rpp::ops::subscribe([&](const std::pair<int, int>& v) {
+                                  if (emitting.fetch_add(1) != 0)
+                                      overlapped = true;
+                                  received[static_cast<size_t>(v.first)].push_back(v.second);
+                                  emitting.fetch_sub(1); },
+                              [&] { ++completed; });
+
+    std::vector<std::thread> threads{};
+    for (auto& subject : subjects)
+    {
+        threads.emplace_back([&subject] {
+            for (int v = 0; v < values_count; ++v)
+                subject.get_observer().on_next(v);
+            subject.get_observer().on_completed();
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    std::vector<int> expected(values_count);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    CHECK(!overlapped);
+    CHECK(completed == 1);
+    for (const auto& values : received)
+        CHECK(values == expected);
+}
+
 TEST_CASE("merge dispose inner_disposable immediately")
 {
     rpp::source::create<int>([](auto&& d) {
@@ -277,6 +352,162 @@ TEST_CASE("merge is not deadlocking is_disposed")
           });
 }
 
+TEST_CASE("merge requests inner observables according to demand of backpressured observer")
+{
+    auto mock = backpressured_mock_observer_strategy<int>{2};
+    rpp::source::just(rpp::schedulers::immediate{}, rpp::source::just(rpp::schedulers::immediate{}, 1, 2, 3), rpp::source::just(rpp::schedulers::immediate{}, 4, 5, 6))
+        | rpp::ops::merge()
+        | rpp::ops::subscribe(mock);
+    CHECK(mock.get_mock().get_received_values() == std::vector{1, 2});
+
+    mock.request(2);
+    CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4});
+    CHECK(mock.get_mock().get_on_completed_count() == 0);
+
+    mock.request(10);
+    CHECK(mock.get_mock().get_received_values() == std::vector{1, 2, 3, 4, 5, 6});
+    CHECK(mock.get_mock().get_on_completed_count() == 1);
+}
+
+TEST_CASE("merge with max_concurrent subscribes limited amount of observables")
+{
+    auto mock = mock_observer_strategy<int>{};
+
+    std::vector<rpp::dynamic_observer<int>> observers{};
+    const auto                              inner = rpp::source::create<int>([&observers](auto&& obs) {
+        observers.push_back(std::forward<decltype(obs)>(obs).as_dynamic());
+    });
+
+    SUBCASE("observables are subscribed as soon as active ones complete")
+    {
+        rpp::source::just(rpp::schedulers::immediate{}, inner, inner, inner, inner)
+            | rpp::ops::merge(2)
+            | rpp::ops::subscribe(mock);
+
+        REQUIRE(observers.size() == 2);
+
+        observers[1].on_next(1);
+        observers[1].on_completed();
+        REQUIRE(observers.size() == 3);
+
+        observers[2].on_next(2);
+        observers[0].on_next(3);
+        observers[0].on_completed();
+        REQUIRE(observers.size() == 4);
+
+        observers[2].on_completed();
+        CHECK(mock.get_on_completed_count() == 0);
+
+        observers[3].on_next(4);
+        observers[3].on_completed();
+        CHECK(mock.get_received_values() == std::vector{1, 2, 3, 4});
+        CHECK(mock.get_on_completed_count() == 1);
+    }
+
+    SUBCASE("queued observables are not subscribed after error")
+    {
+        rpp::source::just(rpp::schedulers::immediate{}, inner, inner, inner)
+            | rpp::ops::merge(1)
+            | rpp::ops::subscribe(mock);
+
+        REQUIRE(observers.size() == 1);
+        observers[0].on_error({});
+
+        CHECK(observers.size() == 1);
+        CHECK(mock.get_on_error_count() == 1);
+    }
+
+    SUBCASE("0 is treated as 1")
+    {
+        const auto d = rpp::composite_disposable_wrapper::make();
+        rpp::source::just(rpp::schedulers::immediate{}, inner, inner)
+            | rpp::ops::merge(0)
+            | rpp::ops::subscribe(mock.get_observer(d));
+
+        CHECK(observers.size() == 1);
+        d.dispose();
+    }
+}
+
+TEST_CASE("merge with max_concurrent requests observables from backpressured upstream")
+{
+    struct request_recorder final : public rpp::details::base_disposable
+    {
+        explicit request_recorder(std::vector<size_t>& requests)
+            : requests{requests}
+        {
+        }
+
+        void request(size_t count) noexcept override { requests.push_back(count); }
+
+        std::vector<size_t>& requests;
+    };
+
+    std::vector<size_t> requests{};
+    auto                mock = mock_observer_strategy<int>{};
+    rpp::source::create<rpp::dynamic_observable<int>>([&requests](auto&& obs) {
+        obs.set_upstream(rpp::disposable_wrapper::make<request_recorder>(requests));
+        CHECK(requests == std::vector<size_t>{2});
+
+        obs.on_next(rpp::source::just(rpp::schedulers::immediate{}, 1).as_dynamic());
+        CHECK(requests == std::vector<size_t>{2, 1});
+
+        obs.on_next(rpp::source::never<int>().as_dynamic());
+        CHECK(requests == std::vector<size_t>{2, 1});
+        obs.on_completed();
+    })
+        | rpp::ops::merge(2)
+        | rpp::ops::subscribe(mock);
+
+    CHECK(mock.get_received_values() == std::vector{1});
+    CHECK(mock.get_on_completed_count() == 0);
+}
+
+TEST_CASE("merge with max_concurrent takes observables from iterable only when they could be subscribed")
+{
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::vector<rpp::dynamic_observer<int>> observers{};
+    size_t                                  mapped{};
+    auto                                    mock = mock_observer_strategy<int>{};
+    rpp::source::from_iterable(values)
+        | rpp::ops::map([&observers, &mapped](int) {
+              ++mapped;
+              return rpp::source::create<int>([&observers](auto&& obs) {
+                  observers.push_back(std::forward<decltype(obs)>(obs).as_dynamic());
+              });
+          })
+        | rpp::ops::merge(3)
+        | rpp::ops::subscribe(mock);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(observers.size() == std::min(values.size(), i + 3));
+        REQUIRE(mapped == observers.size());
+        observers[i].on_next(values[i]);
+        observers[i].on_completed();
+    }
+
+    CHECK(mock.get_received_values() == values);
+    CHECK(mock.get_on_completed_count() == 1);
+}
+
+TEST_CASE("merge with max_concurrent emits synchronously with immediate scheduler")
+{
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto mock = mock_observer_strategy<int>{};
+    rpp::source::from_iterable(values, rpp::schedulers::immediate{})
+        | rpp::ops::map([](int v) { return rpp::source::just(rpp::schedulers::immediate{}, v); })
+        | rpp::ops::merge(3)
+        | rpp::ops::subscribe(mock);
+
+    CHECK(mock.get_received_values() == values);
+    CHECK(mock.get_on_completed_count() == 1);
+}
+
 TEST_CASE("merge doesn't produce extra copies")
 {
     SUBCASE("send value by copy")
@@ -0,0 +1,297 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#include <doctest/doctest.h>
+
+#include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/observers/mock_observer.hpp>
+#include <rpp/operators/as_blocking.hpp>
+#include <rpp/operators/observe_on.hpp>
+#include <rpp/operators/subscribe.hpp>
+#include <rpp/operators/tap.hpp>
+#include <rpp/schedulers/immediate.hpp>
+#include <rpp/schedulers/new_thread.hpp>
+#include <rpp/schedulers/run_loop.hpp>
+#include <rpp/sources/create.hpp>
+#include <rpp/sources/from.hpp>
+#include <rpp/sources/just.hpp>
+#include <rpp/subjects/publish_subject.hpp>
+#include <rpp/utils/exceptions.hpp>
+
+#include "disposable_observable.hpp"
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("observe_on emits emissions via scheduler")
+{
+    auto mock     = mock_observer_strategy<int>{};
+    auto run_loop = rpp::schedulers::run_loop{};
+
+    SUBCASE("all emissions are drained by one schedulable")
+    {
+        rpp::source::just(1, 2, 3) | rpp::ops::observe_on(run_loop) | rpp::ops::subscribe(mock);
+
+        CHECK(mock.get_received_values().empty());
+        CHECK(mock.get_on_completed_count() == 0);
+
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_received_values() == std::vector{1, 2, 3});
+        CHECK(mock.get_on_completed_count() == 1);
+        CHECK(run_loop.is_empty());
+    }
+
+    SUBCASE("emissions are drained in batches not exceeding max_batch_size")
+    {
+        auto subj = rpp::subjects::publish_subject<int>{};
+        subj.get_observable() | rpp::ops::observe_on(run_loop, {.max_batch_size = 2}) | rpp::ops::subscribe(mock);
+
+        for (int v : {1, 2, 3, 4, 5})
+            subj.get_observer().on_next(v);
+        subj.get_observer().on_completed();
+
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_received_values() == std::vector{1, 2});
+
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_received_values() == std::vector{1, 2, 3, 4});
+        CHECK(mock.get_on_completed_count() == 0);
+
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_received_values() == std::vector{1, 2, 3, 4, 5});
+        CHECK(mock.get_on_completed_count() == 1);
+        CHECK(run_loop.is_empty());
+    }
+
+    SUBCASE("emission after draining schedules draining again")
+    {
+        auto subj = rpp::subjects::publish_subject<int>{};
+        subj.get_observable() | rpp::ops::observe_on(run_loop) | rpp::ops::subscribe(mock);
+
+        subj.get_observer().on_next(1);
+        run_loop.dispatch_if_ready();
+        CHECK(run_loop.is_empty());
+
+        subj.get_observer().on_next(2);
+        CHECK(!run_loop.is_empty());
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_received_values() == std::vector{1, 2});
+    }
+
+    SUBCASE("values not emitted before on_error are dropped")
+    {
+        rpp::source::create<int>([](const auto& obs) {
+            obs.on_next(1);
+            obs.on_next(2);
+            obs.on_error({});
+        })
+            | rpp::ops::observe_on(run_loop)
+            | rpp::ops::subscribe(mock);
+
+        CHECK(mock.get_on_error_count() == 0);
+
+        run_loop.dispatch_if_ready();
+        CHECK(mock.get_received_values().empty());
+        CHECK(mock.get_on_error_count() == 1);
+    }
+
+    SUBCASE("disposing of observer stops draining")
+    {
+        auto d    = rpp::composite_disposable_wrapper::make();
+        auto subj = rpp::subjects::publish_subject<int>{};
+        subj.get_observable() | rpp::ops::observe_on(run_loop) | rpp::ops::subscribe(mock.get_observer(d));
+
+        subj.get_observer().on_next(1);
+        d.dispose();
+        run_loop.dispatch_if_ready();
+
+        CHECK(mock.get_received_values().empty());
+    }
+}
+
+TEST_CASE("observe_on passes emissions to another thread in order")
+{
+    std::vector<int> values(10'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::vector<int> received{};
+    std::thread::id  thread{};
+    rpp::source::create<int>([&values](const auto& obs) {
+        for (int v : values)
+            obs.on_next(v);
+        obs.on_completed();
+    })
+        | rpp::ops::observe_on(rpp::schedulers::new_thread{}, {.max_batch_size = 16})
+        | rpp::ops::as_blocking()
+        | rpp::ops::subscribe([&](int v) {
+              received.push_back(v);
+              thread = std::this_thread::get_id();
+          });
+
+    CHECK(received == values);
+    CHECK(thread != std::this_thread::get_id());
+}
+
+TEST_CASE("observe_on keeps non-trivial values alive till emission")
+{
+    auto mock     = mock_observer_strategy<std::string>{};
+    auto run_loop = rpp::schedulers::run_loop{};
+
+    {
+        auto subj = rpp::subjects::publish_subject<std::string>{};
+        subj.get_observable() | rpp::ops::observe_on(run_loop) | rpp::ops::subscribe(mock);
+        for (size_t i = 0; i < 200; ++i)
+            subj.get_observer().on_next(std::string(100, 'a') + std::to_string(i));
+    }
+
+    run_loop.dispatch_if_ready();
+    REQUIRE(mock.get_received_values().size() == 128);
+    CHECK(mock.get_received_values().back() == std::string(100, 'a') + "127");
+}
+
+TEST_CASE("bounded observe_on applies overflow policy")
+{
+    auto mock     = mock_observer_strategy<int>{};
+    auto run_loop = rpp::schedulers::run_loop{};
+    auto counters = std::make_shared<rpp::operators::observe_on_counters>();
+    auto subj     = rpp::subjects::publish_subject<int>{};
+
+    std::exception_ptr error{};
+
+    const auto emit_and_dispatch = [&](rpp::operators::overflow_policy policy) {
+        subj.get_observable()
+            | rpp::ops::observe_on(run_loop, {.capacity = 2, .overflow = policy, .counters = counters})
+            | rpp::ops::tap([](int) {}, [&](const std::exception_ptr& err) { error = err; }, [] {})
+            | rpp::ops::subscribe(mock);
+        for (int v : {1, 2, 3, 4, 5})
+            subj.get_observer().on_next(v);
+        subj.get_observer().on_completed();
+        run_loop.dispatch_if_ready();
+    };
+
+    SUBCASE("drop_newest keeps the first values")
+    {
+        emit_and_dispatch(rpp::operators::overflow_policy::drop_newest);
+        CHECK(mock.get_received_values() == std::vector{1, 2});
+        CHECK(mock.get_on_completed_count() == 1);
+        CHECK(counters->dropped == 3);
+    }
+
+    SUBCASE("drop_oldest keeps the last values")
+    {
+        emit_and_dispatch(rpp::operators::overflow_policy::drop_oldest);
+        CHECK(mock.get_received_values() == std::vector{4, 5});
+        CHECK(mock.get_on_completed_count() == 1);
+        CHECK(counters->dropped == 3);
+    }
+
+    SUBCASE("latest_only keeps only the latest value")
+    {
+        emit_and_dispatch(rpp::operators::overflow_policy::latest_only);
+        CHECK(mock.get_received_values() == std::vector{5});
+        CHECK(mock.get_on_completed_count() == 1);
+        CHECK(counters->dropped == 4);
+    }
+
+    SUBCASE("error emits buffer_overflow and disposes upstream")
+    {
+        emit_and_dispatch(rpp::operators::overflow_policy::error);
+        CHECK(mock.get_received_values().empty());
+        CHECK(mock.get_on_completed_count() == 0);
+        REQUIRE(mock.get_on_error_count() == 1);
+        CHECK_THROWS_AS(std::rethrow_exception(error), rpp::utils::buffer_overflow);
+        CHECK(subj.get_observer().is_disposed());
+        CHECK(counters->dropped == 0);
+    }
+
+    SUBCASE("values fitting into capacity are not affected")
+    {
+        subj.get_observable() | rpp::ops::observe_on(run_loop, {.capacity = 2, .overflow = rpp::operators::overflow_policy::error}) | rpp::ops::subscribe(mock);
+        for (int v : {1, 2, 3, 4, 5})
+        {
+            subj.get_observer().on_next(v);
+            run_loop.dispatch_if_ready();
+        }
+        CHECK(mock.get_received_values() == std::vector{1, 2, 3, 4, 5});
+        CHECK(mock.get_on_error_count() == 0);
+    }
+}
+
+TEST_CASE("bounded observe_on requests values from backpressured upstream")
+{
+    auto mock     = mock_observer_strategy<int>{};
+    auto run_loop = rpp::schedulers::run_loop{};
+    auto counters = std::make_shared<rpp::operators::observe_on_counters>();
+
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    rpp::source::from_iterable(values, rpp::schedulers::immediate{})
+        | rpp::ops::observe_on(run_loop, {.capacity = 4, .overflow = rpp::operators::overflow_policy::error, .counters = counters})
+        | rpp::ops::subscribe(mock);
+
+    run_loop.dispatch_if_ready();
+    CHECK(mock.get_received_values() == std::vector{0, 1, 2, 3});
+
+    while (!run_loop.is_empty())
+        run_loop.dispatch_if_ready();
+
+    CHECK(mock.get_received_values() == values);
+    CHECK(mock.get_on_error_count() == 0);
+    CHECK(mock.get_on_completed_count() == 1);
+    CHECK(counters->dropped == 0);
+}
+
+TEST_CASE("bounded observe_on with block policy waits for consumer")
+{
+    SUBCASE("all values are passed in order")
+    {
+        std::vector<int> values(1'000);
+        std::iota(values.begin(), values.end(), 0);
+
+        std::vector<int> received{};
+        rpp::source::create<int>([&values](const auto& obs) {
+            for (int v : values)
+                obs.on_next(v);
+            obs.on_completed();
+        })
+            | rpp::ops::observe_on(rpp::schedulers::new_thread{}, {.max_batch_size = 2, .capacity = 4, .overflow = rpp::operators::overflow_policy::block})
+            | rpp::ops::as_blocking()
+            | rpp::ops::subscribe([&](int v) { received.push_back(v); });
+
+        CHECK(received == values);
+    }
+
+    SUBCASE("disposing releases waiting producer")
+    {
+        std::atomic<int> received{};
+        const auto       d = rpp::composite_disposable_wrapper::make();
+        rpp::source::create<int>([](const auto& obs) {
+            for (int v = 0; v < 100; ++v)
+                obs.on_next(v);
+        })
+            | rpp::ops::observe_on(rpp::schedulers::new_thread{}, {.capacity = 1, .overflow = rpp::operators::overflow_policy::block})
+            | rpp::ops::subscribe(d, [&](int) {
+                  ++received;
+                  d.dispose();
+              });
+
+        CHECK(received == 1);
+    }
+}
+
+TEST_CASE("observe_on satisfies disposable contracts")
+{
+    test_operator_with_disposable<int>(rpp::ops::observe_on(rpp::schedulers::immediate{}));
+}
@@ -0,0 +1,174 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#include <doctest/doctest.h>
+
+#include <rpp/disposables/callback_disposable.hpp>
+#include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/observers/mock_observer.hpp>
+#include <rpp/operators/as_blocking.hpp>
+#include <rpp/operators/map.hpp>
+#include <rpp/operators/observe_on_partitioned.hpp>
+#include <rpp/operators/parallel.hpp>
+#include <rpp/operators/subscribe.hpp>
+#include <rpp/operators/tap.hpp>
+#include <rpp/schedulers/thread_pool.hpp>
+#include <rpp/sources/create.hpp>
+#include <rpp/sources/from.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("observe_on_partitioned processes values of the same key by the same worker in order")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{4};
+
+    std::vector<int> values(10'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::mutex                      mutex{};
+    std::map<int, std::vector<int>> values_by_key{};
+    std::map<int, std::thread::id>  thread_by_key{};
+    std::set<std::thread::id>       threads{};
+    bool                            same_thread_for_key{true};
+
+    auto mock = mock_observer_strategy<int>{};
+    rpp::source::from_iterable(values)
+        | rpp::ops::observe_on_partitioned([](int v) { return v % 16; }, scheduler, 4)
+        | rpp::ops::tap([&](int v) {
+              std::lock_guard lock{mutex};
+              values_by_key[v % 16].push_back(v);
+              const auto [it, inserted] = thread_by_key.emplace(v % 16, std::this_thread::get_id());
+              same_thread_for_key &= it->second == std::this_thread::get_id();
+              threads.insert(std::this_thread::get_id());
+          })
+        | rpp::ops::sequential()
+        | rpp::ops::as_blocking()
+        | rpp::ops::subscribe(mock);
+
+    CHECK(mock.get_received_values().size() == values.size());
+    CHECK(mock.get_on_completed_count() == 1);
+
+    CHECK(same_thread_for_key);
+    CHECK(threads.size() > 1);
+    CHECK(threads.count(std::this_thread::get_id()) == 0);
+
+    REQUIRE(values_by_key.size() == 16);
+    for (const auto& [key, key_values] : values_by_key)
+    {
+        CHECK(key_values.size() == values.size() / 16);
+        CHECK(std::is_sorted(key_values.begin(), key_values.end()));
+    }
+}
+
+TEST_CASE("observe_on_partitioned with ordered_sequential keeps order of original observable")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{4};
+
+    std::vector<int> values(10'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto mock = mock_observer_strategy<int>{};
+    rpp::source::from_iterable(values)
+        // keys are distributed unevenly to make partitions progress with different speed
+        | rpp::ops::observe_on_partitioned([](int v) { return v % 7 == 0 ? 0 : v % 5; }, scheduler, 3)
+        | rpp::ops::map([](int v) { return v * 2; })
+        | rpp::ops::ordered_sequential()
+        | rpp::ops::as_blocking()
+        | rpp::ops::subscribe(mock);
+
+    std::vector<int> expected{};
+    for (int v : values)
+        expected.push_back(v * 2);
+
+    CHECK(mock.get_received_values() == expected);
+    CHECK(mock.get_on_completed_count() == 1);
+}
+
+TEST_CASE("observe_on_partitioned spreads strided keys between partitions")
+{
+    // std::hash of integer is identity in some implementations, so, keys multiple of partitions would land on the same partition without mixing
+    const auto distribution = rpp::details::parallel_by_key<std::identity>{};
+
+    std::set<size_t> partitions{};
+    for (int i = 0; i < 100; ++i)
+        partitions.insert(distribution.get_rail(0, i * 4, 4));
+
+    CHECK(partitions == std::set<size_t>{0, 1, 2, 3});
+}
+
+TEST_CASE("observe_on_partitioned disposes original observable and drops queued values on disposing")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{2};
+
+    std::atomic_bool                          upstream_disposed{};
+    std::optional<rpp::dynamic_observer<int>> source{};
+
+    // keys landing on different partitions to block both workers
+    const auto distribution = rpp::details::parallel_by_key<std::identity>{};
+    int        other_key    = 1;
+    while (distribution.get_rail(0, other_key, 2) == distribution.get_rail(0, 0, 2))
+        ++other_key;
+
+    std::promise<void>    gate{};
+    const auto            opened = gate.get_future().share();
+    std::atomic_size_t    processed{};
+    std::mutex            mutex{};
+    std::map<int, size_t> received_by_key{};
+    auto                  d = rpp::composite_disposable_wrapper::make();
+    rpp::source::create<int>([&](auto&& obs) {
+        obs.set_upstream(rpp::make_callback_disposable([&upstream_disposed]() noexcept { upstream_disposed = true; }));
+        source.emplace(std::forward<decltype(obs)>(obs).as_dynamic());
+    })
+        | rpp::ops::observe_on_partitioned(std::identity{}, scheduler, 2)
+        | rpp::ops::tap([&processed, opened](int) {
+              ++processed;
+              opened.wait();
+          })
+        | rpp::ops::sequential()
+        | rpp::ops::subscribe(d, [&](int v) {
+              std::lock_guard lock{mutex};
+              ++received_by_key[v];
+          });
+
+    REQUIRE(source);
+    for (int i = 0; i < 5; ++i)
+    {
+        source->on_next(0);
+        source->on_next(other_key);
+    }
+
+    // first value of each partition blocks its worker, the rest are queued
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (processed.load() < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    REQUIRE(processed.load() == 2);
+
+    d.dispose();
+    CHECK(upstream_disposed.load());
+    CHECK(source->is_disposed());
+
+    gate.set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    CHECK(processed.load() == 2);
+
+    std::lock_guard lock{mutex};
+    CHECK(received_by_key.empty());
+}
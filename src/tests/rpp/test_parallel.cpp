@@ -0,0 +1,231 @@
+//                  ReactivePlusPlus library
+//
+//          Copyright Aleksey Loginov 2023 - present.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/victimsnino/ReactivePlusPlus
+//
+
+#include <doctest/doctest.h>
+
+#include <rpp/disposables/callback_disposable.hpp>
+#include <rpp/disposables/composite_disposable.hpp>
+#include <rpp/observers/mock_observer.hpp>
+#include <rpp/operators/as_blocking.hpp>
+#include <rpp/operators/filter.hpp>
+#include <rpp/operators/flat_map.hpp>
+#include <rpp/operators/map.hpp>
+#include <rpp/operators/parallel.hpp>
+#include <rpp/operators/reduce.hpp>
+#include <rpp/operators/subscribe.hpp>
+#include <rpp/schedulers/immediate.hpp>
+#include <rpp/schedulers/thread_pool.hpp>
+#include <rpp/sources/create.hpp>
+#include <rpp/sources/from.hpp>
+#include <rpp/sources/just.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("parallel processes values of each rail via its own worker")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{4};
+
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::mutex                     mutex{};
+    std::map<int, std::thread::id> threads{};
+
+    auto mock = mock_observer_strategy<int>{};
+    rpp::source::from_iterable(values)
+        | rpp::ops::parallel(4, scheduler)
+        | rpp::ops::map([&](int v) {
+              std::lock_guard lock{mutex};
+              threads[v] = std::this_thread::get_id();
+              return v;
+          })
+        | rpp::ops::sequential()
+        | rpp::ops::as_blocking()
+        | rpp::ops::subscribe(mock);
+
+    auto received = mock.get_received_values();
+    std::sort(received.begin(), received.end());
+    CHECK(received == values);
+    CHECK(mock.get_on_completed_count() == 1);
+
+    std::set<std::thread::id> unique_threads{};
+    for (const auto& [v, thread] : threads)
+    {
+        unique_threads.insert(thread);
+        // values are passed to rails in round-robin order
+        CHECK(thread == threads[v % 4]);
+    }
+    CHECK(unique_threads.size() == 4);
+    CHECK(unique_threads.count(std::this_thread::get_id()) == 0);
+}
+
+TEST_CASE("ordered_sequential keeps order of original observable")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{4};
+
+    std::vector<int> values(1'000);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto mock = mock_observer_strategy<int>{};
+
+    SUBCASE("values of filtering and flattening rails are emitted in order")
+    {
+        rpp::source::from_iterable(values)
+            | rpp::ops::parallel(4, scheduler)
+            | rpp::ops::filter([](int v) { return v % 3 != 0; })
+            | rpp::ops::flat_map([](int v) { return rpp::source::just(rpp::schedulers::immediate{}, v, -v); })
+            | rpp::ops::ordered_sequential()
+            | rpp::ops::as_blocking()
+            | rpp::ops::subscribe(mock);
+
+        std::vector<int> expected{};
+        for (int v : values)
+        {
+            if (v % 3 != 0)
+                expected.insert(expected.end(), {v, -v});
+        }
+        CHECK(mock.get_received_values() == expected);
+        CHECK(mock.get_on_completed_count() == 1);
+    }
+
+    SUBCASE("values emitted by rails on completion are emitted after all other values")
+    {
+        rpp::source::from_iterable(values)
+            | rpp::ops::parallel(2, scheduler)
+            | rpp::ops::reduce(0, std::plus<int>{})
+            | rpp::ops::ordered_sequential()
+            | rpp::ops::as_blocking()
+            | rpp::ops::subscribe(mock);
+
+        int even{};
+        int odd{};
+        for (int v : values)
+            (v % 2 == 0 ? even : odd) += v;
+
+        CHECK(mock.get_received_values() == std::vector{even, odd});
+        CHECK(mock.get_on_completed_count() == 1);
+    }
+}
+
+TEST_CASE("parallel forwards errors and disposes upstream")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{2};
+
+    auto mock = mock_observer_strategy<int>{};
+
+    SUBCASE("error of rail")
+    {
+        rpp::source::just(1, 2, 3, 4)
+            | rpp::ops::parallel(2, scheduler)
+            | rpp::ops::map([](int v) {
+                  if (v == 3)
+                      throw std::runtime_error{"error"};
+                  return v;
+              })
+            | rpp::ops::ordered_sequential()
+            | rpp::ops::as_blocking()
+            | rpp::ops::subscribe(mock);
+
+        CHECK(mock.get_on_error_count() == 1);
+        CHECK(mock.get_on_completed_count() == 0);
+        auto received = mock.get_received_values();
+        CHECK(std::find(received.begin(), received.end(), 3) == received.end());
+    }
+
+    SUBCASE("error of original observable")
+    {
+        rpp::disposable_wrapper upstream = rpp::disposable_wrapper::empty();
+        rpp::source::create<int>([&upstream](auto&& obs) {
+            upstream = rpp::composite_disposable_wrapper::make();
+            obs.set_upstream(upstream);
+            obs.on_next(1);
+            obs.on_error({});
+        })
+            | rpp::ops::parallel(2, scheduler)
+            | rpp::ops::sequential()
+            | rpp::ops::as_blocking()
+            | rpp::ops::subscribe(mock);
+
+        CHECK(mock.get_on_error_count() == 1);
+        CHECK(upstream.is_disposed());
+    }
+}
+
+TEST_CASE("parallel can be subscribed directly and disposed")
+{
+    const auto scheduler = rpp::schedulers::thread_pool{2};
+
+    SUBCASE("direct subscription is the same as sequential")
+    {
+        auto mock = mock_observer_strategy<int>{};
+        rpp::source::just(1, 2, 3)
+            | rpp::ops::parallel(2, scheduler)
+            | rpp::ops::map([](int v) { return v * 10; })
+            | rpp::ops::as_blocking()
+            | rpp::ops::subscribe(mock);
+
+        auto received = mock.get_received_values();
+        std::sort(received.begin(), received.end());
+        CHECK(received == std::vector{10, 20, 30});
+        CHECK(mock.get_on_completed_count() == 1);
+    }
+
+    SUBCASE("disposing disposes original observable and stops rails")
+    {
+        std::atomic_bool                          upstream_disposed{};
+        std::optional<rpp::dynamic_observer<int>> source{};
+
+        std::promise<void> gate{};
+        const auto         opened = gate.get_future().share();
+        std::atomic_size_t processed{};
+        std::atomic_size_t received{};
+        auto               d = rpp::composite_disposable_wrapper::make();
+        rpp::source::create<int>([&](auto&& obs) {
+            obs.set_upstream(rpp::make_callback_disposable([&upstream_disposed]() noexcept { upstream_disposed = true; }));
+            source.emplace(std::forward<decltype(obs)>(obs).as_dynamic());
+        })
+            | rpp::ops::parallel(2, scheduler)
+            | rpp::ops::map([&processed, opened](int v) {
+                  ++processed;
+                  opened.wait();
+                  return v;
+              })
+            | rpp::ops::subscribe(d, [&](int) { ++received; });
+
+        REQUIRE(source);
+        for (int i = 0; i < 10; ++i)
+            source->on_next(i);
+
+        // each rail is blocked by its first value while the rest are queued
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (processed.load() < 2 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        REQUIRE(processed.load() == 2);
+
+        d.dispose();
+        CHECK(upstream_disposed.load());
+        CHECK(source->is_disposed());
+
+        gate.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        CHECK(processed.load() == 2);
+        CHECK(received.load() == 0);
+    }
+}
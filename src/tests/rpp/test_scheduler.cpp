@@ -23,13 +23,26 @@
 #include "rpp/disposables/fwd.hpp"
 #include "rpp_trompeloil.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <optional>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <poll.h>
+#endif
 
 using namespace std::string_literals;
 
@@ -363,7 +376,46 @@ TEST_CASE("Immediate scheduler")
     }
 }
 
-TEST_CASE_TEMPLATE("queue_based scheduler", TestType, rpp::schedulers::current_thread, rpp::schedulers::new_thread, rpp::schedulers::thread_pool)
+namespace
+{
+    struct work_stealing_thread_pool
+    {
+        static auto create_worker()
+        {
+            return rpp::schedulers::thread_pool{1, rpp::schedulers::thread_pool::mode::work_stealing}.create_worker();
+        }
+    };
+
+    template<rpp::schedulers::idle_strategy Strategy>
+    struct new_thread_with_idle_strategy
+    {
+        static auto create_worker()
+        {
+            return rpp::schedulers::new_thread::with(Strategy).create_worker();
+        }
+    };
+
+    template<rpp::schedulers::idle_strategy Strategy>
+    struct work_stealing_thread_pool_with_idle_strategy
+    {
+        static auto create_worker()
+        {
+            return rpp::schedulers::thread_pool{{.threads_count = 1, .pool_mode = rpp::schedulers::thread_pool::mode::work_stealing, .idle = Strategy}}.create_worker();
+        }
+    };
+} // namespace
+
+TEST_CASE_TEMPLATE("queue_based scheduler",
+                   TestType,
+                   rpp::schedulers::current_thread,
+                   rpp::schedulers::new_thread,
+                   rpp::schedulers::elastic,
+                   rpp::schedulers::thread_pool,
+                   work_stealing_thread_pool,
+                   new_thread_with_idle_strategy<rpp::schedulers::idle_strategy::spin_yield_park>,
+                   new_thread_with_idle_strategy<rpp::schedulers::idle_strategy::busy_spin>,
+                   work_stealing_thread_pool_with_idle_strategy<rpp::schedulers::idle_strategy::spin_yield_park>,
+                   work_stealing_thread_pool_with_idle_strategy<rpp::schedulers::idle_strategy::busy_spin>)
 {
     auto d        = rpp::composite_disposable_wrapper::make();
     auto mock_obs = mock_observer_strategy<int>{};
@@ -818,6 +870,205 @@ TEST_CASE("new_thread works till end")
     CHECK(!before);
 }
 
+TEST_CASE("new_thread handles schedulings from multiple threads")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    constexpr size_t producers_count = 4;
+    constexpr size_t per_producer    = 1000;
+
+    const auto worker = rpp::schedulers::new_thread::create_worker();
+
+    std::array<std::vector<size_t>, producers_count> executions{};
+    std::atomic_size_t                               executed{};
+    std::promise<void>                               done{};
+
+    std::vector<std::thread> producers{};
+    for (size_t i = 0; i < producers_count; ++i)
+    {
+        producers.emplace_back([&, i] {
+            for (size_t j = 0; j < per_producer; ++j)
+            {
+                worker.schedule([&, i, j](const auto&) {
+                    executions[i].push_back(j);
+                    if (executed.fetch_add(1) + 1 == producers_count * per_producer)
+                        done.set_value();
+                    return rpp::schedulers::optional_delay_from_now{}; }, obs);
+            }
+        });
+    }
+    for (auto& t : producers)
+        t.join();
+
+    REQUIRE(done.get_future().wait_for(std::chrono::seconds{5}) == std::future_status::ready);
+
+    std::vector<size_t> expected(per_producer);
+    std::iota(expected.begin(), expected.end(), size_t{});
+    for (const auto& e : executions)
+        CHECK(e == expected);
+}
+
+TEST_CASE("elastic reuses cached threads")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    const auto get_thread_of_worker = [&](const auto& worker) {
+        std::promise<std::thread::id> promise{};
+        worker.schedule([&promise](const auto&) {
+            promise.set_value(std::this_thread::get_id());
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                        obs);
+        return promise.get_future().get();
+    };
+
+    SUBCASE("thread of destroyed worker reused by next worker")
+    {
+        const auto scheduler = rpp::schedulers::elastic{};
+
+        const auto first_thread = get_thread_of_worker(scheduler.create_worker());
+        // wait till thread returns back to cache
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+        const auto second_thread = get_thread_of_worker(scheduler.create_worker());
+        CHECK(first_thread == second_thread);
+        CHECK(first_thread != std::this_thread::get_id());
+    }
+
+    SUBCASE("alive workers use different threads")
+    {
+        const auto scheduler = rpp::schedulers::elastic{};
+
+        const auto first_worker  = scheduler.create_worker();
+        const auto second_worker = scheduler.create_worker();
+
+        CHECK(get_thread_of_worker(first_worker) != get_thread_of_worker(second_worker));
+    }
+
+    SUBCASE("workers share threads when max_threads reached")
+    {
+        const auto scheduler = rpp::schedulers::elastic{1};
+
+        const auto first_worker  = scheduler.create_worker();
+        const auto second_worker = scheduler.create_worker();
+
+        CHECK(get_thread_of_worker(first_worker) == get_thread_of_worker(second_worker));
+    }
+
+    SUBCASE("worker created and destroyed before cached thread wakes up still processes its schedulables")
+    {
+        const auto scheduler = rpp::schedulers::elastic{};
+        for (int i = 0; i < 100; ++i)
+        {
+            std::promise<void> executed{};
+            scheduler.create_worker().schedule([&executed](const auto&) {
+                executed.set_value();
+                return rpp::schedulers::optional_delay_from_now{};
+            },
+                                               obs);
+            REQUIRE(executed.get_future().wait_for(std::chrono::seconds{1}) == std::future_status::ready);
+        }
+    }
+
+    SUBCASE("released thread processes pending schedulables before returning to cache")
+    {
+        const auto scheduler = rpp::schedulers::elastic{1, std::chrono::milliseconds{1}};
+
+        std::promise<void> executed{};
+        scheduler.create_worker().schedule(std::chrono::milliseconds{10}, [&executed](const auto&) {
+            executed.set_value();
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                                           obs);
+
+        CHECK(executed.get_future().wait_for(std::chrono::seconds{1}) == std::future_status::ready);
+    }
+}
+
+TEST_CASE("shard_scheduler binds workers to shards")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    const auto scheduler = rpp::schedulers::shard_scheduler{{.shards_count = 3}};
+    REQUIRE(scheduler.shards_count() == 3);
+
+    const auto get_thread_id = [&](const auto& worker) {
+        std::promise<std::thread::id> promise{};
+        worker.schedule([&promise](const auto&) {
+            promise.set_value(std::this_thread::get_id());
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                        obs);
+        return promise.get_future().get();
+    };
+
+    SUBCASE("each shard has its own thread")
+    {
+        std::set<std::thread::id> threads{};
+        for (size_t i = 0; i < scheduler.shards_count(); ++i)
+        {
+            const auto thread = get_thread_id(scheduler.create_worker(i));
+            CHECK(thread != std::this_thread::get_id());
+            CHECK(get_thread_id(scheduler.create_worker(i)) == thread);
+            threads.insert(thread);
+        }
+        CHECK(threads.size() == 3);
+    }
+
+    SUBCASE("same key is always processed by the same shard")
+    {
+        for (size_t key = 0; key < 10; ++key)
+        {
+            const auto hash = std::hash<size_t>{}(key);
+            CHECK(scheduler.get_shard_for_key(hash) < scheduler.shards_count());
+            CHECK(get_thread_id(scheduler.create_worker_for_key(hash)) == get_thread_id(scheduler.create_worker(scheduler.get_shard_for_key(hash))));
+        }
+    }
+
+    SUBCASE("invalid shard index throws")
+    {
+        CHECK_THROWS_AS(scheduler.create_worker(3), std::out_of_range);
+    }
+}
+
+TEST_CASE("shard_scheduler passes schedulings between shards in order")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    // small ring to pass part of schedulings via inbox due to overflow
+    const auto scheduler = rpp::schedulers::shard_scheduler{{.shards_count = 2, .ring_capacity = 4}};
+    const auto source    = scheduler.create_worker(0);
+    const auto target    = scheduler.create_worker(1);
+
+    constexpr int                  count = 1000;
+    std::vector<int>               executions{};
+    std::set<std::thread::id>      threads{};
+    std::promise<std::vector<int>> promise{};
+
+    source.schedule([&](const auto&) {
+        for (int i = 0; i < count; ++i)
+        {
+            target.schedule([&, i](const auto&) {
+                executions.push_back(i);
+                threads.insert(std::this_thread::get_id());
+                if (i == count - 1)
+                    promise.set_value(executions);
+                return rpp::schedulers::optional_delay_from_now{};
+            },
+                            obs);
+        }
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                    obs);
+
+    std::vector<int> expected(count);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    REQUIRE(promise.get_future().wait_for(std::chrono::seconds{5}) == std::future_status::ready);
+    CHECK(executions == expected);
+    CHECK(threads.size() == 1);
+}
+
 TEST_CASE("run_loop scheduler dispatches tasks only manually")
 {
     auto scheduler = rpp::schedulers::run_loop{};
@@ -925,146 +1176,1457 @@ TEST_CASE("run_loop scheduler dispatches tasks only manually")
     }
 }
 
-TEST_CASE("different delaying strategies")
+TEST_CASE("run_loop dispatches ready schedulables in batches")
 {
-    rpp::schedulers::test_scheduler scheduler{};
-    auto                            obs     = mock_observer_strategy<int>{}.get_observer().as_dynamic();
-    auto                            advance = std::chrono::seconds{1};
-    auto                            delay   = advance * 2;
-    auto                            now     = scheduler.now();
+    auto scheduler = rpp::schedulers::run_loop{};
+    auto worker    = scheduler.create_worker();
+    auto d         = rpp::composite_disposable_wrapper::make();
+    auto obs       = mock_observer_strategy<int>{}.get_observer(d).as_dynamic();
 
-    auto test = [&](auto res) {
-        scheduler.create_worker().schedule([&, res](const auto&) {
-            scheduler.time_advance(advance);
-            return res;
-        },
-                                           obs);
+    std::vector<int> executions{};
+    const auto       schedule = [&](int value, rpp::schedulers::duration delay = {}) {
+        worker.schedule(delay, [&executions, value](const auto&) -> rpp::schedulers::optional_delay_from_now { executions.push_back(value); return {}; }, obs);
     };
 
-    SUBCASE("return delay_from_now")
+    SUBCASE("dispatch_all_ready dispatches only ready schedulables")
     {
-        test(rpp::schedulers::optional_delay_from_now{delay});
-        CHECK(scheduler.get_schedulings() == std::vector{now, now + advance + delay});
-        CHECK(scheduler.get_executions() == std::vector{now});
+        for (int i = 0; i < 5; ++i)
+            schedule(i);
+        schedule(100, std::chrono::hours{1});
+
+        CHECK(scheduler.dispatch_all_ready() == 5);
+        CHECK(executions == std::vector{0, 1, 2, 3, 4});
+        CHECK(scheduler.is_empty() == false);
+        CHECK(scheduler.is_any_ready_schedulable() == false);
+        CHECK(scheduler.dispatch_all_ready() == 0);
     }
 
-    SUBCASE("return delay_from_this_timepoint")
+    SUBCASE("dispatch_all_ready respects max_items and keeps order of the rest")
     {
-        test(rpp::schedulers::optional_delay_from_this_timepoint{delay});
-        CHECK(scheduler.get_schedulings() == std::vector{now, now + delay});
-        CHECK(scheduler.get_executions() == std::vector{now});
+        for (int i = 0; i < 5; ++i)
+            schedule(i);
+
+        CHECK(scheduler.dispatch_all_ready(2) == 2);
+        CHECK(executions == std::vector{0, 1});
+
+        schedule(5);
+        CHECK(scheduler.dispatch_all_ready() == 4);
+        CHECK(executions == std::vector{0, 1, 2, 3, 4, 5});
     }
 
-    SUBCASE("return delay_to")
+    SUBCASE("dispatch_all_ready leaves re-scheduled and newly scheduled schedulables for next call")
     {
-        test(rpp::schedulers::optional_delay_to{now + delay});
-        CHECK(scheduler.get_schedulings() == std::vector{now, now + delay});
-        CHECK(scheduler.get_executions() == std::vector{now});
-    }
-}
+        worker.schedule([&](const auto&, int& counter) -> rpp::schedulers::optional_delay_from_now {
+            executions.push_back(counter);
+            if (counter == 0)
+                schedule(100);
+            if (++counter < 3)
+                return rpp::schedulers::delay_from_now{};
+            return {};
+        },
+                        obs,
+                        int{});
 
-TEST_CASE("current_thread inside new_thread")
-{
-    auto worker  = std::optional{rpp::schedulers::new_thread{}.create_worker()};
-    auto d       = rpp::composite_disposable_wrapper::make();
-    auto obs     = std::optional{mock_observer_strategy<int>{}.get_observer(d).as_dynamic()};
-    auto started = std::make_shared<std::atomic_bool>();
-    auto done    = std::make_shared<std::atomic_bool>();
+        CHECK(scheduler.dispatch_all_ready() == 1);
+        CHECK(executions == std::vector{0});
 
-    worker->schedule([&](const auto&) {
-        thread_local rpp::utils::finally_action s_th{[done] {
-            done->store(true);
-        }};
-        return rpp::schedulers::optional_delay_from_now{};
-    },
-                     obs.value());
+        CHECK(scheduler.dispatch_all_ready() == 2);
+        CHECK(executions == std::vector{0, 100, 1});
 
-    auto current_thread_invoked = std::make_shared<std::atomic_bool>();
+        CHECK(scheduler.dispatch_all_ready() == 1);
+        CHECK(executions == std::vector{0, 100, 1, 2});
+        CHECK(scheduler.is_empty());
+    }
 
-    worker->schedule([&](const auto& obs) {
-        rpp::schedulers::current_thread{}.create_worker().schedule([current_thread_invoked](const auto&) {
-            current_thread_invoked->store(true);
-            return rpp::schedulers::optional_delay_from_now{};
+    SUBCASE("dispatch_all_ready is not endless for schedulable re-scheduling itself immediately")
+    {
+        worker.schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            executions.push_back(0);
+            return rpp::schedulers::delay_from_now{};
         },
-                                                                   obs);
-
-        if (current_thread_invoked->load())
-            throw std::runtime_error{"current_thread was invoked"};
-
-        started->store(true);
+                        obs);
 
-        return rpp::schedulers::optional_delay_from_now{};
-    },
-                     obs.value());
+        CHECK(scheduler.dispatch_all_ready() == 1);
+        CHECK(scheduler.dispatch_all_ready() == 1);
+        CHECK(executions == std::vector{0, 0});
+        CHECK(scheduler.is_empty() == false);
+    }
 
-    while (!started->load())
+    SUBCASE("dispatch_all_ready skips disposed schedulables")
     {
+        schedule(0);
+        d.dispose();
+        schedule(1);
+
+        CHECK(scheduler.dispatch_all_ready() == 0);
+        CHECK(executions.empty());
+        CHECK(scheduler.is_empty());
     }
 
-    worker.reset();
-    obs.reset();
-    d = rpp::composite_disposable_wrapper::empty();
+    SUBCASE("dispatch_for stops after duration and keeps order of the rest")
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            worker.schedule([&executions, i](const auto&) -> rpp::schedulers::optional_delay_from_now {
+                executions.push_back(i);
+                std::this_thread::sleep_for(std::chrono::milliseconds{10});
+                return {};
+            },
+                            obs);
+        }
 
-    std::this_thread::sleep_for(std::chrono::seconds{1});
+        const auto dispatched = scheduler.dispatch_for(std::chrono::milliseconds{15});
+        CHECK(dispatched >= 1);
+        CHECK(dispatched < 5);
+        CHECK(executions.size() == dispatched);
 
-    REQUIRE(done->load());
-    CHECK(current_thread_invoked->load());
+        CHECK(scheduler.dispatch_all_ready() == 5 - dispatched);
+        CHECK(executions == std::vector{0, 1, 2, 3, 4});
+    }
 }
 
-TEST_CASE("thread_pool uses multiple threads")
+TEST_CASE("prioritized scheduler schedules with provided priority")
 {
-    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+    auto run_loop = rpp::schedulers::run_loop{};
+    auto obs      = mock_observer_strategy<int>{}.get_observer().as_dynamic();
 
-    auto scheduler = rpp::schedulers::thread_pool{3};
+    std::vector<std::string> executions{};
+    const auto               schedule = [&](const auto& worker, std::string value) {
+        worker.schedule([&executions, value](const auto&) -> rpp::schedulers::optional_delay_from_now { executions.push_back(value); return {}; }, obs);
+    };
 
-    const auto get_thread_id = [&scheduler, &obs]() {
-        std::promise<std::thread::id> promise{};
-        scheduler.create_worker().schedule([&promise](const auto&) {
-            promise.set_value(std::this_thread::get_id());
-            return rpp::schedulers::optional_delay_from_now{};
+    const auto low    = rpp::schedulers::prioritized{run_loop, rpp::schedulers::priority::low}.create_worker();
+    const auto normal = run_loop.create_worker();
+    const auto high   = rpp::schedulers::prioritized{run_loop, rpp::schedulers::priority::high}.create_worker();
+
+    SUBCASE("ready schedulables executed in order of priority")
+    {
+        schedule(low, "low");
+        schedule(normal, "normal");
+        schedule(high, "high");
+
+        CHECK(run_loop.dispatch_all_ready() == 3);
+        CHECK(executions == std::vector<std::string>{"high", "normal", "low"});
+    }
+
+    SUBCASE("re-scheduled schedulable keeps its priority")
+    {
+        int count{};
+        high.schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            executions.push_back("high");
+            if (++count < 2)
+                return rpp::schedulers::optional_delay_from_now{rpp::schedulers::duration{}};
+            return {};
         },
-                                           obs);
-        return promise.get_future().get();
-    };
+                      obs);
+        schedule(normal, "normal");
+
+        // one by one: batch extracted by `dispatch_all_ready` already contains "normal" one
+        for (size_t i = 0; i < 3; ++i)
+            run_loop.dispatch_if_ready();
+        CHECK(run_loop.is_empty());
+        CHECK(executions == std::vector<std::string>{"high", "high", "normal"});
+    }
 
-    const auto thread_1_value = get_thread_id();
-    const auto thread_2_value = get_thread_id();
-    const auto thread_3_value = get_thread_id();
-    CHECK(thread_1_value != thread_2_value);
-    CHECK(thread_1_value != thread_3_value);
-    CHECK(thread_2_value != thread_3_value);
+    SUBCASE("priority is not leaked to schedulings outside of prioritized worker")
+    {
+        schedule(high, "high");
+        schedule(normal, "normal");
+        schedule(low, "low");
+        schedule(normal, "normal");
 
-    CHECK(thread_1_value == get_thread_id());
-    CHECK(thread_2_value == get_thread_id());
-    CHECK(thread_3_value == get_thread_id());
+        CHECK(run_loop.dispatch_all_ready() == 4);
+        CHECK(executions == std::vector<std::string>{"high", "normal", "normal", "low"});
+    }
 }
 
-
-TEST_CASE("thread_pool shares same thread")
+#if defined(__linux__)
+TEST_CASE("run_loop wakeup handle becomes readable when schedulable is ready")
 {
-    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+    CHECK(rpp::schedulers::run_loop{}.get_wakeup_handle() == std::nullopt);
 
-    auto scheduler = rpp::schedulers::thread_pool{1};
+    auto scheduler = rpp::schedulers::run_loop{{.enable_wakeup_handle = true}};
+    auto worker    = scheduler.create_worker();
+    auto obs       = mock_observer_strategy<int>{}.get_observer().as_dynamic();
 
-    std::atomic_bool first_job_done{};
+    const auto handle = scheduler.get_wakeup_handle();
+    REQUIRE(handle.has_value());
 
-    scheduler.create_worker().schedule([&first_job_done](const auto&) {
-        while (!first_job_done)
-            std::this_thread::yield();
-        return rpp::schedulers::optional_delay_from_now{};
-    },
-                                       obs);
+    const auto wait_readable = [&](int timeout_ms) {
+        std::array<pollfd, 2> fds{pollfd{handle->event_fd, POLLIN, 0}, pollfd{handle->timer_fd, POLLIN, 0}};
+        return poll(fds.data(), fds.size(), timeout_ms) > 0;
+    };
 
-    std::promise<bool> second_task_executed_promise{};
-    scheduler.create_worker().schedule([&second_task_executed_promise](const auto&) {
-        second_task_executed_promise.set_value(true);
-        return rpp::schedulers::optional_delay_from_now{};
-    },
-                                       obs);
-    auto f = second_task_executed_promise.get_future();
+    size_t     executed_count{};
+    const auto schedule = [&](rpp::schedulers::duration delay) {
+        worker.schedule(delay, [&executed_count](const auto&) -> rpp::schedulers::optional_delay_from_now { ++executed_count; return {}; }, obs);
+    };
 
-    CHECK(f.wait_for(std::chrono::seconds{1}) == std::future_status::timeout);
-    first_job_done.store(true);
+    CHECK(!wait_readable(0));
 
-    CHECK(f.get());
+    SUBCASE("ready schedulable makes handle readable immediately")
+    {
+        schedule({});
+        CHECK(wait_readable(0));
+
+        CHECK(scheduler.dispatch_all_ready() == 1);
+        CHECK(!wait_readable(0));
+    }
+
+    SUBCASE("delayed schedulable makes handle readable at its timepoint")
+    {
+        const auto start = rpp::schedulers::clock_type::now();
+        schedule(std::chrono::milliseconds{50});
+        schedule(std::chrono::milliseconds{20});
+        CHECK(!wait_readable(0));
+
+        CHECK(wait_readable(1000));
+        CHECK(rpp::schedulers::clock_type::now() - start >= std::chrono::milliseconds{20});
+        CHECK(scheduler.dispatch_all_ready() == 1);
+        CHECK(!wait_readable(0));
+
+        CHECK(wait_readable(1000));
+        CHECK(rpp::schedulers::clock_type::now() - start >= std::chrono::milliseconds{50});
+        scheduler.dispatch_if_ready();
+        CHECK(executed_count == 2);
+        CHECK(!wait_readable(0));
+    }
+
+    SUBCASE("schedulable from other thread wakes up waiting loop")
+    {
+        std::thread t{[&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            schedule({});
+        }};
+        CHECK(wait_readable(1000));
+        t.join();
+        CHECK(scheduler.dispatch_all_ready() == 1);
+    }
+}
+
+TEST_CASE("epoll_loop executes schedulables till stop")
+{
+    const auto loop   = rpp::schedulers::epoll_loop{};
+    const auto worker = loop.create_worker();
+    auto       obs    = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    std::vector<int> executions{};
+    const auto       schedule = [&](rpp::schedulers::duration delay, int value, bool stop) {
+        worker.schedule(delay, [&, value, stop](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            executions.push_back(value);
+            if (stop)
+                loop.stop();
+            return {};
+        },
+                        obs);
+    };
+
+    SUBCASE("schedulables are executed in order of timepoints")
+    {
+        const auto start = rpp::schedulers::clock_type::now();
+        schedule(std::chrono::milliseconds{20}, 3, true);
+        schedule(std::chrono::milliseconds{10}, 2, false);
+        schedule({}, 1, false);
+
+        loop.run();
+        CHECK(executions == std::vector{1, 2, 3});
+        CHECK(rpp::schedulers::clock_type::now() - start >= std::chrono::milliseconds{20});
+    }
+
+    SUBCASE("schedulings from thread running loop are executed by the same loop")
+    {
+        worker.schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            schedule(std::chrono::milliseconds{1}, 2, true);
+            schedule({}, 1, false);
+            return {};
+        },
+                        obs);
+
+        loop.run();
+        CHECK(executions == std::vector{1, 2});
+    }
+
+    SUBCASE("schedulable from other thread wakes up sleeping loop")
+    {
+        std::thread t{[&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            schedule({}, 1, true);
+        }};
+        loop.run();
+        t.join();
+        CHECK(executions == std::vector{1});
+    }
+
+    SUBCASE("not executed schedulables are kept for next run")
+    {
+        schedule({}, 1, true);
+        schedule(std::chrono::milliseconds{5}, 2, true);
+
+        loop.run();
+        CHECK(executions == std::vector{1});
+
+        loop.run();
+        CHECK(executions == std::vector{1, 2});
+    }
+
+    SUBCASE("immediately re-scheduled schedulable doesn't starve other ones")
+    {
+        size_t count{};
+        worker.schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            ++count;
+            return rpp::schedulers::optional_delay_from_now{rpp::schedulers::duration{}};
+        },
+                        obs);
+        schedule(std::chrono::milliseconds{1}, 1, true);
+
+        loop.run();
+        CHECK(executions == std::vector{1});
+        CHECK(count > 0);
+    }
+
+    SUBCASE("queue of current_thread owned by thread is restored after run")
+    {
+        rpp::schedulers::current_thread::create_worker().schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            schedule({}, 1, true);
+            loop.run();
+
+            // still queued to outer queue of current_thread
+            rpp::schedulers::current_thread::create_worker().schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+                executions.push_back(3);
+                return {};
+            },
+                                                                      obs);
+            executions.push_back(2);
+            return {};
+        },
+                                                                  obs);
+
+        CHECK(executions == std::vector{1, 2, 3});
+    }
+}
+#endif
+
+TEST_CASE("virtual_time scheduler executes schedulables without real waiting")
+{
+    const auto scheduler  = rpp::schedulers::virtual_time{};
+    const auto worker     = scheduler.create_worker();
+    const auto start      = scheduler.now();
+    const auto real_start = rpp::schedulers::clock_type::now();
+    auto       d          = rpp::composite_disposable_wrapper::make();
+    auto       obs        = mock_observer_strategy<int>{}.get_observer(d).as_dynamic();
+
+    std::vector<rpp::schedulers::duration> executions{};
+    const auto                             schedule = [&](rpp::schedulers::duration delay) {
+        worker.schedule(delay, [&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            executions.push_back(worker.now() - start);
+            return {};
+        },
+                        obs);
+    };
+
+    SUBCASE("schedulables are executed in order of timepoints with virtual now")
+    {
+        schedule(std::chrono::hours{1});
+        schedule(std::chrono::minutes{10});
+        schedule({});
+
+        CHECK(scheduler.advance_by(std::chrono::hours{2}) == 3);
+        CHECK(executions == std::vector<rpp::schedulers::duration>{{}, std::chrono::minutes{10}, std::chrono::hours{1}});
+        CHECK(scheduler.now() - start == std::chrono::hours{2});
+        CHECK(scheduler.is_empty());
+    }
+
+    SUBCASE("advance executes only due schedulables")
+    {
+        schedule(std::chrono::seconds{10});
+        schedule(std::chrono::seconds{20});
+        CHECK(scheduler.get_next_timepoint() == start + std::chrono::seconds{10});
+
+        CHECK(scheduler.advance_by(std::chrono::seconds{15}) == 1);
+        CHECK(scheduler.now() - start == std::chrono::seconds{15});
+
+        CHECK(scheduler.advance_to(start) == 0);
+        CHECK(scheduler.now() - start == std::chrono::seconds{15});
+
+        CHECK(scheduler.advance_by(std::chrono::seconds{5}) == 1);
+        CHECK(executions == std::vector<rpp::schedulers::duration>{std::chrono::seconds{10}, std::chrono::seconds{20}});
+    }
+
+    SUBCASE("periodic schedulable is re-scheduled in virtual time")
+    {
+        size_t count{};
+        worker.schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_this_timepoint {
+            ++count;
+            return rpp::schedulers::optional_delay_from_this_timepoint{std::chrono::seconds{1}};
+        },
+                        obs);
+
+        CHECK(scheduler.advance_by(std::chrono::hours{24}) == 24 * 60 * 60 + 1);
+        CHECK(count == 24 * 60 * 60 + 1);
+        CHECK(scheduler.get_next_timepoint() == start + std::chrono::hours{24} + std::chrono::seconds{1});
+    }
+
+    SUBCASE("run executes recursive schedulings till queue is empty")
+    {
+        worker.schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+            schedule(std::chrono::minutes{1});
+            schedule({});
+            return {};
+        },
+                        obs);
+
+        CHECK(scheduler.run() == 3);
+        CHECK(executions == std::vector<rpp::schedulers::duration>{{}, std::chrono::minutes{1}});
+        CHECK(scheduler.now() - start == std::chrono::minutes{1});
+    }
+
+    SUBCASE("disposed schedulables are skipped")
+    {
+        schedule(std::chrono::minutes{1});
+        d.dispose();
+
+        CHECK(scheduler.run() == 0);
+        CHECK(executions.empty());
+    }
+
+    CHECK(rpp::schedulers::clock_type::now() - real_start < std::chrono::seconds{1});
+}
+
+TEST_CASE("different delaying strategies")
+{
+    rpp::schedulers::test_scheduler scheduler{};
+    auto                            obs     = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+    auto                            advance = std::chrono::seconds{1};
+    auto                            delay   = advance * 2;
+    auto                            now     = scheduler.now();
+
+    auto test = [&](auto res) {
+        scheduler.create_worker().schedule([&, res](const auto&) {
+            scheduler.time_advance(advance);
+            return res;
+        },
+                                           obs);
+    };
+
+    SUBCASE("return delay_from_now")
+    {
+        test(rpp::schedulers::optional_delay_from_now{delay});
+        CHECK(scheduler.get_schedulings() == std::vector{now, now + advance + delay});
+        CHECK(scheduler.get_executions() == std::vector{now});
+    }
+
+    SUBCASE("return delay_from_this_timepoint")
+    {
+        test(rpp::schedulers::optional_delay_from_this_timepoint{delay});
+        CHECK(scheduler.get_schedulings() == std::vector{now, now + delay});
+        CHECK(scheduler.get_executions() == std::vector{now});
+    }
+
+    SUBCASE("return delay_to")
+    {
+        test(rpp::schedulers::optional_delay_to{now + delay});
+        CHECK(scheduler.get_schedulings() == std::vector{now, now + delay});
+        CHECK(scheduler.get_executions() == std::vector{now});
+    }
+}
+
+TEST_CASE("current_thread inside new_thread")
+{
+    auto worker  = std::optional{rpp::schedulers::new_thread{}.create_worker()};
+    auto d       = rpp::composite_disposable_wrapper::make();
+    auto obs     = std::optional{mock_observer_strategy<int>{}.get_observer(d).as_dynamic()};
+    auto started = std::make_shared<std::atomic_bool>();
+    auto done    = std::make_shared<std::atomic_bool>();
+
+    worker->schedule([&](const auto&) {
+        thread_local rpp::utils::finally_action s_th{[done] {
+            done->store(true);
+        }};
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                     obs.value());
+
+    auto current_thread_invoked = std::make_shared<std::atomic_bool>();
+
+    worker->schedule([&](const auto& obs) {
+        rpp::schedulers::current_thread{}.create_worker().schedule([current_thread_invoked](const auto&) {
+            current_thread_invoked->store(true);
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                                                                   obs);
+
+        if (current_thread_invoked->load())
+            throw std::runtime_error{"current_thread was invoked"};
+
+        started->store(true);
+
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                     obs.value());
+
+    while (!started->load())
+    {
+    }
+
+    worker.reset();
+    obs.reset();
+    d = rpp::composite_disposable_wrapper::empty();
+
+    std::this_thread::sleep_for(std::chrono::seconds{1});
+
+    REQUIRE(done->load());
+    CHECK(current_thread_invoked->load());
+}
+
+TEST_CASE_TEMPLATE("new_thread with spinning idle strategy respects time points", TestType, std::integral_constant<rpp::schedulers::idle_strategy, rpp::schedulers::idle_strategy::spin_yield_park>, std::integral_constant<rpp::schedulers::idle_strategy, rpp::schedulers::idle_strategy::busy_spin>)
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    const auto worker = rpp::schedulers::new_thread::with(TestType::value).create_worker();
+
+    std::vector<std::pair<int, rpp::schedulers::time_point>> executions{};
+    std::promise<void>                                       done{};
+
+    const auto start = rpp::schedulers::clock_type::now();
+    for (const int delay_us : {5000, 50, 0, 500})
+    {
+        worker.schedule(std::chrono::microseconds{delay_us}, [&, delay_us](const auto&) {
+            executions.emplace_back(delay_us, rpp::schedulers::clock_type::now());
+            if (executions.size() == 4)
+                done.set_value();
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                        obs);
+    }
+
+    done.get_future().wait();
+    REQUIRE(executions.size() == 4);
+    CHECK(executions[0].first == 0);
+    CHECK(executions[1].first == 50);
+    CHECK(executions[2].first == 500);
+    CHECK(executions[3].first == 5000);
+    for (const auto& [delay_us, executed_at] : executions)
+        CHECK(executed_at - start >= std::chrono::microseconds{delay_us});
+}
+
+TEST_CASE("thread_pool uses multiple threads")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{3};
+
+    const auto get_thread_id = [&scheduler, &obs]() {
+        std::promise<std::thread::id> promise{};
+        scheduler.create_worker().schedule([&promise](const auto&) {
+            promise.set_value(std::this_thread::get_id());
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                                           obs);
+        return promise.get_future().get();
+    };
+
+    const auto thread_1_value = get_thread_id();
+    const auto thread_2_value = get_thread_id();
+    const auto thread_3_value = get_thread_id();
+    CHECK(thread_1_value != thread_2_value);
+    CHECK(thread_1_value != thread_3_value);
+    CHECK(thread_2_value != thread_3_value);
+
+    CHECK(thread_1_value == get_thread_id());
+    CHECK(thread_2_value == get_thread_id());
+    CHECK(thread_3_value == get_thread_id());
+}
+
+
+TEST_CASE("thread_pool shares same thread")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{1};
+
+    std::atomic_bool first_job_done{};
+
+    scheduler.create_worker().schedule([&first_job_done](const auto&) {
+        while (!first_job_done)
+            std::this_thread::yield();
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                                       obs);
+
+    std::promise<bool> second_task_executed_promise{};
+    scheduler.create_worker().schedule([&second_task_executed_promise](const auto&) {
+        second_task_executed_promise.set_value(true);
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                                       obs);
+    auto f = second_task_executed_promise.get_future();
+
+    CHECK(f.wait_for(std::chrono::seconds{1}) == std::future_status::timeout);
+    first_job_done.store(true);
+
+    CHECK(f.get());
+}
+
+TEST_CASE("work-stealing thread_pool preserves order of schedulables for each worker")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    constexpr size_t workers_count = 8;
+    constexpr int    items_count   = 1000;
+
+    auto scheduler = rpp::schedulers::thread_pool{4, rpp::schedulers::thread_pool::mode::work_stealing};
+
+    std::array<std::vector<int>, workers_count> results{};
+    std::atomic_size_t                          done{};
+
+    for (auto& result : results)
+    {
+        scheduler.create_worker().schedule([&result, &done](const auto&, int& counter) -> rpp::schedulers::optional_delay_from_now {
+            result.push_back(counter);
+            if (++counter < items_count)
+                return rpp::schedulers::delay_from_now{};
+            done.fetch_add(1);
+            return std::nullopt;
+        },
+                                           obs,
+                                           int{});
+    }
+
+    auto             worker = scheduler.create_worker();
+    std::vector<int> external{};
+    for (int i = 0; i < items_count; ++i)
+    {
+        worker.schedule([&external, &done, i](const auto&) {
+            external.push_back(i);
+            if (i == items_count - 1)
+                done.fetch_add(1);
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                        obs);
+    }
+
+    while (done.load() != workers_count + 1)
+        std::this_thread::yield();
+
+    std::vector<int> expected(items_count);
+    std::iota(expected.begin(), expected.end(), 0);
+    for (const auto& result : results)
+        CHECK(result == expected);
+    CHECK(external == expected);
+}
+
+TEST_CASE("work-stealing thread_pool steals ready workers from busy thread")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{2, rpp::schedulers::thread_pool::mode::work_stealing};
+
+    auto blocked_worker = scheduler.create_worker();
+    auto other_worker   = scheduler.create_worker();
+
+    std::atomic_bool              first_job_done{};
+    std::promise<std::thread::id> blocked_thread_promise{};
+    std::promise<std::thread::id> second_task_thread_promise{};
+    std::promise<void>            blocked_job_finished{};
+
+    blocked_worker.schedule([&](const auto& obs) {
+        // strand of other worker is placed into deque of current thread, so, it can be executed only if other thread steals it
+        other_worker.schedule([&second_task_thread_promise](const auto&) {
+            second_task_thread_promise.set_value(std::this_thread::get_id());
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                              obs);
+
+        blocked_thread_promise.set_value(std::this_thread::get_id());
+        while (!first_job_done)
+            std::this_thread::yield();
+        blocked_job_finished.set_value();
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                            obs);
+
+    auto f = second_task_thread_promise.get_future();
+    REQUIRE(f.wait_for(std::chrono::seconds{1}) == std::future_status::ready);
+    CHECK(f.get() != blocked_thread_promise.get_future().get());
+
+    first_job_done.store(true);
+    blocked_job_finished.get_future().wait();
+}
+
+TEST_CASE("work-stealing thread_pool respects time points")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{2, rpp::schedulers::thread_pool::mode::work_stealing};
+    auto worker    = scheduler.create_worker();
+
+    std::promise<std::vector<int>> promise{};
+    std::vector<int>               executions{};
+
+    const auto start = rpp::schedulers::clock_type::now();
+    worker.schedule(std::chrono::milliseconds{20}, [&](const auto&) {executions.push_back(2); promise.set_value(executions); return rpp::schedulers::optional_delay_from_now{}; }, obs);
+    worker.schedule(std::chrono::milliseconds{10}, [&](const auto&) {executions.push_back(1); return rpp::schedulers::optional_delay_from_now{}; }, obs);
+
+    CHECK(promise.get_future().get() == std::vector{1, 2});
+    CHECK(rpp::schedulers::clock_type::now() - start >= std::chrono::milliseconds{20});
+}
+
+TEST_CASE("work-stealing thread_pool lets other workers run when execution budget is exhausted")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{rpp::schedulers::thread_pool::options{.threads_count = 1,
+                                                                                        .pool_mode     = rpp::schedulers::thread_pool::mode::work_stealing,
+                                                                                        .budget        = {.max_items = 10}}};
+
+    std::atomic_bool    other_executed{};
+    std::atomic<size_t> executions{};
+    std::promise<void>  started{};
+    std::promise<void>  finished{};
+
+    // re-schedules itself immediately and would occupy the only thread forever without budget (guarded to finish test anyway)
+    scheduler.create_worker().schedule([&](const auto&) -> rpp::schedulers::optional_delay_from_now {
+        if (executions.fetch_add(1) == 0)
+            started.set_value();
+
+        if (other_executed.load() || executions.load() > 10'000'000)
+        {
+            finished.set_value();
+            return {};
+        }
+        return rpp::schedulers::delay_from_now{};
+    },
+                                       obs);
+
+    started.get_future().wait();
+    const auto executions_before = executions.load();
+    scheduler.create_worker().schedule([&](const auto&) {
+        other_executed.store(true);
+        return rpp::schedulers::optional_delay_from_now{};
+    },
+                                       obs);
+
+    finished.get_future().wait();
+    CHECK(other_executed.load());
+    CHECK(executions.load() - executions_before <= 2 * size_t{10} + 1);
+}
+
+TEST_CASE("execution_budget_tracker limits executions in a row")
+{
+    SUBCASE("default budget is unlimited")
+    {
+        rpp::schedulers::details::execution_budget_tracker tracker{rpp::schedulers::execution_budget{}};
+        for (size_t i = 0; i < 1000; ++i)
+            CHECK(tracker.consume());
+        CHECK(!tracker.is_exhausted());
+    }
+
+    SUBCASE("budget limited by amount of items")
+    {
+        rpp::schedulers::details::execution_budget_tracker tracker{rpp::schedulers::execution_budget{.max_items = 3}};
+        CHECK(tracker.consume());
+        CHECK(tracker.consume());
+        CHECK(!tracker.consume());
+        CHECK(tracker.is_exhausted());
+    }
+
+    SUBCASE("budget limited by duration")
+    {
+        rpp::schedulers::details::execution_budget_tracker tracker{rpp::schedulers::execution_budget{.max_duration = std::chrono::milliseconds{10}}};
+        CHECK(tracker.consume());
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        CHECK(!tracker.consume());
+        CHECK(tracker.is_exhausted());
+    }
+}
+
+TEST_CASE_TEMPLATE("thread_pool can be resized without losing schedulables", TestType, std::integral_constant<rpp::schedulers::thread_pool::mode, rpp::schedulers::thread_pool::mode::round_robin>, std::integral_constant<rpp::schedulers::thread_pool::mode, rpp::schedulers::thread_pool::mode::work_stealing>)
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{1, TestType::value};
+    CHECK(scheduler.threads_count() == 1);
+
+    const auto get_thread_id = [&obs](const auto& worker) {
+        std::promise<std::thread::id> promise{};
+        worker.schedule([&promise](const auto&) {
+            promise.set_value(std::this_thread::get_id());
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                        obs);
+        return promise.get_future().get();
+    };
+
+    // both schedulables finish successfully only in case of they are executed by different threads at the same time
+    const auto executed_concurrently = [&obs](const auto& first, const auto& second) {
+        std::atomic_int                   started{};
+        std::array<std::promise<bool>, 2> results{};
+        const auto                        schedule = [&](const auto& worker, std::promise<bool>& result) {
+            worker.schedule([&](const auto&) {
+                ++started;
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+                while (started.load() < 2 && std::chrono::steady_clock::now() < deadline)
+                    std::this_thread::yield();
+                result.set_value(started.load() == 2);
+                return rpp::schedulers::optional_delay_from_now{};
+            },
+                            obs);
+        };
+        schedule(first, results[0]);
+        schedule(second, results[1]);
+        const bool first_result = results[0].get_future().get();
+        return results[1].get_future().get() && first_result;
+    };
+
+    SUBCASE("growing of pool adds new threads")
+    {
+        CHECK(!executed_concurrently(scheduler.create_worker(), scheduler.create_worker()));
+
+        scheduler.resize(2);
+        CHECK(scheduler.threads_count() == 2);
+
+        CHECK(executed_concurrently(scheduler.create_worker(), scheduler.create_worker()));
+    }
+
+    SUBCASE("shrinking of pool keeps schedulables of existing workers")
+    {
+        scheduler.resize(3);
+        std::vector<decltype(scheduler.create_worker())> workers{};
+        for (size_t i = 0; i < 3; ++i)
+            workers.push_back(scheduler.create_worker());
+
+        std::atomic_int    executed{};
+        std::promise<void> all_executed{};
+        constexpr int      per_worker = 100;
+        const auto         total      = static_cast<int>(workers.size()) * per_worker;
+        for (const auto& worker : workers)
+        {
+            for (int i = 0; i < per_worker; ++i)
+            {
+                worker.schedule(std::chrono::milliseconds{10}, [&](const auto&) {
+                    if (++executed == total)
+                        all_executed.set_value();
+                    return rpp::schedulers::optional_delay_from_now{};
+                },
+                                obs);
+            }
+        }
+
+        scheduler.resize(1);
+        CHECK(scheduler.threads_count() == 1);
+        workers.clear();
+
+        REQUIRE(all_executed.get_future().wait_for(std::chrono::seconds{5}) == std::future_status::ready);
+        CHECK(executed.load() == total);
+
+        CHECK(get_thread_id(scheduler.create_worker()) == get_thread_id(scheduler.create_worker()));
+    }
+}
+
+TEST_CASE("work-stealing thread_pool is resized in place")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    auto scheduler = rpp::schedulers::thread_pool{3, rpp::schedulers::thread_pool::mode::work_stealing};
+
+    const auto get_thread_id = [&obs](const auto& worker) {
+        std::promise<std::thread::id> promise{};
+        worker.schedule([&promise](const auto&) {
+            promise.set_value(std::this_thread::get_id());
+            return rpp::schedulers::optional_delay_from_now{};
+        },
+                        obs);
+        return promise.get_future().get();
+    };
+
+    // both schedulables finish successfully only in case of they are executed by different threads at the same time
+    const auto executed_concurrently = [&obs](const auto& first, const auto& second) {
+        std::atomic_int                   started{};
+        std::array<std::promise<bool>, 2> results{};
+        const auto                        schedule = [&](const auto& worker, std::promise<bool>& result) {
+            worker.schedule([&](const auto&) {
+                ++started;
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+                while (started.load() < 2 && std::chrono::steady_clock::now() < deadline)
+                    std::this_thread::yield();
+                result.set_value(started.load() == 2);
+                return rpp::schedulers::optional_delay_from_now{};
+            },
+                            obs);
+        };
+        schedule(first, results[0]);
+        schedule(second, results[1]);
+        const bool first_result = results[0].get_future().get();
+        return results[1].get_future().get() && first_result;
+    };
+
+    std::vector<decltype(scheduler.create_worker())> workers{};
+    for (size_t i = 0; i < 3; ++i)
+        workers.push_back(scheduler.create_worker());
+
+    scheduler.resize(1);
+
+    // already created workers are executed by remaining thread instead of threads of old pool
+    const auto thread = get_thread_id(scheduler.create_worker());
+    for (const auto& worker : workers)
+        CHECK(get_thread_id(worker) == thread);
+
+    scheduler.resize(2);
+    CHECK(scheduler.threads_count() == 2);
+    CHECK(executed_concurrently(workers[0], workers[1]));
+}
+
+TEST_CASE("thread_pool applies thread settings")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    SUBCASE("invalid settings are reported as exception")
+    {
+        auto options = rpp::schedulers::thread_pool::options{.threads_count = 2, .fifo_priority = 1000};
+        CHECK_THROWS_AS(rpp::schedulers::thread_pool{options}, std::system_error);
+
+        options.pool_mode = rpp::schedulers::thread_pool::mode::work_stealing;
+        CHECK_THROWS_AS(rpp::schedulers::thread_pool{options}, std::system_error);
+    }
+
+#if defined(__linux__)
+    SUBCASE("threads are pinned to cpus")
+    {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        REQUIRE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+        int first_allowed_cpu = 0;
+        while (!CPU_ISSET(first_allowed_cpu, &allowed))
+            ++first_allowed_cpu;
+
+        auto scheduler = rpp::schedulers::thread_pool{{.threads_count = 2, .cpu_affinity = {{static_cast<size_t>(first_allowed_cpu)}}}};
+
+        for (size_t i = 0; i < 2; ++i)
+        {
+            std::promise<std::vector<int>> promise{};
+            scheduler.create_worker().schedule([&promise](const auto&) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+
+                std::vector<int> cpus{};
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                        cpus.push_back(cpu);
+                }
+                promise.set_value(cpus);
+                return rpp::schedulers::optional_delay_from_now{};
+            },
+                                               obs);
+            CHECK(promise.get_future().get() == std::vector{first_allowed_cpu});
+        }
+    }
+#endif
+
+#if defined(__linux__)
+    SUBCASE("cgroup quota is looked up from cgroup of process till root of hierarchy")
+    {
+        std::vector<std::string> paths{};
+        rpp::schedulers::details::for_each_cgroup_ancestor("/system.slice/app.service/", [&](const std::string& path) { paths.push_back(path); });
+        CHECK(paths == std::vector<std::string>{"/system.slice/app.service", "/system.slice", ""});
+
+        paths.clear();
+        rpp::schedulers::details::for_each_cgroup_ancestor("/", [&](const std::string& path) { paths.push_back(path); });
+        CHECK(paths == std::vector<std::string>{""});
+    }
+#endif
+
+    SUBCASE("default size respects available cpus")
+    {
+        const auto available = rpp::schedulers::details::get_available_concurrency();
+        CHECK(available >= 1);
+        CHECK(available <= std::max(1u, std::thread::hardware_concurrency()));
+        CHECK(rpp::schedulers::thread_pool{}.threads_count() == available);
+    }
+}
+
+TEST_CASE_TEMPLATE("clock sources are monotonic and follow steady_clock", TestType, rpp::schedulers::details::steady_clock_source, rpp::schedulers::details::coarse_clock_source, rpp::schedulers::details::tsc_clock_source)
+{
+    // coarse clock lags behind up to one kernel tick
+    constexpr auto tolerance = std::chrono::milliseconds{20};
+
+    auto last = TestType::now();
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+        const auto before = rpp::schedulers::clock_type::now();
+        const auto now    = TestType::now();
+        const auto after  = rpp::schedulers::clock_type::now();
+
+        REQUIRE(now >= last);
+        REQUIRE(now >= before - tolerance);
+        REQUIRE(now <= after + tolerance);
+        last = now;
+
+        if (i % 1000 == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds{500});
+    }
+}
+
+TEST_CASE("coarse clock source is never later than actual time")
+{
+    // otherwise schedulables would be treated as ready before their timepoints
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+        const auto now   = rpp::schedulers::details::coarse_clock_source::now();
+        const auto after = rpp::schedulers::clock_type::now();
+        REQUIRE(now <= after);
+    }
+}
+
+TEST_CASE("details::now is never earlier than previously returned value")
+{
+    auto last = rpp::schedulers::details::now();
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const rpp::schedulers::details::now_cache::scope scope{};
+        rpp::schedulers::details::now_cache::tick();
+
+        const auto now = rpp::schedulers::details::now();
+        REQUIRE(now >= last);
+        last = now;
+    }
+}
+
+TEST_CASE("details::now is not stale after long-running schedulable")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    std::promise<rpp::schedulers::duration> drift{};
+
+    auto worker = rpp::schedulers::new_thread::create_worker();
+    worker.schedule([](const auto&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        return rpp::schedulers::optional_delay_from_now{}; }, obs);
+    worker.schedule([&drift](const auto&) {
+        const auto now = rpp::schedulers::details::now();
+        drift.set_value(rpp::schedulers::clock_type::now() - now);
+        return rpp::schedulers::optional_delay_from_now{}; }, obs);
+
+    // cached "now" (if enabled) is bounded by time, not by amount of schedulables
+    CHECK(drift.get_future().get() < std::chrono::milliseconds{20});
+}
+
+TEST_CASE("schedulers report metrics")
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    // the most recently created worker of scheduler
+    const auto get_snapshot = [](std::string_view scheduler) -> std::optional<rpp::schedulers::metrics::worker_snapshot> {
+        std::optional<rpp::schedulers::metrics::worker_snapshot> result{};
+        for (auto& snapshot : rpp::schedulers::metrics::collect())
+        {
+            if (snapshot.scheduler == scheduler && (!result || result->id < snapshot.id))
+                result = std::move(snapshot);
+        }
+        return result;
+    };
+
+    SUBCASE("run_loop reports queue depth, lag and runtime")
+    {
+        auto scheduler = rpp::schedulers::run_loop{};
+        auto worker    = scheduler.create_worker();
+        for (size_t i = 0; i < 3; ++i)
+        {
+            worker.schedule([](const auto&) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                return rpp::schedulers::optional_delay_from_now{}; }, obs);
+        }
+        worker.schedule(std::chrono::hours{1}, [](const auto&) { return rpp::schedulers::optional_delay_from_now{}; }, obs);
+
+        if constexpr (!rpp::schedulers::metrics::enabled)
+        {
+            CHECK(rpp::schedulers::metrics::collect().empty());
+            return;
+        }
+
+        auto snapshot = get_snapshot("run_loop");
+        REQUIRE(snapshot);
+        CHECK(snapshot->queue_depth == 4);
+        CHECK(snapshot->executed == 0);
+
+        CHECK(scheduler.dispatch_all_ready() == 3);
+
+        snapshot = get_snapshot("run_loop");
+        REQUIRE(snapshot);
+        CHECK(snapshot->queue_depth == 1);
+        CHECK(snapshot->executed == 3);
+        CHECK(snapshot->lag.count == 3);
+        CHECK(snapshot->runtime.count == 3);
+        CHECK(snapshot->runtime.max >= std::chrono::milliseconds{1});
+        CHECK(snapshot->runtime.percentile(0.5) >= std::chrono::milliseconds{1});
+        CHECK(snapshot->runtime.sum >= std::chrono::milliseconds{3});
+    }
+
+    SUBCASE("new_thread reports lag of delayed schedulable")
+    {
+        auto                           worker = rpp::schedulers::new_thread::create_worker();
+        std::promise<void>             executed{};
+        const std::chrono::nanoseconds delay = std::chrono::milliseconds{10};
+        worker.schedule(delay, [&executed](const auto&) { executed.set_value(); return rpp::schedulers::optional_delay_from_now{}; }, obs);
+        executed.get_future().wait();
+
+        if constexpr (!rpp::schedulers::metrics::enabled)
+        {
+            CHECK(rpp::schedulers::metrics::collect().empty());
+            return;
+        }
+
+        // execution is recorded right after schedulable returns
+        auto snapshot = get_snapshot("new_thread");
+        for (size_t i = 0; i < 1000 && (!snapshot || snapshot->executed == 0); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            snapshot = get_snapshot("new_thread");
+        }
+
+        REQUIRE(snapshot);
+        CHECK(snapshot->executed == 1);
+        CHECK(snapshot->queue_depth == 0);
+        CHECK(snapshot->lag.count == 1);
+        CHECK(snapshot->lag.max < delay + std::chrono::seconds{1});
+    }
+
+    SUBCASE("each thread of thread_pool reports its own metrics")
+    {
+        size_t last_id{};
+        for (const auto& snapshot : rpp::schedulers::metrics::collect())
+            last_id = std::max(last_id, snapshot.id + 1);
+
+        // executions of thread_pool's threads reported after `last_id`, both schedulables wait for each other to be executed by different threads
+        const auto get_executions = [&](rpp::schedulers::thread_pool::mode mode) {
+            auto scheduler = rpp::schedulers::thread_pool{2, mode};
+
+            std::atomic_int                   started{};
+            std::array<std::promise<void>, 2> executed{};
+            for (auto& promise : executed)
+            {
+                scheduler.create_worker().schedule([&started, &promise](const auto&) {
+                    ++started;
+                    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+                    while (started.load() < 2 && std::chrono::steady_clock::now() < deadline)
+                        std::this_thread::yield();
+                    promise.set_value();
+                    return rpp::schedulers::optional_delay_from_now{};
+                },
+                                                   obs);
+            }
+            for (auto& promise : executed)
+                promise.get_future().wait();
+
+            std::map<std::string, std::vector<uint64_t>> result{};
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                result.clear();
+                uint64_t total{};
+                for (const auto& snapshot : rpp::schedulers::metrics::collect())
+                {
+                    if (snapshot.id < last_id)
+                        continue;
+                    result[snapshot.scheduler].push_back(snapshot.executed);
+                    total += snapshot.executed;
+                }
+                // execution is recorded right after schedulable returns
+                if (total == executed.size())
+                    break;
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+            return result;
+        };
+
+        const auto round_robin = get_executions(rpp::schedulers::thread_pool::mode::round_robin);
+        if constexpr (!rpp::schedulers::metrics::enabled)
+        {
+            CHECK(round_robin.empty());
+            return;
+        }
+        CHECK(round_robin == std::map<std::string, std::vector<uint64_t>>{{"thread_pool", {1, 1}}});
+
+        for (const auto& snapshot : rpp::schedulers::metrics::collect())
+            last_id = std::max(last_id, snapshot.id + 1);
+
+        const auto work_stealing = get_executions(rpp::schedulers::thread_pool::mode::work_stealing);
+        CHECK(work_stealing == std::map<std::string, std::vector<uint64_t>>{{"thread_pool", {1, 1}}});
+    }
+}
+
+namespace
+{
+    struct blocking_fn
+    {
+        rpp::schedulers::optional_delay_from_now operator()(const auto&) const
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{100});
+            return {};
+        }
+    };
+} // namespace
+
+TEST_CASE("watchdog reports stalled schedulables")
+{
+    CHECK(rpp::schedulers::details::type_name<int>() == "int");
+
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    std::mutex                                    mutex{};
+    std::vector<rpp::schedulers::watchdog::stall> stalls{};
+    std::optional<rpp::schedulers::watchdog>      watchdog{};
+    watchdog.emplace(rpp::schedulers::watchdog::options{.threshold    = std::chrono::milliseconds{20},
+                                                        .check_period = std::chrono::milliseconds{2},
+                                                        .on_stall     = [&](const rpp::schedulers::watchdog::stall& stall) {
+                                                            std::lock_guard lock{mutex};
+                                                            stalls.push_back(stall);
+                                                        }});
+
+    std::promise<std::thread::id> executed{};
+
+    auto worker = rpp::schedulers::new_thread::create_worker();
+    worker.schedule([](const auto&) { return rpp::schedulers::optional_delay_from_now{}; }, obs);
+    worker.schedule(blocking_fn{}, obs);
+    worker.schedule([&executed](const auto&) { executed.set_value(std::this_thread::get_id()); return rpp::schedulers::optional_delay_from_now{}; }, obs);
+
+    const auto thread = executed.get_future().get();
+    watchdog.reset();
+
+    if constexpr (!rpp::schedulers::watchdog::enabled)
+    {
+        CHECK(stalls.empty());
+        return;
+    }
+
+    REQUIRE(stalls.size() == 1);
+    CHECK(stalls[0].scheduler == "new_thread");
+    CHECK(stalls[0].thread == thread);
+    CHECK(stalls[0].schedulable.find("blocking_fn") != std::string_view::npos);
+    CHECK(stalls[0].elapsed >= std::chrono::milliseconds{20});
+    // elapsed is measured by sampling of watchdog each `check_period`: it is not precise, so, only sanity upper bound is checked
+    CHECK(stalls[0].elapsed < std::chrono::seconds{1});
+}
+
+TEST_CASE_TEMPLATE("schedulables_queue keeps order of schedulables", TestType, rpp::schedulers::details::schedulables_heap_storage, rpp::schedulers::details::schedulables_timer_wheel_storage)
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    rpp::schedulers::details::schedulables_queue<rpp::schedulers::current_thread::worker_strategy, TestType> queue{};
+    std::vector<int>                                                                                          executions{};
+
+    const auto now  = rpp::schedulers::clock_type::now();
+    const auto push = [&](rpp::schedulers::duration delay, int value) {
+        queue.emplace(now + delay, [&executions, value](const auto&) { executions.push_back(value); return rpp::schedulers::optional_delay_from_now{}; }, obs);
+    };
+    const auto drain = [&] {
+        while (!queue.is_empty())
+        {
+            const auto top = queue.pop();
+            CHECK(top->get_timepoint() >= now);
+            (*top)();
+        }
+    };
+
+    SUBCASE("schedulables with same timepoint executed in FIFO order")
+    {
+        for (int i = 0; i < 100; ++i)
+            push(std::chrono::seconds{1}, i);
+
+        drain();
+
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK(executions == expected);
+    }
+
+    SUBCASE("schedulables executed in order of timepoints")
+    {
+        push(std::chrono::hours{1}, 5);
+        push(std::chrono::milliseconds{10}, 3);
+        push(std::chrono::nanoseconds{0}, 0);
+        push(std::chrono::microseconds{5}, 1);
+        push(std::chrono::milliseconds{10}, 4);
+        push(std::chrono::microseconds{5}, 2);
+        push(std::chrono::hours{24 * 365}, 6);
+
+        drain();
+
+        CHECK(executions == std::vector{0, 1, 2, 3, 4, 5, 6});
+    }
+
+    SUBCASE("schedulables pushed during draining are ordered with pending ones")
+    {
+        push(std::chrono::milliseconds{10}, 1);
+        push(std::chrono::seconds{10}, 4);
+
+        CHECK(queue.top()->get_timepoint() == now + std::chrono::milliseconds{10});
+        (*queue.pop())();
+
+        push(std::chrono::seconds{1}, 2);
+        push(std::chrono::seconds{1}, 3);
+        push(std::chrono::seconds{10}, 5);
+
+        drain();
+
+        CHECK(executions == std::vector{1, 2, 3, 4, 5});
+    }
+
+    SUBCASE("restored schedulables keep their original position")
+    {
+        for (int i = 0; i < 4; ++i)
+            push(std::chrono::seconds{1}, i);
+
+        auto first  = queue.pop_queued();
+        auto second = queue.pop_queued();
+        push(std::chrono::seconds{1}, 4);
+        push(std::chrono::milliseconds{1}, -1);
+
+        queue.restore(std::move(second));
+        queue.restore(std::move(first));
+
+        drain();
+
+        CHECK(executions == std::vector{-1, 0, 1, 2, 3, 4});
+    }
+
+    SUBCASE("a lot of random schedulables are ordered by timepoint and then by insertion")
+    {
+        std::vector<std::pair<rpp::schedulers::duration, int>> expected{};
+        uint64_t                                               seed = 42;
+        for (int i = 0; i < 10000; ++i)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            const auto delay = std::chrono::microseconds{static_cast<int64_t>((seed >> 33) % 100000)};
+            expected.emplace_back(delay, i);
+            push(delay, i);
+        }
+
+        drain();
+
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& l, const auto& r) { return l.first < r.first; });
+        std::vector<int> expected_values{};
+        for (const auto& [_, v] : expected)
+            expected_values.push_back(v);
+
+        CHECK(executions == expected_values);
+    }
+}
+
+TEST_CASE_TEMPLATE("schedulables_queue selects ready schedulables by priority", TestType, rpp::schedulers::details::schedulables_heap_storage, rpp::schedulers::details::schedulables_timer_wheel_storage)
+{
+    auto obs = mock_observer_strategy<int>{}.get_observer().as_dynamic();
+
+    rpp::schedulers::details::schedulables_queue<rpp::schedulers::current_thread::worker_strategy, TestType> queue{};
+    std::vector<int>                                                                                          executions{};
+
+    const auto now  = rpp::schedulers::clock_type::now();
+    const auto push = [&](rpp::schedulers::priority priority, rpp::schedulers::duration delay, int value) {
+        const rpp::schedulers::details::scheduling_priority_scope scope{priority};
+        queue.emplace(now + delay, [&executions, value](const auto&) { executions.push_back(value); return rpp::schedulers::optional_delay_from_now{}; }, obs);
+    };
+    const auto drain = [&] {
+        while (!queue.is_empty())
+            (*queue.pop())();
+    };
+
+    SUBCASE("strict policy executes ready schedulables of higher priority first")
+    {
+        push(rpp::schedulers::priority::low, {}, 5);
+        push(rpp::schedulers::priority::normal, {}, 3);
+        push(rpp::schedulers::priority::high, {}, 1);
+        push(rpp::schedulers::priority::low, {}, 6);
+        push(rpp::schedulers::priority::high, {}, 2);
+        push(rpp::schedulers::priority::normal, {}, 4);
+
+        drain();
+
+        CHECK(executions == std::vector{1, 2, 3, 4, 5, 6});
+    }
+
+    SUBCASE("priority doesn't make schedulable ready earlier than its timepoint")
+    {
+        push(rpp::schedulers::priority::high, std::chrono::hours{1}, 3);
+        push(rpp::schedulers::priority::low, {}, 1);
+        push(rpp::schedulers::priority::normal, std::chrono::hours{2}, 4);
+        push(rpp::schedulers::priority::normal, {}, 0);
+        push(rpp::schedulers::priority::low, std::chrono::minutes{1}, 2);
+
+        CHECK(queue.top()->get_timepoint() == now);
+        drain();
+
+        CHECK(executions == std::vector{0, 1, 2, 3, 4});
+    }
+
+    SUBCASE("weighted policy shares executions between ready priorities")
+    {
+        queue.set_priority_policy(rpp::schedulers::priority_policy::weighted);
+        for (int i = 0; i < 70; ++i)
+        {
+            push(rpp::schedulers::priority::high, {}, 0);
+            push(rpp::schedulers::priority::normal, {}, 1);
+            push(rpp::schedulers::priority::low, {}, 2);
+        }
+
+        for (int i = 0; i < 70; ++i)
+            (*queue.pop())();
+
+        CHECK(std::ranges::count(executions, 0) == 40);
+        CHECK(std::ranges::count(executions, 1) == 20);
+        CHECK(std::ranges::count(executions, 2) == 10);
+
+        drain();
+        CHECK(executions.size() == 210);
+    }
+
+    SUBCASE("restored schedulable returns to its priority")
+    {
+        push(rpp::schedulers::priority::low, {}, 1);
+        push(rpp::schedulers::priority::high, {}, 0);
+
+        auto first = queue.pop_queued();
+        CHECK(first.schedulable->get_priority() == rpp::schedulers::priority::high);
+        queue.restore(std::move(first));
+
+        drain();
+
+        CHECK(executions == std::vector{0, 1});
+    }
+}
+
+TEST_CASE("pool_allocator reuses memory blocks")
+{
+    rpp::schedulers::details::pool_allocator<std::array<char, 40>> allocator{};
+
+    SUBCASE("deallocated block reused for next allocation of same size class")
+    {
+        auto* first = allocator.allocate(1);
+        allocator.deallocate(first, 1);
+
+        auto* second = allocator.allocate(1);
+        CHECK(first == second);
+
+        rpp::schedulers::details::pool_allocator<std::array<char, 100>> other_allocator{};
+        auto*                                                             third = other_allocator.allocate(1);
+        CHECK(static_cast<void*>(third) != static_cast<void*>(second));
+
+        other_allocator.deallocate(third, 1);
+        allocator.deallocate(second, 1);
+    }
+
+    SUBCASE("block can be deallocated from another thread")
+    {
+        auto* block = allocator.allocate(1);
+        std::thread{[&] {
+            allocator.deallocate(block, 1);
+            CHECK(allocator.allocate(1) == block);
+            allocator.deallocate(block, 1);
+        }}.join();
+    }
+
+    SUBCASE("big allocations forwarded to global heap")
+    {
+        auto* block = allocator.allocate(1024);
+        allocator.deallocate(block, 1024);
+    }
 }